@@ -2,17 +2,38 @@
 #ifndef _TINYSTL_ALGORITHM_H_
 #define _TINYSTL_ALGORITHM_H_
 
-#include <random>
+#include <cmath>       // std::log, std::log1p, std::exp, std::floor, std::sqrt
+#include <cstdint>     // uint32_t, uint64_t
+#include <cstring>     // memcpy, memmove, memset
+#include <new>         // placement new
+#include <type_traits> // std::is_arithmetic_v, std::make_unsigned_t
 
+#include "allocator.h"
 #include "functional.h"
 #include "heap.h"
 #include "iterator.h"
+#include "random.h"
+#include "tempbuf.h"
 #include "utility.h"
+#include "xsimd.h"
 
 namespace TinySTL
 {
 	enum { SORT_THRESHOLD = 16 };
 	enum { STABLE_SORT_THRESHOLD = 15 };
+	enum { RADIX_SORT_THRESHOLD = 256 };
+	enum { PDQSORT_INSERTION_THRESHOLD = 24 };
+	enum { PDQSORT_NINTHER_THRESHOLD = 128 };
+	enum { PDQSORT_PARTIAL_INSERTION_LIMIT = 8 };
+	enum { PDQSORT_BLOCK_SIZE = 64 };
+	enum { TIMSORT_MIN_MERGE = 32 };
+	enum { TIMSORT_MIN_GALLOP = 7 };
+	enum { TIMSORT_MAX_RUNS = 85 };
+	enum { SET_GALLOP_RATIO = 16 };
+	enum { SELECT_INSERTION_THRESHOLD = 24 };
+	enum { SELECT_FLOYD_RIVEST_THRESHOLD = 600 };
+	enum { SELECT_WORK_FACTOR = 6 };
+	enum { PARTIAL_SORT_SELECT_RATIO = 2048 };
 
 	template <class InputIter, class UnaryPredicate>
 	bool all_of(InputIter first, InputIter last, UnaryPredicate pred)
@@ -73,13 +94,37 @@ namespace TinySTL
 	Function for_each(InputIter first, InputIter last, Function func)
 	{
 		for (; first != last; ++first)
-			func(first);
-		return move(func);
+			func(*first);
+		return TinySTL::move(func);
 	}
 
+	/* pred is plain ==, which the vectorized kernels (xsimd.h) know how to do on T */
+	template <class BinaryPredicate, class T>
+	constexpr bool _is_default_equal =
+		std::is_same_v<BinaryPredicate, equal_to<> > ||
+		std::is_same_v<BinaryPredicate, equal_to<std::remove_cv_t<T> > >;
+
+	/* comp is plain <, for the kernels of xsimd.h */
+	template <class Compare, class T>
+	constexpr bool _is_default_less =
+		std::is_same_v<Compare, less<> > ||
+		std::is_same_v<Compare, less<std::remove_cv_t<T> > >;
+
+	/* contiguous ranges of builtin arithmetic types are searched with SIMD kernels */
 	template <class InputIter, class T>
 	InputIter find(InputIter first, InputIter last, const T& val)
 	{
+		using U = typename iterator_traits<InputIter>::value_type;
+		if constexpr (_simd_searchable<InputIter, T>)
+		{
+			if (_simd_worth(first, last))
+			{
+				const U key = U(val);
+				if (!(key == val))return last;
+				return _simd_result<InputIter>(
+					_simd_find(first, last, &key, _simd_kind_of<U>));
+			}
+		}
 		for (; first != last; ++first)
 		{
 			if (*first == val)return first;
@@ -193,10 +238,18 @@ namespace TinySTL
 	template <class ForwardIter, class BinaryPredicate>
 	ForwardIter adjacent_find(ForwardIter first, ForwardIter last, BinaryPredicate pred)
 	{
+		using T = typename iterator_traits<ForwardIter>::value_type;
+		if constexpr (_simd_pointer<ForwardIter> && _is_default_equal<BinaryPredicate, T>)
+		{
+			if (_simd_worth(first, last))
+				return _simd_result<ForwardIter>(
+					_simd_adjacent_find(first, last, _simd_kind_of<T>));
+		}
+		if (first == last)return last;
 		ForwardIter it = first++;
 		while (first != last)
 		{
-			if (pred(*first, *it))return it;
+			if (pred(*it, *first))return it;
 			it = first++;
 		}
 		return last;
@@ -206,7 +259,18 @@ namespace TinySTL
 	typename iterator_traits<InputIter>::difference_type
 	count(InputIter first, InputIter last, const T& val)
 	{
-		typename iterator_traits<InputIter>::difference_type ret = 0;
+		using Distance = typename iterator_traits<InputIter>::difference_type;
+		using U        = typename iterator_traits<InputIter>::value_type;
+		if constexpr (_simd_searchable<InputIter, T>)
+		{
+			if (_simd_worth(first, last))
+			{
+				const U key = U(val);
+				if (!(key == val))return 0;
+				return Distance(_simd_count(first, last, &key, _simd_kind_of<U>));
+			}
+		}
+		Distance ret = 0;
 		while (first != last)
 		{
 			if (*first == val)++ret;
@@ -240,6 +304,17 @@ namespace TinySTL
 	mismatch(InputIter1 first1, InputIter1 last1,
 			 InputIter2 first2, BinaryPredicate pred)
 	{
+		using T = typename iterator_traits<InputIter1>::value_type;
+		if constexpr (_simd_pointer<InputIter1> && _simd_pointer_to<InputIter2, T> &&
+					  _is_default_equal<BinaryPredicate, T>)
+		{
+			if (_simd_worth(first1, last1))
+			{
+				InputIter1 stop = _simd_result<InputIter1>(
+					_simd_mismatch(first1, last1, first2, _simd_kind_of<T>));
+				return make_pair(stop, first2 + (stop - first1));
+			}
+		}
 		while (first1 != last1 && pred(*first1, *first2))
 		{
 			++first1;
@@ -259,6 +334,13 @@ namespace TinySTL
 	bool equal(InputIter1 first1, InputIter1 last1,
 			   InputIter2 first2, BinaryPredicate pred)
 	{
+		using T = typename iterator_traits<InputIter1>::value_type;
+		if constexpr (_simd_pointer<InputIter1> && _simd_pointer_to<InputIter2, T> &&
+					  _is_default_equal<BinaryPredicate, T>)
+		{
+			if (_simd_worth(first1, last1))
+				return _simd_mismatch(first1, last1, first2, _simd_kind_of<T>) == last1;
+		}
 		while (first1 != last1)
 		{
 			if (!pred(*first1, *first2))return false;
@@ -295,6 +377,15 @@ namespace TinySTL
 		return true;
 	}
 
+	/* both byte pointers of the same type : substrings for _simd_search_bytes */
+	template <class Iter1, class Iter2>
+	constexpr bool _simd_byte_search =
+		_simd_pointer<Iter1> && _simd_pointer<Iter2> &&
+		std::is_integral_v<std::remove_pointer_t<Iter1> > &&
+		sizeof(std::remove_pointer_t<Iter1>) == 1 &&
+		std::is_same_v<std::remove_cv_t<std::remove_pointer_t<Iter1> >,
+					   std::remove_cv_t<std::remove_pointer_t<Iter2> > >;
+
 	template <class ForwardIter1, class ForwardIter2>
 	ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1,
 						ForwardIter2 first2, ForwardIter2 last2)
@@ -302,25 +393,41 @@ namespace TinySTL
 		return search(first1, last1, first2, last2, equal_to<>());
 	}
 
+	/*
+		naive, O(n * m) at worst : see searcher.h for Boyer-Moore(-Horspool).
+		byte pointers under == go to a SIMD filter on the first and last
+		bytes of the pattern instead.
+	*/
 	template <class ForwardIter1, class ForwardIter2, class BinaryPredicate>
 	ForwardIter1 search(ForwardIter1 first1, ForwardIter1 last1,
 						ForwardIter2 first2, ForwardIter2 last2,
 						BinaryPredicate pred)
 	{
-		if (first2 == last2)return last1;
-		while (first1 != last1)
+		if (first2 == last2)return first1;
+		if constexpr (_simd_byte_search<ForwardIter1, ForwardIter2> &&
+					  _is_default_equal<BinaryPredicate, std::remove_pointer_t<ForwardIter1> >)
+		{
+			const size_t m = size_t(last2 - first2);
+			if (m >= 2 && _simd_worth(first1, last1))
+				return _simd_result<ForwardIter1>(_simd_search_bytes(first1, last1, first2, m));
+		}
+		for (;; ++first1)
 		{
 			ForwardIter1 it1 = first1;
-			ForwardIter2 it2 = first2;
-			while (pred(*it1, *it2))
+			for (ForwardIter2 it2 = first2; ; ++it1, ++it2)
 			{
-				++it1;
-				++it2;
 				if (it2 == last2)return first1;
 				if (it1 == last1)return last1;
+				if (!pred(*it1, *it2))break;
 			}
 		}
-		return last1;
+	}
+
+	/* searcher(first, last) : a pair (match, end of match) as the searchers of searcher.h */
+	template <class ForwardIter, class Searcher>
+	ForwardIter search(ForwardIter first, ForwardIter last, const Searcher& searcher)
+	{
+		return searcher(first, last).first;
 	}
 
 	template <class ForwardIter, class Size, class T>
@@ -362,9 +469,40 @@ namespace TinySTL
 		return last;
 	}
 
+	/*
+		[first, last) -> result is a single memmove : contiguous, same element
+		type, and the assignment (copy or Move) is trivial
+	*/
+	template <bool Move, class InputIter, class OutputIter>
+	constexpr bool _memmove_able = false;
+
+	template <bool Move, class T, class U>
+	constexpr bool _memmove_able<Move, T*, U*> =
+		std::is_same_v<std::remove_const_t<T>, U> && !std::is_volatile_v<U> &&
+		std::is_trivially_copyable_v<U> &&
+		std::is_trivially_assignable_v<U&, std::conditional_t<Move, U&&, const U&> >;
+
+	template <class T, class U>
+	U* _trivial_copy(T* first, T* last, U* result)
+	{
+		const size_t n = size_t(last - first);
+		if (n != 0)memmove(result, first, n * sizeof(U));
+		return result + n;
+	}
+
+	template <class T, class U>
+	U* _trivial_copy_backward(T* first, T* last, U* result)
+	{
+		const size_t n = size_t(last - first);
+		if (n != 0)memmove(result - n, first, n * sizeof(U));
+		return result - n;
+	}
+
 	template <class InputIter, class OutputIter>
 	OutputIter copy(InputIter first, InputIter last, OutputIter result)
 	{
+		if constexpr (_memmove_able<false, InputIter, OutputIter>)
+			return _trivial_copy(first, last, result);
 		while (first != last)
 		{
 			*result = *first;
@@ -377,6 +515,8 @@ namespace TinySTL
 	template <class InputIter, class Size, class OutputIter>
 	OutputIter copy_n(InputIter first, Size n, OutputIter result)
 	{
+		if constexpr (_memmove_able<false, InputIter, OutputIter>)
+			return n > 0 ? _trivial_copy(first, first + n, result) : result;
 		while (n > 0)
 		{
 			*result = *first;
@@ -407,6 +547,8 @@ namespace TinySTL
 	BidirectIter2 copy_backward(BidirectIter1 first, BidirectIter1 last,
 								BidirectIter2 result)
 	{
+		if constexpr (_memmove_able<false, BidirectIter1, BidirectIter2>)
+			return _trivial_copy_backward(first, last, result);
 		while (first != last)
 			*(--result) = *(--last);
 		return result;
@@ -415,9 +557,11 @@ namespace TinySTL
 	template <class InputIter, class OutputIter>
 	OutputIter move(InputIter first, InputIter last, OutputIter result)
 	{
+		if constexpr (_memmove_able<true, InputIter, OutputIter>)
+			return _trivial_copy(first, last, result);
 		while (first != last)
 		{
-			*result = move(*first);
+			*result = TinySTL::move(*first);
 			++first;
 			++result;
 		}
@@ -428,8 +572,10 @@ namespace TinySTL
 	BidirectIter2 move_backward(BidirectIter1 first, BidirectIter1 last,
 								BidirectIter2 result)
 	{
+		if constexpr (_memmove_able<true, BidirectIter1, BidirectIter2>)
+			return _trivial_copy_backward(first, last, result);
 		while (first != last)
-			*(--result) = move(*(--last));
+			*(--result) = TinySTL::move(*(--last));
 		return result;
 	}
 
@@ -438,7 +584,7 @@ namespace TinySTL
 	{
 		while (first1 != last1)
 		{
-			swap(*first1, *first2);
+			TinySTL::swap(*first1, *first2);
 			++first1;
 			++first2;
 		}
@@ -464,6 +610,20 @@ namespace TinySTL
 		return first2;
 	}
 
+	template <class InputIter1, class InputIter2, class OutputIter, class BinaryOperator>
+	OutputIter transform(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+						 OutputIter result, BinaryOperator op)
+	{
+		while (first1 != last1)
+		{
+			*result = op(*first1, *first2);
+			++first1;
+			++first2;
+			++result;
+		}
+		return result;
+	}
+
 	template <class ForwardIter, class T>
 	void replace(ForwardIter first, ForwardIter last,
 				 const T& old_value, const T& new_value)
@@ -476,9 +636,9 @@ namespace TinySTL
 		}
 	}
 
-	template <class ForwardIter, class T, class UnaryPredicate>
+	template <class ForwardIter, class UnaryPredicate, class T>
 	void replace_if(ForwardIter first, ForwardIter last,
-					const T& new_value, UnaryPredicate pred)
+					UnaryPredicate pred, const T& new_value)
 	{
 		while (first != last)
 		{
@@ -514,9 +674,38 @@ namespace TinySTL
 		return result;
 	}
 
+	/* scalars in contiguous memory, candidates for memset */
+	template <class ForwardIter>
+	constexpr bool _memset_able = false;
+
+	template <class U>
+	constexpr bool _memset_able<U*> =
+		std::is_scalar_v<U> && !std::is_const_v<U> && !std::is_volatile_v<U>;
+
+	/* fills n elements with memset when val is a single byte or all zero bits */
+	template <class U, class T>
+	bool _fill_bytes(U* first, size_t n, const T& val)
+	{
+		const U tmp = val;
+		unsigned char bytes[sizeof(U)];
+		memcpy(bytes, &tmp, sizeof(U));
+		if (sizeof(U) != 1)
+		{
+			for (size_t i = 0; i != sizeof(U); ++i)
+				if (bytes[i] != 0)return false; // -0.0, null member pointers ...
+		}
+		if (n != 0)memset(first, bytes[0], n * sizeof(U));
+		return true;
+	}
+
 	template <class ForwardIter, class T>
 	ForwardIter fill(ForwardIter first, ForwardIter last, const T& val)
 	{
+		if constexpr (_memset_able<ForwardIter>)
+		{
+			if (_fill_bytes(first, size_t(last - first), val))
+				return last;
+		}
 		while (first != last)
 		{
 			*first = val;
@@ -528,6 +717,12 @@ namespace TinySTL
 	template <class ForwardIter, class Size, class T>
 	ForwardIter fill_n(ForwardIter first, Size n, const T& val)
 	{
+		if constexpr (_memset_able<ForwardIter>)
+		{
+			if (n <= 0)return first;
+			if (_fill_bytes(first, size_t(n), val))
+				return first + n;
+		}
 		while (n > 0)
 		{
 			*first = val;
@@ -686,13 +881,24 @@ namespace TinySTL
 	template <class ForwardIter>
 	ForwardIter rotate(ForwardIter first, ForwardIter middle, ForwardIter last)
 	{
-		ForwardIter next = middle;
-		while (first != next)
+		if (first == middle)return last;
+		if (middle == last)return first;
+		ForwardIter result = last;
+		/* each pass puts [middle, last) in place, [write, last) is left rotated around next_read */
+		while (first != middle)
 		{
-			iter_swap(first++, next++);
-			if (next == last)next = middle;
-			else if (first == middle)middle = next;
+			ForwardIter write = first;
+			ForwardIter next_read = first; // where the displaced [first, middle) resumes
+			for (ForwardIter read = middle; read != last; ++write, ++read)
+			{
+				if (write == next_read)next_read = read;
+				TinySTL::iter_swap(write, read);
+			}
+			if (result == last)result = write;
+			first = write;
+			middle = next_read;
 		}
+		return result;
 	}
 
 	template <class ForwardIter, class OutputIter>
@@ -703,26 +909,90 @@ namespace TinySTL
 		return copy(first, middle, result);
 	}
 
+	/* Fisher-Yates, the indices drawn by random_below() : no division most of the time */
+	template <class RandomIter, class URNG>
+	void shuffle(RandomIter first, RandomIter last, URNG&& gen)
+	{
+		for (auto i = (last - first) - 1; i > 0; --i)
+			TinySTL::swap(first[i], first[random_below(gen, uint64_t(i) + 1)]);
+	}
+
 	/*
-		-better use shuffle(), for numbers generated by rand()%(n+1)
-			aren't uniformly distributed in most cases.
-		-may produce the same result each time because of the seed.
+		shuffle() on the engine of the calling thread, seeded alike in every
+		thread : the same calls give the same result each run.
 	*/
 	template <class RandomIter>
 	void random_shuffle(RandomIter first, RandomIter last)
 	{
-		for (auto i = (last - first) - 1; i > 0; --i)
-			swap(first[i], first[rand() % (i + 1)]);
+		TinySTL::shuffle(first, last, _this_thread_random_engine());
 	}
 
-	template <class RandomIter, class URNG>
-	void shuffle(RandomIter first, RandomIter last, URNG&& gen)
-	{
-		for (auto i = (last - first) - 1; i > 0; --i)
+	/*
+		selection sampling (Knuth, TAOCP 3.4.2 algorithm S) : every element
+		is taken with probability (still wanted) / (still left), one pass,
+		the sample keeps the order of the input.
+	*/
+	template <class ForwardIter, class OutputIter, class Distance, class URNG>
+	OutputIter _sample(ForwardIter first, ForwardIter last, OutputIter result,
+					   Distance n, URNG& gen, forward_iterator_tag)
+	{
+		uint64_t left = uint64_t(TinySTL::distance(first, last));
+		uint64_t wanted = n < 0 ? 0 : (uint64_t(n) < left ? uint64_t(n) : left);
+		for (; wanted != 0; ++first, --left)
+			if (random_below(gen, left) < wanted)
+			{
+				*result = *first;
+				++result;
+				--wanted;
+			}
+		return result;
+	}
+
+	/*
+		reservoir sampling in a single pass, the length of the input unknown
+		(Li, "Reservoir-Sampling Algorithms of Time Complexity O(n(1 + log(N/n)))",
+		1994, algorithm L) : the gaps between the elements replacing one of
+		the reservoir are geometric, drawn at once, so that O(n log(N / n))
+		random numbers are drawn rather than one per element. the sample is
+		not in the order of the input.
+	*/
+	template <class InputIter, class RandomIter, class Distance, class URNG>
+	RandomIter _sample(InputIter first, InputIter last, RandomIter result,
+					   Distance n, URNG& gen, input_iterator_tag)
+	{
+		Distance k = 0;
+		for (; k < n && first != last; ++first, ++k)
+			result[k] = *first;
+		if (k < n || n <= 0)
+			return result + k;
+
+		const double inv_n = 1.0 / double(n);
+		double w = std::exp(std::log(_random_open_unit(gen)) * inv_n);
+		for (;;)
 		{
-			std::uniform_int_distribution<decltype(i)> d(0, i);
-			swap(first[i], first[d(gen)]);
+			const double gap = std::floor(std::log(_random_open_unit(gen)) / std::log1p(-w));
+			for (uint64_t skip = gap < 1.8e19 ? uint64_t(gap) : UINT64_MAX; skip != 0 && first != last; --skip)
+				++first;
+			if (first == last)
+				break;
+			result[random_below(gen, uint64_t(n))] = *first;
+			++first;
+			w *= std::exp(std::log(_random_open_unit(gen)) * inv_n);
 		}
+		return result + n;
+	}
+
+	/*
+		copies min(n, last - first) elements of [first, last) to result, each
+		subset equally likely, returns the end of the copy.
+		-forward iterators : in the order of the input, see above.
+		-input iterators : result random access, any order.
+	*/
+	template <class PopulationIter, class SampleIter, class Distance, class URNG>
+	SampleIter sample(PopulationIter first, PopulationIter last, SampleIter result,
+					  Distance n, URNG&& gen)
+	{
+		return _sample(first, last, result, n, gen, iterator_category(first));
 	}
 
 	template <class InputIter, class UnaryPredicate>
@@ -801,47 +1071,108 @@ namespace TinySTL
 	}
 
 
-	template <class ForwardIter, class Pointer, class UnaryPredicate>
+	/* elements moved into a temporary_buffer, destroyed however we leave */
+	template <class T>
+	class _buffer_guard
+	{
+	public:
+		T* first;
+		T* last;
+
+		explicit _buffer_guard(T* buffer) :first(buffer), last(buffer) {}
+		~_buffer_guard()
+		{
+			for (; first != last; ++first)
+				first->~T();
+		}
+
+		_buffer_guard(const _buffer_guard&) = delete;
+		_buffer_guard& operator=(const _buffer_guard&) = delete;
+
+		template <class InputIter>
+		void move_in(InputIter src_first, InputIter src_last)
+		{
+			for (; src_first != src_last; ++src_first, ++last)
+				::new(static_cast<void*>(last)) T(TinySTL::move(*src_first));
+		}
+
+		void push(T&& val)
+		{
+			::new(static_cast<void*>(last)) T(TinySTL::move(val));
+			++last;
+		}
+	};
+
+	/*
+		stable partition with a buffer of buffer_size elements
+		-ranges that fit are split in one pass, the rejected elements going
+		 through the buffer.
+		-bigger ones are halved and the two partitioned halves rotated together,
+		 O(n log(n / buffer_size)) moves, plain inplace_stable_partition with no buffer.
+	*/
+	template <class ForwardIter, class UnaryPredicate, class Distance, class T>
 	ForwardIter adaptive_stable_partition(ForwardIter first, ForwardIter last,
-										  UnaryPredicate pred, Pointer ptr)
+										  UnaryPredicate pred, Distance len,
+										  T* buffer, Distance buffer_size)
 	{
-		ForwardIter result1 = first;
-		ForwardIter result2 = ptr;
-		while (first != last)
+		if (len == 1)return pred(*first) ? last : first;
+		if (len <= buffer_size)
 		{
-			if (pred(*first))
+			_buffer_guard<T> rejected(buffer);
+			ForwardIter result = first;
+			for (; first != last; ++first)
 			{
-				*result1 = *first;
-				++result1;
+				if (!pred(*first))
+					rejected.push(TinySTL::move(*first));
+				else
+				{
+					if (result != first)*result = TinySTL::move(*first);
+					++result;
+				}
 			}
-			else
-			{
-				*result2 = *first;
-				++result2;
-			}
-			++first;
+			TinySTL::move(rejected.first, rejected.last, result);
+			return result;
 		}
-		copy(ptr, result2, result1);
-		free(ptr);
-		return result1;
+		ForwardIter middle = first;
+		advance(middle, len / 2);
+		return TinySTL::rotate(
+			adaptive_stable_partition(first, middle, pred, Distance(len / 2),
+									  buffer, buffer_size),
+			middle,
+			adaptive_stable_partition(middle, last, pred, Distance(len - len / 2),
+									  buffer, buffer_size));
 	}
 
 	/*
-		-get_temporary_buffer() have been deprecated in C++17.
-		-though using get_temporary_buffer() creates a chance to makes the funtion go faster,
-		 this implementation only calls adaptive_stable_partition() when there's enough memory.
+		-the scratch memory comes from temporary_buffer (tempbuf.h) : cached per
+		 thread, and whatever part of it can be had is used.
 	*/
 	template <class ForwardIter, class UnanryPredicate>
 	ForwardIter stable_partition(ForwardIter first, ForwardIter last,
 								 UnanryPredicate pred)
 	{
 		if (first == last)return first;
-		typename iterator_traits<ForwardIter>::difference_type dis;
-		dis = distance(first, last);
-		typename iterator_traits<ForwardIter>::pointer p;
-		p = malloc(sizeof(iterator_traits<ForwardIter>::value_type) * dis);
-		if (0 == p)return inplace_stable_partition(first, last, pred, dis);
-		else return adaptive_stable_partition(first, last, pred, p);
+		using Distance = typename iterator_traits<ForwardIter>::difference_type;
+		using T        = typename iterator_traits<ForwardIter>::value_type;
+		Distance dis = distance(first, last);
+		temporary_buffer<T> buf(dis);
+		return adaptive_stable_partition(first, last, pred, dis,
+										 buf.data(), Distance(buf.size()));
+	}
+
+	/* the same, the scratch memory from alloc (polymorphic_allocator over a memory_resource ...) */
+	template <class ForwardIter, class UnanryPredicate, class Alloc>
+	ForwardIter stable_partition(ForwardIter first, ForwardIter last,
+								 UnanryPredicate pred, const Alloc& alloc)
+	{
+		if (first == last)return first;
+		using Distance = typename iterator_traits<ForwardIter>::difference_type;
+		using T        = typename iterator_traits<ForwardIter>::value_type;
+		using A        = typename allocator_traits<Alloc>::template rebind_alloc<T>;
+		Distance dis = distance(first, last);
+		temporary_buffer<T, A> buf(dis, A(alloc));
+		return adaptive_stable_partition(first, last, pred, dis,
+										 buf.data(), Distance(buf.size()));
 	}
 
 	template <class InputIter, class OutputIter1,
@@ -935,184 +1266,1181 @@ namespace TinySTL
 			RandomIter cut = unguarded_partition(first, last, 
 												 median(*first,
 														*(first + (last - first) / 2),
-														*(last - 1)), comp);
+														*(last - 1), comp), comp);
 			introsort(cut, last, depth_limit, comp);
 			last = cut;
 		}
 		insertion_sort(first, last, comp);
 	}
 
-	template <class RandomIter>
-	void sort(RandomIter first, RandomIter last)
+	/*
+		pattern-defeating quicksort (O.R.L. Peters, "pdqsort", 2016/2021)
+		-ninther pivot for large ranges, median of 3 otherwise.
+		-arithmetic keys under less<> are partitioned branchlessly by blocks
+		 (S. Edelkamp, A. Weiss, "BlockQuicksort", 2016) : offsets of misplaced
+		 elements are collected in a buffer first, then swapped.
+		-a pivot equal to the one of the parent partition means lots of
+		 duplicates : the equal elements are put aside in one pass.
+		-an already partitioned range gets a bounded insertion sort try,
+		 which finishes sorted and nearly sorted inputs in O(n).
+		-highly unbalanced partitions swap a few fixed elements around to break
+		 the pattern, after log2(n) of them the range goes to heapsort.
+	*/
+	template <class T>
+	inline int _log2(T n)
 	{
-		if (first != last)
-			introsort(first, last, log(last - first) * 2);
+		int log = 0;
+		while (n >>= 1)
+			++log;
+		return log;
 	}
 
+	template <class T, class Compare>
+	struct _is_branchless_compare
+		:std::integral_constant<bool, std::is_arithmetic_v<T> &&
+			(std::is_same_v<Compare, less<> > || std::is_same_v<Compare, less<T> >)> {};
+
 	template <class RandomIter, class Compare>
-	void sort(RandomIter first, RandomIter last, Compare comp)
+	void _pdq_insertion_sort(RandomIter first, RandomIter last, Compare comp)
 	{
-		if (first != last)
-			introsort(first, last, log(last - first) * 2, comp);
+		using T = typename iterator_traits<RandomIter>::value_type;
+		if (first == last)return;
+		for (RandomIter cur = first + 1; cur != last; ++cur)
+		{
+			RandomIter sift = cur, sift_1 = cur - 1;
+			if (comp(*sift, *sift_1))
+			{
+				T tmp = TinySTL::move(*sift);
+				do
+					*sift-- = TinySTL::move(*sift_1);
+				while (sift != first && comp(tmp, *--sift_1));
+				*sift = TinySTL::move(tmp);
+			}
+		}
 	}
 
-	template <class RandomIter>
-	void inplace_stable_sort(RandomIter first, RandomIter last)
+	/* *(first - 1) shall not be greater than any element of [first, last) */
+	template <class RandomIter, class Compare>
+	void _pdq_unguarded_insertion_sort(RandomIter first, RandomIter last, Compare comp)
 	{
-		inplace_stable_sort(first, last, less<>());
+		using T = typename iterator_traits<RandomIter>::value_type;
+		if (first == last)return;
+		for (RandomIter cur = first + 1; cur != last; ++cur)
+		{
+			RandomIter sift = cur, sift_1 = cur - 1;
+			if (comp(*sift, *sift_1))
+			{
+				T tmp = TinySTL::move(*sift);
+				do
+					*sift-- = TinySTL::move(*sift_1);
+				while (comp(tmp, *--sift_1));
+				*sift = TinySTL::move(tmp);
+			}
+		}
 	}
 
+	/* gives up (returns false) after PDQSORT_PARTIAL_INSERTION_LIMIT moves */
 	template <class RandomIter, class Compare>
-	void inplace_stable_sort(RandomIter first, RandomIter last, Compare comp)
+	bool _pdq_partial_insertion_sort(RandomIter first, RandomIter last, Compare comp)
 	{
-		if (last - first < STABLE_SORT_THRESHOLD)
+		using T = typename iterator_traits<RandomIter>::value_type;
+		if (first == last)return true;
+		size_t limit = 0;
+		for (RandomIter cur = first + 1; cur != last; ++cur)
 		{
-			insertion_sort(first, last, comp);
-			return;
+			RandomIter sift = cur, sift_1 = cur - 1;
+			if (comp(*sift, *sift_1))
+			{
+				T tmp = TinySTL::move(*sift);
+				do
+					*sift-- = TinySTL::move(*sift_1);
+				while (sift != first && comp(tmp, *--sift_1));
+				*sift = TinySTL::move(tmp);
+				limit += cur - sift;
+			}
+			if (limit > PDQSORT_PARTIAL_INSERTION_LIMIT)
+				return false;
 		}
-		RandomIter mid = first + (last - first) / 2;
-		inplace_stable_sort(first, mid, comp);
-		inplace_stable_sort(mid, last, comp);
-		inplace_merge(first, mid, last, comp);
+		return true;
 	}
 
-	template <class RandomIter, class Pointer>
-	void adaptive_stable_sort(RandomIter first, RandomIter last,
-							  Pointer ptr)
+	template <class RandomIter, class Compare>
+	inline void _pdq_sort2(RandomIter a, RandomIter b, Compare comp)
 	{
-		adaptive_stable_sort(first, last, ptr, less<>());
+		if (comp(*b, *a))
+			TinySTL::iter_swap(a, b);
 	}
 
-	template <class RandomIter, class Pointer, class Compare>
-	void adaptive_stable_sort(RandomIter first, RandomIter last, 
-							  Pointer ptr, Compare comp)
+	template <class RandomIter, class Compare>
+	inline void _pdq_sort3(RandomIter a, RandomIter b, RandomIter c, Compare comp)
 	{
-		if (last - first == 1)return;
-		RandomIter mid = first + (last - first) / 2;
-		adaptive_stable_sort(first, mid, comp);
-		adaptive_stable_sort(mid, last, comp);
-		auto ptr_last = merge(first, mid, mid, last, ptr, comp);
-		copy(ptr, ptr_last, first);
+		_pdq_sort2(a, b, comp);
+		_pdq_sort2(b, c, comp);
+		_pdq_sort2(a, b, comp);
 	}
 
+	/*
+		swaps the elements at first + offsets_l[i] and last - offsets_r[i],
+		as a cycle of moves unless the counts matched (descending inputs,
+		where the swaps are needed to stay O(n))
+	*/
 	template <class RandomIter>
-	void stable_sort(RandomIter first, RandomIter last)
+	inline void _pdq_swap_offsets(RandomIter first, RandomIter last,
+								  unsigned char* offsets_l, unsigned char* offsets_r,
+								  size_t num, bool use_swaps)
 	{
-		stable_sort(first, last, less<>());
+		using T = typename iterator_traits<RandomIter>::value_type;
+		if (use_swaps)
+		{
+			for (size_t i = 0; i < num; ++i)
+				TinySTL::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+		}
+		else if (num > 0)
+		{
+			RandomIter l = first + offsets_l[0], r = last - offsets_r[0];
+			T tmp(TinySTL::move(*l));
+			*l = TinySTL::move(*r);
+			for (size_t i = 1; i < num; ++i)
+			{
+				l = first + offsets_l[i];
+				*r = TinySTL::move(*l);
+				r = last - offsets_r[i];
+				*l = TinySTL::move(*r);
+			}
+			*r = TinySTL::move(tmp);
+		}
 	}
 
+	/*
+		partitions around *first : [< pivot] pivot [>= pivot],
+		returns the pivot position, already_partitioned tells whether nothing had to move
+	*/
 	template <class RandomIter, class Compare>
-	void stable_sort(RandomIter first, RandomIter last, Compare comp)
+	RandomIter _pdq_partition_right(RandomIter begin, RandomIter end, Compare comp,
+									bool& already_partitioned)
 	{
-		if (first == last)return;
-		auto dis = last - first;
-		typename iterator_traits<RandomIter>::pointer p;
-		p = malloc(sizeof(iterator_traits<RandomIter>::value_type) * dis);
-		if (0 == p)inplace_stable_sort(first, last, comp);
-		else adaptive_stable_sort(first, last, p, comp);
-		free(p);
-	}
+		using T = typename iterator_traits<RandomIter>::value_type;
+		T pivot(TinySTL::move(*begin));
+		RandomIter first = begin, last = end;
 
-	template <class RandomIter, class T, class Compare>
-	void unguarded_linear_insert(RandomIter last, T val, Compare comp)
-	{
-		RandomIter next = last - 1;
-		while (comp(val, *next))
+		/* the median of 3 guards both scans */
+		while (comp(*++first, pivot));
+		if (first - 1 == begin)
+			while (first < last && !comp(*--last, pivot));
+		else
+			while (!comp(*--last, pivot));
+
+		already_partitioned = first >= last;
+		while (first < last)
 		{
-			*last = *next;
-			last = next;
-			--next;
+			TinySTL::iter_swap(first, last);
+			while (comp(*++first, pivot));
+			while (!comp(*--last, pivot));
 		}
-		*last = val;
-	}
 
-	template <class RandomIter, class T>
-	void linear_insert(RandomIter first, RandomIter last, T*)
-	{
-		linear_insert(first, last, T*(0), less<>());
+		RandomIter pivot_pos = first - 1;
+		*begin     = TinySTL::move(*pivot_pos);
+		*pivot_pos = TinySTL::move(pivot);
+		return pivot_pos;
 	}
 
-	template <class RandomIter, class Compare, class T>
-	void linear_insert(RandomIter first, RandomIter last, Compare comp, T*)
+	template <class RandomIter, class Compare>
+	RandomIter _pdq_partition_right_branchless(RandomIter begin, RandomIter end, Compare comp,
+											   bool& already_partitioned)
 	{
-		T val = *last;
-		if (comp(val, *first)) 
+		using T = typename iterator_traits<RandomIter>::value_type;
+		T pivot(TinySTL::move(*begin));
+		RandomIter first = begin, last = end;
+
+		while (comp(*++first, pivot));
+		if (first - 1 == begin)
+			while (first < last && !comp(*--last, pivot));
+		else
+			while (!comp(*--last, pivot));
+
+		already_partitioned = first >= last;
+		if (!already_partitioned)
 		{
-			copy_backward(first, last, last + 1);
-			*first = val;
+			TinySTL::iter_swap(first, last);
+			++first;
+
+			alignas(64) unsigned char offsets_l[PDQSORT_BLOCK_SIZE];
+			alignas(64) unsigned char offsets_r[PDQSORT_BLOCK_SIZE];
+			RandomIter offsets_l_base = first, offsets_r_base = last;
+			size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+			while (first < last)
+			{
+				/* refill the empty offset block(s) from what is still unknown */
+				size_t num_unknown = size_t(last - first);
+				size_t left_split  = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+				size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+				if (left_split > PDQSORT_BLOCK_SIZE)
+					left_split = PDQSORT_BLOCK_SIZE;
+				if (right_split > PDQSORT_BLOCK_SIZE)
+					right_split = PDQSORT_BLOCK_SIZE;
+
+				/* no branch on the comparison : the offset is always written */
+				for (size_t i = 0; i < left_split; ++i, ++first)
+				{
+					offsets_l[num_l] = (unsigned char)i;
+					num_l += !comp(*first, pivot);
+				}
+				for (size_t i = 0; i < right_split; )
+				{
+					offsets_r[num_r] = (unsigned char)++i;
+					num_r += comp(*--last, pivot);
+				}
+
+				size_t num = num_l < num_r ? num_l : num_r;
+				_pdq_swap_offsets(offsets_l_base, offsets_r_base,
+								  offsets_l + start_l, offsets_r + start_r,
+								  num, num_l == num_r);
+				num_l -= num;
+				num_r -= num;
+				start_l += num;
+				start_r += num;
+				if (num_l == 0)
+				{
+					start_l = 0;
+					offsets_l_base = first;
+				}
+				if (num_r == 0)
+				{
+					start_r = 0;
+					offsets_r_base = last;
+				}
+			}
+
+			/* one side may still have misplaced elements, move them to the border */
+			if (num_l)
+			{
+				unsigned char* offsets = offsets_l + start_l;
+				while (num_l--)
+					TinySTL::iter_swap(offsets_l_base + offsets[num_l], --last);
+				first = last;
+			}
+			if (num_r)
+			{
+				unsigned char* offsets = offsets_r + start_r;
+				while (num_r--)
+				{
+					TinySTL::iter_swap(offsets_r_base - offsets[num_r], first);
+					++first;
+				}
+				last = first;
+			}
 		}
-		else unguarded_linear_insert(last, val, comp);
-	}
 
-	template <class RandomIter>
-	void insertion_sort(RandomIter first, RandomIter last)
-	{
-		return insertion_sort(first, last, less<>());
+		RandomIter pivot_pos = first - 1;
+		*begin     = TinySTL::move(*pivot_pos);
+		*pivot_pos = TinySTL::move(pivot);
+		return pivot_pos;
 	}
 
+	/* [<= pivot] pivot [> pivot], for runs of elements equal to the pivot */
 	template <class RandomIter, class Compare>
-	void insertion_sort(RandomIter first, RandomIter last, Compare comp)
+	RandomIter _pdq_partition_left(RandomIter begin, RandomIter end, Compare comp)
 	{
-		if (first == last)return;
-		for (RandomIter i = first + 1; i != last; ++i)
-			linear_insert(first, i, comp, value_type(first));
-	}
+		using T = typename iterator_traits<RandomIter>::value_type;
+		T pivot(TinySTL::move(*begin));
+		RandomIter first = begin, last = end;
 
-	template <class RandomIter>
-	void partial_sort(RandomIter first, RandomIter mid, RandomIter last)
-	{
-		partial_sort(first, mid, last, less<>());
-	}
+		while (comp(pivot, *--last));
+		if (last + 1 == end)
+			while (first < last && !comp(pivot, *++first));
+		else
+			while (!comp(pivot, *++first));
 
-	template <class RandomIter, class Compare>
-	void partial_sort(RandomIter first, RandomIter mid, 
-					  RandomIter last, Compare comp)
-	{
-		make_heap(first, mid);
-		for (RandomIter i = mid; i < last; ++i)
+		while (first < last)
 		{
-			if (comp(*i, *first))
-				_pop_heap(first, mid, i, *i, comp);
+			TinySTL::iter_swap(first, last);
+			while (comp(pivot, *--last));
+			while (!comp(pivot, *++first));
 		}
-		sort_heap(first, mid, comp);
-	}
 
-	template <class InputIter, class RandomIter>
-	void partial_sort_copy(InputIter first, InputIter last,
-						   RandomIter result_first, RandomIter result_last)
-	{
-		partial_sort_copy(first, last, result_first, result_last, less<>());
+		RandomIter pivot_pos = last;
+		*begin     = TinySTL::move(*pivot_pos);
+		*pivot_pos = TinySTL::move(pivot);
+		return pivot_pos;
 	}
 
-	template <class InputIter, class RandomIter, class Compare>
-	void partial_sort_copy(InputIter first, InputIter last, 
-						   RandomIter result_first, RandomIter result_last,
-						   Compare comp)
+	template <bool Branchless, class RandomIter, class Compare>
+	void _pdqsort_loop(RandomIter begin, RandomIter end, Compare comp,
+					   int bad_allowed, bool leftmost = true)
 	{
-		using Distance = typename iterator_traits<InputIter>::difference_type;
-		using T        = typename iterator_traits<InputIter>::value_type;
-		if (result_first == result_last)
-			return result_last;
-		RandomIter result_now = result_first;
-		while (first != last && result_now != result_last)
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		for (;;)
 		{
-			*result_now = *first;
-			++result_now;
-			++first;
-		}
+			Distance size = end - begin;
+			if (size < PDQSORT_INSERTION_THRESHOLD)
+			{
+				if (leftmost)
+					_pdq_insertion_sort(begin, end, comp);
+				else
+					_pdq_unguarded_insertion_sort(begin, end, comp);
+				return;
+			}
+
+			/* pivot to *begin */
+			Distance s2 = size / 2;
+			if (size > PDQSORT_NINTHER_THRESHOLD)
+			{
+				_pdq_sort3(begin, begin + s2, end - 1, comp);
+				_pdq_sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+				_pdq_sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+				_pdq_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+				TinySTL::iter_swap(begin, begin + s2);
+			}
+			else
+				_pdq_sort3(begin + s2, begin, end - 1, comp);
+
+			/* the pivot equals the one before us : nothing smaller in there */
+			if (!leftmost && !comp(*(begin - 1), *begin))
+			{
+				begin = _pdq_partition_left(begin, end, comp) + 1;
+				continue;
+			}
+
+			bool already_partitioned;
+			RandomIter pivot_pos = Branchless
+				? _pdq_partition_right_branchless(begin, end, comp, already_partitioned)
+				: _pdq_partition_right(begin, end, comp, already_partitioned);
+
+			Distance l_size = pivot_pos - begin;
+			Distance r_size = end - (pivot_pos + 1);
+			if (l_size < size / 8 || r_size < size / 8)
+			{
+				if (--bad_allowed == 0)
+				{
+					make_heap(begin, end, comp);
+					sort_heap(begin, end, comp);
+					return;
+				}
+
+				if (l_size >= PDQSORT_INSERTION_THRESHOLD)
+				{
+					TinySTL::iter_swap(begin, begin + l_size / 4);
+					TinySTL::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+					if (l_size > PDQSORT_NINTHER_THRESHOLD)
+					{
+						TinySTL::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+						TinySTL::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+						TinySTL::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+						TinySTL::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+					}
+				}
+				if (r_size >= PDQSORT_INSERTION_THRESHOLD)
+				{
+					TinySTL::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+					TinySTL::iter_swap(end - 1, end - r_size / 4);
+					if (r_size > PDQSORT_NINTHER_THRESHOLD)
+					{
+						TinySTL::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+						TinySTL::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+						TinySTL::iter_swap(end - 2, end - (1 + r_size / 4));
+						TinySTL::iter_swap(end - 3, end - (2 + r_size / 4));
+					}
+				}
+			}
+			else if (already_partitioned &&
+					 _pdq_partial_insertion_sort(begin, pivot_pos, comp) &&
+					 _pdq_partial_insertion_sort(pivot_pos + 1, end, comp))
+				return;
+
+			_pdqsort_loop<Branchless>(begin, pivot_pos, comp, bad_allowed, leftmost);
+			begin = pivot_pos + 1;
+			leftmost = false;
+		}
+	}
+
+	/* whole range ascending, or descending (then reversed) : done in one scan */
+	template <class RandomIter, class Compare>
+	bool _sort_presorted(RandomIter first, RandomIter last, Compare comp)
+	{
+		RandomIter next = first + 1;
+		if (comp(*next, *first))
+		{
+			while (++next != last && !comp(*(next - 1), *next));
+			if (next != last)return false;
+			reverse(first, last);
+			return true;
+		}
+		while (++next != last && !comp(*next, *(next - 1)));
+		return next == last;
+	}
+
+	template <class RandomIter>
+	void sort(RandomIter first, RandomIter last)
+	{
+		sort(first, last, less<>());
+	}
+
+	template <class RandomIter, class Compare>
+	void sort(RandomIter first, RandomIter last, Compare comp)
+	{
+		using T = typename iterator_traits<RandomIter>::value_type;
+		if (last - first < 2 || _sort_presorted(first, last, comp))
+			return;
+		_pdqsort_loop<_is_branchless_compare<T, Compare>::value>(
+			first, last, comp, _log2(last - first));
+	}
+
+	/*
+		defined with the searches and merges further down, declared here for the
+		stable sorts : on pointers no argument dependent lookup would find them
+	*/
+	template <class ForwardIter, class T, class Compare>
+	ForwardIter upper_bound(ForwardIter first, ForwardIter last,
+							const T& val, Compare comp);
+	template <class BidirectIter, class Distance, class T, class Compare>
+	void adaptive_merge(BidirectIter first, BidirectIter mid, BidirectIter last,
+						Distance len1, Distance len2,
+						T* buffer, Distance buffer_size, Compare comp);
+	template <class BidirectIter, class Compare>
+	void inplace_merge(BidirectIter first, BidirectIter mid,
+					   BidirectIter last, Compare comp);
+
+	template <class RandomIter>
+	void inplace_stable_sort(RandomIter first, RandomIter last)
+	{
+		inplace_stable_sort(first, last, less<>());
+	}
+
+	template <class RandomIter, class Compare>
+	void inplace_stable_sort(RandomIter first, RandomIter last, Compare comp)
+	{
+		if (last - first < STABLE_SORT_THRESHOLD)
+		{
+			insertion_sort(first, last, comp);
+			return;
+		}
+		RandomIter mid = first + (last - first) / 2;
+		inplace_stable_sort(first, mid, comp);
+		inplace_stable_sort(mid, last, comp);
+		inplace_merge(first, mid, last, comp);
+	}
+
+	/*
+		length of the run starting at first, a strictly descending one
+		is reversed in place (strictly, so that reversing keeps it stable)
+	*/
+	template <class RandomIter, class Compare>
+	typename iterator_traits<RandomIter>::difference_type
+	_timsort_count_run(RandomIter first, RandomIter last, Compare comp)
+	{
+		RandomIter cur = first + 1;
+		if (cur == last)return 1;
+		if (comp(*cur, *first))
+		{
+			while (++cur != last && comp(*cur, *(cur - 1)))
+				;
+			TinySTL::reverse(first, cur);
+		}
+		else
+		{
+			while (++cur != last && !comp(*cur, *(cur - 1)))
+				;
+		}
+		return cur - first;
+	}
+
+	/* [first, sorted) is sorted already */
+	template <class RandomIter, class Compare>
+	void _binary_insertion_sort(RandomIter first, RandomIter sorted,
+								RandomIter last, Compare comp)
+	{
+		for (; sorted != last; ++sorted)
+		{
+			auto val = TinySTL::move(*sorted);
+			RandomIter pos = upper_bound(first, sorted, val, comp);
+			TinySTL::move_backward(pos, sorted, sorted + 1);
+			*pos = TinySTL::move(val);
+		}
+	}
+
+	/*
+		n / 2^k rounded up to [TIMSORT_MIN_MERGE / 2, TIMSORT_MIN_MERGE] :
+		the runs then split n into an exact or slightly smaller power of 2 of
+		pieces, which keeps the merges balanced
+	*/
+	template <class Distance>
+	Distance _timsort_min_run(Distance n)
+	{
+		Distance r = 0;
+		while (n >= TIMSORT_MIN_MERGE)
+		{
+			r |= n & 1;
+			n >>= 1;
+		}
+		return n + r;
+	}
+
+	/*
+		first k of [base, base + len) with !(base[k] < key), starting the
+		search at hint with steps of 1, 3, 7, 15 ... before the binary search :
+		O(log d) compares when the answer is d away from hint
+	*/
+	template <class T, class Iterator, class Distance, class Compare>
+	Distance _gallop_left(const T& key, Iterator base, Distance len,
+						  Distance hint, Compare comp)
+	{
+		Distance last_ofs = 0, ofs = 1;
+		if (comp(base[hint], key))
+		{
+			Distance max_ofs = len - hint;
+			while (ofs < max_ofs && comp(base[hint + ofs], key))
+			{
+				last_ofs = ofs;
+				ofs = (ofs << 1) + 1;
+				if (ofs <= 0)ofs = max_ofs;
+			}
+			if (ofs > max_ofs)ofs = max_ofs;
+			last_ofs += hint;
+			ofs += hint;
+		}
+		else
+		{
+			Distance max_ofs = hint + 1;
+			while (ofs < max_ofs && !comp(base[hint - ofs], key))
+			{
+				last_ofs = ofs;
+				ofs = (ofs << 1) + 1;
+				if (ofs <= 0)ofs = max_ofs;
+			}
+			if (ofs > max_ofs)ofs = max_ofs;
+			Distance tmp = last_ofs;
+			last_ofs = hint - ofs;
+			ofs = hint - tmp;
+		}
+		/* base[last_ofs] < key <= base[ofs] */
+		++last_ofs;
+		while (last_ofs < ofs)
+		{
+			Distance m = last_ofs + (ofs - last_ofs) / 2;
+			if (comp(base[m], key))last_ofs = m + 1;
+			else ofs = m;
+		}
+		return ofs;
+	}
+
+	/* first k of [base, base + len) with key < base[k], see _gallop_left */
+	template <class T, class Iterator, class Distance, class Compare>
+	Distance _gallop_right(const T& key, Iterator base, Distance len,
+						   Distance hint, Compare comp)
+	{
+		Distance last_ofs = 0, ofs = 1;
+		if (comp(key, base[hint]))
+		{
+			Distance max_ofs = hint + 1;
+			while (ofs < max_ofs && comp(key, base[hint - ofs]))
+			{
+				last_ofs = ofs;
+				ofs = (ofs << 1) + 1;
+				if (ofs <= 0)ofs = max_ofs;
+			}
+			if (ofs > max_ofs)ofs = max_ofs;
+			Distance tmp = last_ofs;
+			last_ofs = hint - ofs;
+			ofs = hint - tmp;
+		}
+		else
+		{
+			Distance max_ofs = len - hint;
+			while (ofs < max_ofs && !comp(key, base[hint + ofs]))
+			{
+				last_ofs = ofs;
+				ofs = (ofs << 1) + 1;
+				if (ofs <= 0)ofs = max_ofs;
+			}
+			if (ofs > max_ofs)ofs = max_ofs;
+			last_ofs += hint;
+			ofs += hint;
+		}
+		/* base[last_ofs] <= key < base[ofs] */
+		++last_ofs;
+		while (last_ofs < ofs)
+		{
+			Distance m = last_ofs + (ofs - last_ofs) / 2;
+			if (comp(key, base[m]))ofs = m;
+			else last_ofs = m + 1;
+		}
+		return ofs;
+	}
+
+	/*
+		run stack and merges of the timsort
+		(T. Peters, listsort.txt, with the corrected stack invariant of
+		 de Gouw et al., "OpenJDK's java.utils.Collection.sort() is broken", 2015)
+		-merge_lo/merge_hi move the shorter run into the buffer and merge
+		 straight back into place : nothing is ever copied back afterwards.
+		-when one side keeps winning (min_gallop times in a row) the merge
+		 switches to galloping, copying whole blocks found by exponential search;
+		 min_gallop adapts to how often that pays off.
+		-a merge whose shorter run doesn't fit in the buffer goes to adaptive_merge.
+	*/
+	template <class RandomIter, class T, class Distance, class Compare>
+	class _timsort_merger
+	{
+	protected:
+		T*         buffer;
+		Distance   buffer_size;
+		Compare    comp;
+		Distance   min_gallop;
+		int        run_count;
+		RandomIter run_base[TIMSORT_MAX_RUNS];
+		Distance   run_len[TIMSORT_MAX_RUNS];
+
+	public:
+		_timsort_merger(T* buf, Distance buf_size, Compare cmp)
+			:buffer(buf), buffer_size(buf_size), comp(cmp),
+			 min_gallop(TIMSORT_MIN_GALLOP), run_count(0) {}
+
+		void push_run(RandomIter base, Distance len)
+		{
+			run_base[run_count] = base;
+			run_len[run_count] = len;
+			++run_count;
+		}
+
+		/*
+			restores, for the top runs A B C D :
+			len(B) > len(C) + len(D), len(A) > len(B) + len(C), len(C) > len(D)
+		*/
+		void merge_collapse()
+		{
+			while (run_count > 1)
+			{
+				int n = run_count - 2;
+				if ((n > 0 && run_len[n - 1] <= run_len[n] + run_len[n + 1]) ||
+					(n > 1 && run_len[n - 2] <= run_len[n - 1] + run_len[n]))
+				{
+					if (run_len[n - 1] < run_len[n + 1])--n;
+				}
+				else if (run_len[n] > run_len[n + 1])
+					break;
+				merge_at(n);
+			}
+		}
+
+		void merge_force_collapse()
+		{
+			while (run_count > 1)
+			{
+				int n = run_count - 2;
+				if (n > 0 && run_len[n - 1] < run_len[n + 1])--n;
+				merge_at(n);
+			}
+		}
+
+	protected:
+		/* merges runs i and i + 1 */
+		void merge_at(int i)
+		{
+			RandomIter base1 = run_base[i], base2 = run_base[i + 1];
+			Distance   len1  = run_len[i],  len2  = run_len[i + 1];
+			run_len[i] = len1 + len2;
+			if (i == run_count - 3)
+			{
+				run_base[i + 1] = run_base[i + 2];
+				run_len[i + 1]  = run_len[i + 2];
+			}
+			--run_count;
+
+			/* what is already in place at both ends is left alone */
+			Distance k = _gallop_right(*base2, base1, len1, Distance(0), comp);
+			base1 += k;
+			len1  -= k;
+			if (len1 == 0)return;
+			len2 = _gallop_left(*(base1 + (len1 - 1)), base2, len2, Distance(len2 - 1), comp);
+			if (len2 == 0)return;
+
+			if (len1 <= len2 && len1 <= buffer_size)
+				merge_lo(base1, len1, base2, len2);
+			else if (len2 < len1 && len2 <= buffer_size)
+				merge_hi(base1, len1, base2, len2);
+			else
+				adaptive_merge(base1, base2, base2 + len2, len1, len2,
+							   buffer, buffer_size, comp);
+		}
+
+		/*
+			len1 <= len2, run 1 goes to the buffer, the merge runs forward.
+			the first element of run 2 and the last of run 1 are known to be
+			the first and last of the result (merge_at galloped to them).
+		*/
+		void merge_lo(RandomIter base1, Distance len1, RandomIter base2, Distance len2)
+		{
+			_buffer_guard<T> tmp(buffer);
+			tmp.move_in(base1, base1 + len1);
+			T*         cur1 = tmp.first;
+			RandomIter cur2 = base2;
+			RandomIter dest = base1;
+
+			*dest++ = TinySTL::move(*cur2++);
+			if (--len2 != 0 && len1 != 1)
+				_merge_lo_loop(cur1, len1, cur2, len2, dest);
+			if (len1 == 1)
+			{
+				dest = TinySTL::move(cur2, cur2 + len2, dest);
+				*dest = TinySTL::move(*cur1);
+			}
+			else
+				TinySTL::move(cur1, cur1 + len1, dest);
+		}
+
+		/* returns with len1 == 1 or len2 == 0 (or len1 == 0 if comp is inconsistent) */
+		void _merge_lo_loop(T*& cur1, Distance& len1, RandomIter& cur2,
+							Distance& len2, RandomIter& dest)
+		{
+			Distance gallop = min_gallop;
+			for (;;)
+			{
+				Distance count1 = 0, count2 = 0;
+				/* one element at a time until a run wins often enough */
+				do
+				{
+					if (comp(*cur2, *cur1))
+					{
+						*dest++ = TinySTL::move(*cur2++);
+						++count2;
+						count1 = 0;
+						if (--len2 == 0)return _leave_gallop(gallop);
+					}
+					else
+					{
+						*dest++ = TinySTL::move(*cur1++);
+						++count1;
+						count2 = 0;
+						if (--len1 == 1)return _leave_gallop(gallop);
+					}
+				} while ((count1 | count2) < gallop);
+
+				/* galloping, until neither run wins by TIMSORT_MIN_GALLOP */
+				do
+				{
+					count1 = _gallop_right(*cur2, cur1, len1, Distance(0), comp);
+					if (count1 != 0)
+					{
+						dest  = TinySTL::move(cur1, cur1 + count1, dest);
+						cur1 += count1;
+						len1 -= count1;
+						if (len1 <= 1)return _leave_gallop(gallop);
+					}
+					*dest++ = TinySTL::move(*cur2++);
+					if (--len2 == 0)return _leave_gallop(gallop);
+
+					count2 = _gallop_left(*cur1, cur2, len2, Distance(0), comp);
+					if (count2 != 0)
+					{
+						dest  = TinySTL::move(cur2, cur2 + count2, dest);
+						cur2 += count2;
+						len2 -= count2;
+						if (len2 == 0)return _leave_gallop(gallop);
+					}
+					*dest++ = TinySTL::move(*cur1++);
+					if (--len1 == 1)return _leave_gallop(gallop);
+					--gallop;
+				} while (count1 >= TIMSORT_MIN_GALLOP || count2 >= TIMSORT_MIN_GALLOP);
+				if (gallop < 0)gallop = 0;
+				gallop += 2; // penalty for leaving gallop mode
+			}
+		}
+
+		/*
+			len2 < len1, run 2 goes to the buffer, the merge runs backward.
+			cursors point one past the next element to take.
+		*/
+		void merge_hi(RandomIter base1, Distance len1, RandomIter base2, Distance len2)
+		{
+			_buffer_guard<T> tmp(buffer);
+			tmp.move_in(base2, base2 + len2);
+			RandomIter cur1 = base1 + len1;
+			T*         cur2 = tmp.last;
+			RandomIter dest = base2 + len2;
+
+			*--dest = TinySTL::move(*--cur1);
+			if (--len1 != 0 && len2 != 1)
+				_merge_hi_loop(cur1, len1, cur2, len2, dest);
+			if (len2 == 1)
+			{
+				dest = TinySTL::move_backward(cur1 - len1, cur1, dest);
+				*--dest = TinySTL::move(*(cur2 - 1));
+			}
+			else
+				TinySTL::move_backward(cur2 - len2, cur2, dest);
+		}
+
+		/* returns with len2 == 1 or len1 == 0 (or len2 == 0 if comp is inconsistent) */
+		void _merge_hi_loop(RandomIter& cur1, Distance& len1, T*& cur2,
+							Distance& len2, RandomIter& dest)
+		{
+			Distance gallop = min_gallop;
+			for (;;)
+			{
+				Distance count1 = 0, count2 = 0;
+				do
+				{
+					if (comp(*(cur2 - 1), *(cur1 - 1)))
+					{
+						*--dest = TinySTL::move(*--cur1);
+						++count1;
+						count2 = 0;
+						if (--len1 == 0)return _leave_gallop(gallop);
+					}
+					else
+					{
+						*--dest = TinySTL::move(*--cur2);
+						++count2;
+						count1 = 0;
+						if (--len2 == 1)return _leave_gallop(gallop);
+					}
+				} while ((count1 | count2) < gallop);
+
+				do
+				{
+					count1 = len1 - _gallop_right(*(cur2 - 1), cur1 - len1, len1,
+												  Distance(len1 - 1), comp);
+					if (count1 != 0)
+					{
+						dest  = TinySTL::move_backward(cur1 - count1, cur1, dest);
+						cur1 -= count1;
+						len1 -= count1;
+						if (len1 == 0)return _leave_gallop(gallop);
+					}
+					*--dest = TinySTL::move(*--cur2);
+					if (--len2 == 1)return _leave_gallop(gallop);
+
+					count2 = len2 - _gallop_left(*(cur1 - 1), cur2 - len2, len2,
+												 Distance(len2 - 1), comp);
+					if (count2 != 0)
+					{
+						dest  = TinySTL::move_backward(cur2 - count2, cur2, dest);
+						cur2 -= count2;
+						len2 -= count2;
+						if (len2 <= 1)return _leave_gallop(gallop);
+					}
+					*--dest = TinySTL::move(*--cur1);
+					if (--len1 == 0)return _leave_gallop(gallop);
+					--gallop;
+				} while (count1 >= TIMSORT_MIN_GALLOP || count2 >= TIMSORT_MIN_GALLOP);
+				if (gallop < 0)gallop = 0;
+				gallop += 2;
+			}
+		}
+
+		void _leave_gallop(Distance gallop)
+			{ min_gallop = gallop < 1 ? 1 : gallop; }
+	};
+
+	/*
+		timsort : natural runs (descending ones reversed), extended to a
+		minimum length by binary insertion, merged on a stack
+		-O(n) on sorted, reversed or few concatenated sorted runs,
+		 O(n log n) otherwise.
+		-needs a buffer of half the range at most, less just means some
+		 merges go through adaptive_merge.
+	*/
+	template <class RandomIter, class T, class Distance, class Compare>
+	void adaptive_stable_sort(RandomIter first, RandomIter last,
+							  T* buffer, Distance buffer_size, Compare comp)
+	{
+		Distance n = Distance(last - first);
+		if (n < 2)return;
+		if (n < TIMSORT_MIN_MERGE)
+		{
+			Distance run = _timsort_count_run(first, last, comp);
+			_binary_insertion_sort(first, first + run, last, comp);
+			return;
+		}
+		_timsort_merger<RandomIter, T, Distance, Compare> merger(buffer, buffer_size, comp);
+		Distance min_run = _timsort_min_run(n);
+		do
+		{
+			Distance run = _timsort_count_run(first, last, comp);
+			if (run < min_run)
+			{
+				Distance forced = n < min_run ? n : min_run;
+				_binary_insertion_sort(first, first + run, first + forced, comp);
+				run = forced;
+			}
+			merger.push_run(first, run);
+			merger.merge_collapse();
+			first += run;
+			n     -= run;
+		} while (n != 0);
+		merger.merge_force_collapse();
+	}
+
+	template <class RandomIter>
+	void stable_sort(RandomIter first, RandomIter last)
+	{
+		stable_sort(first, last, less<>());
+	}
+
+	/*
+		-a merge only ever buffers its shorter half, half of the range is enough.
+		-less than that (temporary_buffer degrades) still works, with more
+		 rotations in the merges, down to O(n log^2 n) with no buffer at all.
+	*/
+	template <class RandomIter, class Compare>
+	void stable_sort(RandomIter first, RandomIter last, Compare comp)
+	{
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		using T        = typename iterator_traits<RandomIter>::value_type;
+		if (last - first < 2)return;
+		temporary_buffer<T> buf((last - first + 1) / 2);
+		adaptive_stable_sort(first, last, buf.data(), Distance(buf.size()), comp);
+	}
+
+	/* the same, the scratch memory from alloc (polymorphic_allocator over a memory_resource ...) */
+	template <class RandomIter, class Compare, class Alloc>
+	void stable_sort(RandomIter first, RandomIter last, Compare comp, const Alloc& alloc)
+	{
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		using T        = typename iterator_traits<RandomIter>::value_type;
+		using A        = typename allocator_traits<Alloc>::template rebind_alloc<T>;
+		if (last - first < 2)return;
+		temporary_buffer<T, A> buf((last - first + 1) / 2, A(alloc));
+		adaptive_stable_sort(first, last, buf.data(), Distance(buf.size()), comp);
+	}
+
+	/* keys -> unsigned integers of the same order, for radix_sort */
+	template <class Key>
+	auto _radix_bits(Key key)
+	{
+		static_assert(std::is_arithmetic_v<Key>,
+					  "radix_sort keys shall be integers or floating points");
+		if constexpr (std::is_floating_point_v<Key>)
+		{
+			/* IEEE 754 : flip everything of negatives, only the sign of positives */
+			using Bits = std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>;
+			static_assert(sizeof(Key) == sizeof(Bits), "unsupported floating point");
+			Bits bits;
+			memcpy(&bits, &key, sizeof(Key));
+			const Bits sign = Bits(1) << (sizeof(Bits) * 8 - 1);
+			return (bits & sign) ? Bits(~bits) : Bits(bits | sign);
+		}
+		else
+		{
+			/* two's complement : flipping the sign bit maps min..max to 0..2^n-1 */
+			using Bits = std::make_unsigned_t<Key>;
+			if constexpr (std::is_signed_v<Key>)
+				return Bits(Bits(key) ^ Bits(Bits(1) << (sizeof(Bits) * 8 - 1)));
+			else
+				return Bits(key);
+		}
+	}
+
+	template <bool Construct, class InputIter, class OutputIter, class KeyOf>
+	void _radix_scatter(InputIter first, InputIter last, OutputIter result,
+						size_t* offset, unsigned shift, KeyOf key)
+	{
+		using T = typename iterator_traits<InputIter>::value_type;
+		for (; first != last; ++first)
+		{
+			auto& dest = *(result + offset[(_radix_bits(key(*first)) >> shift) & 0xff]++);
+			if constexpr (Construct)
+				::new(static_cast<void*>(&dest)) T(TinySTL::move(*first));
+			else
+				dest = TinySTL::move(*first);
+		}
+	}
+
+	/*
+		LSD radix sort on the bytes of key(element), stable
+		-one pass computes the histograms of all the bytes at once,
+		 a byte shared by every key (high bytes of small values...) is skipped.
+		-each remaining byte scatters the elements between the range and a
+		 scratch buffer from allocator<T>, the result is moved back if needed.
+		-floats are ordered by their bits : -0.0 < +0.0, NaNs at both ends.
+		-short ranges are insertion sorted on the same order, stable as well.
+	*/
+	template <class RandomIter>
+	void radix_sort(RandomIter first, RandomIter last)
+	{
+		using T = typename iterator_traits<RandomIter>::value_type;
+		radix_sort(first, last, [](const T& x) { return x; });
+	}
+
+	template <class RandomIter, class KeyOf>
+	void radix_sort(RandomIter first, RandomIter last, KeyOf key)
+	{
+		using T    = typename iterator_traits<RandomIter>::value_type;
+		using Bits = decltype(_radix_bits(key(*first)));
+
+		const size_t n = size_t(last - first);
+		if (n < RADIX_SORT_THRESHOLD)
+		{
+			/* insertion sort : stable like the passes, and cheaper than them there */
+			_pdq_insertion_sort(first, last, [&](const T& x, const T& y)
+				{ return _radix_bits(key(x)) < _radix_bits(key(y)); });
+			return;
+		}
+
+		size_t counts[sizeof(Bits)][256] = {};
+		for (RandomIter it = first; it != last; ++it)
+		{
+			Bits bits = _radix_bits(key(*it));
+			for (unsigned d = 0; d != sizeof(Bits); ++d)
+				++counts[d][(bits >> (8 * d)) & 0xff];
+		}
+
+		const Bits sample = _radix_bits(key(*first));
+		allocator<T> alloc;
+		T* buffer = alloc.allocate(n);
+		bool in_buffer = false, constructed = false;
+		for (unsigned d = 0; d != sizeof(Bits); ++d)
+		{
+			size_t* offset = counts[d];
+			if (offset[(sample >> (8 * d)) & 0xff] == n)
+				continue; // every key has the same byte here
+			for (size_t b = 0, sum = 0; b != 256; ++b)
+			{
+				size_t count = offset[b];
+				offset[b] = sum;
+				sum += count;
+			}
+			if (in_buffer)
+				_radix_scatter<false>(buffer, buffer + n, first, offset, 8 * d, key);
+			else if (constructed)
+				_radix_scatter<false>(first, last, buffer, offset, 8 * d, key);
+			else
+				_radix_scatter<true>(first, last, buffer, offset, 8 * d, key);
+			constructed = true;
+			in_buffer = !in_buffer;
+		}
+		if (in_buffer)
+			TinySTL::move(buffer, buffer + n, first);
+		if (constructed)
+			alloc.destroy(buffer, buffer + n);
+		alloc.deallocate(buffer, n);
+	}
+
+	template <class RandomIter, class T, class Compare>
+	void unguarded_linear_insert(RandomIter last, T val, Compare comp)
+	{
+		RandomIter next = last - 1;
+		while (comp(val, *next))
+		{
+			*last = *next;
+			last = next;
+			--next;
+		}
+		*last = val;
+	}
+
+	template <class RandomIter, class T>
+	void linear_insert(RandomIter first, RandomIter last, T*)
+	{
+		linear_insert(first, last, T*(0), less<>());
+	}
+
+	template <class RandomIter, class Compare, class T>
+	void linear_insert(RandomIter first, RandomIter last, Compare comp, T*)
+	{
+		T val = *last;
+		if (comp(val, *first)) 
+		{
+			copy_backward(first, last, last + 1);
+			*first = val;
+		}
+		else unguarded_linear_insert(last, val, comp);
+	}
+
+	template <class RandomIter>
+	void insertion_sort(RandomIter first, RandomIter last)
+	{
+		return insertion_sort(first, last, less<>());
+	}
+
+	template <class RandomIter, class Compare>
+	void insertion_sort(RandomIter first, RandomIter last, Compare comp)
+	{
+		if (first == last)return;
+		for (RandomIter i = first + 1; i != last; ++i)
+			linear_insert(first, i, comp, value_type(first));
+	}
+
+	template <class RandomIter, class Compare>
+	void _introselect(RandomIter begin, RandomIter nth, RandomIter end, Compare comp);
+
+	/*
+		k = mid - first smallest elements sorted into [first, mid)
+		-a small k keeps a max-heap of the best k so far : most elements cost
+		 one comparison against its top, O(n log k) at worst.
+		-a k of PARTIAL_SORT_SELECT_RATIO-th of the range or more is selected
+		 by introselect, then sorted : O(n + k log k).
+	*/
+	template <class RandomIter>
+	void partial_sort(RandomIter first, RandomIter mid, RandomIter last)
+	{
+		partial_sort(first, mid, last, less<>());
+	}
+
+	template <class RandomIter, class Compare>
+	void partial_sort(RandomIter first, RandomIter mid, 
+					  RandomIter last, Compare comp)
+	{
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		using T        = typename iterator_traits<RandomIter>::value_type;
+		const Distance k = mid - first;
+		if (k == 0)
+			return;
+		if (k * PARTIAL_SORT_SELECT_RATIO >= last - first)
+		{
+			_introselect(first, mid - 1, last, comp);
+			TinySTL::sort(first, mid - 1, comp);
+			return;
+		}
+		make_heap(first, mid, comp);
+		for (RandomIter i = mid; i < last; ++i)
+		{
+			if (comp(*i, *first))
+			{
+				T val(TinySTL::move(*i));
+				*i = TinySTL::move(*first);
+				_adjust_heap(first, Distance(0), k, TinySTL::move(val), comp);
+			}
+		}
+		sort_heap(first, mid, comp);
+	}
+
+	/*
+		the smallest min(n, result_last - result_first) elements of the single
+		pass [first, last), sorted into result, through a bounded max-heap as
+		partial_sort. returns the end of the result.
+	*/
+	template <class InputIter, class RandomIter, class Compare>
+	RandomIter partial_sort_copy(InputIter first, InputIter last, 
+								 RandomIter result_first, RandomIter result_last,
+								 Compare comp)
+	{
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		using T        = typename iterator_traits<RandomIter>::value_type;
+		if (result_first == result_last)
+			return result_last;
+		RandomIter result_now = result_first;
+		for (; first != last && result_now != result_last; ++first, ++result_now)
+			*result_now = *first;
 		make_heap(result_first, result_now, comp);
-		while (first != last)
+		for (; first != last; ++first)
 		{
-			if (comp(first, result_first))
-				__adjust_heap(result_first, Distance(0),
-							  Distance(result_now - result_first),
-							  T(*first));
-			++first;
+			if (comp(*first, *result_first))
+				_adjust_heap(result_first, Distance(0), Distance(result_now - result_first),
+							 T(*first), comp);
 		}
-		sort_heap(result_first, result_now);
+		sort_heap(result_first, result_now, comp);
 		return result_now;
 	}
 
+	template <class InputIter, class RandomIter>
+	RandomIter partial_sort_copy(InputIter first, InputIter last,
+								 RandomIter result_first, RandomIter result_last)
+	{
+		return TinySTL::partial_sort_copy(first, last, result_first, result_last, less<>());
+	}
+
 	template <class ForwardIter>
 	bool is_sorted(ForwardIter first, ForwardIter last)
 	{
@@ -1152,35 +2480,152 @@ namespace TinySTL
 		}
 		return true;
 	}
-	/* when last-first<=3, adopt insertion_sort()
-	   when last-first>3 , adopt partition for quicksort (binary) 
-	   comp : must be comparision between T and val_t (though actually the same) */
 
-	template <class RandomIter, class Compare, class T>
-	void _nth_element(RandomIter first, RandomIter nth, RandomIter last, Compare comp, T*)
+	/*
+		partitions around *begin : [< pivot] pivot [>= pivot], returns the pivot
+		position. unlike _pdq_partition_right both scans check their bounds, the
+		pivot needn't come from a median of 3.
+	*/
+	template <class RandomIter, class Compare>
+	RandomIter _select_partition(RandomIter begin, RandomIter end, Compare comp)
 	{
-		while (last - first > 3)
+		using T = typename iterator_traits<RandomIter>::value_type;
+		T pivot(TinySTL::move(*begin));
+		RandomIter first = begin + 1, last = end;
+		for (;;)
 		{
-			RandomIter cut = unguarded_partition(first, last,
-												 T(median(*first,
-														  *(first + (last - first) / 2),
-														  *(last-1), comp)));
-			if (cut <= nth)first = cut;
-			else last = cut;
+			while (first != last && comp(*first, pivot))
+				++first;
+			while (first != last && !comp(*(last - 1), pivot))
+				--last;
+			if (first == last)
+				break;
+			TinySTL::iter_swap(first++, --last);
 		}
-		insertion_sort(first, last, comp);
+
+		RandomIter pivot_pos = first - 1;
+		if (pivot_pos != begin)
+			*begin = TinySTL::move(*pivot_pos);
+		*pivot_pos = TinySTL::move(pivot);
+		return pivot_pos;
 	}
 
+	/* median of the medians of groups of 5 to *begin : 30% of the range at least on either side */
+	template <class RandomIter, class Compare>
+	void _select_median_of_medians(RandomIter begin, RandomIter end, Compare comp)
+	{
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		const Distance groups = (end - begin) / 5;
+		for (Distance g = 0; g != groups; ++g)
+		{
+			RandomIter group = begin + 5 * g;
+			_pdq_insertion_sort(group, group + 5, comp);
+			TinySTL::iter_swap(begin + g, group + 2); // into a group already done
+		}
+		RandomIter mid = begin + groups / 2;
+		_introselect(begin, mid, begin + groups, comp);
+		TinySTL::iter_swap(begin, mid);
+	}
+
+	/*
+		Floyd & Rivest, "Algorithm 489 : SELECT", 1975 : the element of the
+		rank of nth in a sample of about n^(2/3) elements around it, shifted
+		toward the nearer end, to *begin. the pivot then falls close to nth and
+		the next range is small.
+	*/
+	template <class RandomIter, class Compare>
+	void _select_floyd_rivest(RandomIter begin, RandomIter nth, RandomIter end, Compare comp)
+	{
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		const Distance size = end - begin, i = nth - begin;
+		const double n  = double(size);
+		const double z  = std::log(n);
+		const double s  = 0.5 * std::exp(2 * z / 3);
+		const double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (2 * i < size ? -1 : 1);
+		const double left  = double(i) - double(i) * s / n + sd;
+		const double right = double(i) + double(size - i) * s / n + sd;
+		/* nth stays inside the sample whatever the rounding */
+		const Distance l = left < 0 ? 0 : Distance(left) < i ? Distance(left) : i;
+		const Distance r = right >= n ? size : Distance(right) + 1 > i ? Distance(right) + 1 : i + 1;
+		_introselect(begin + l, nth, begin + r, comp);
+		TinySTL::iter_swap(begin, nth);
+	}
+
+	/*
+		introselect : quickselect under a budget of SELECT_WORK_FACTOR * n
+		elements partitioned, median of medians pivots (linear in the worst
+		case) once it is spent
+		-Floyd-Rivest pivots for large ranges, ninther or median of 3 otherwise.
+		-a pivot equal to the one bounding the range on the left means
+		 duplicates : the run of equal elements is split off in one pass
+		 (three-way partition), done if nth falls in it.
+	*/
+	template <class RandomIter, class Compare>
+	void _introselect(RandomIter begin, RandomIter nth, RandomIter end, Compare comp)
+	{
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		Distance work = SELECT_WORK_FACTOR * (end - begin);
+		bool leftmost = true;
+		while (end - begin > SELECT_INSERTION_THRESHOLD)
+		{
+			const Distance size = end - begin, s2 = size / 2;
+			work -= size;
+
+			/* pivot to *begin */
+			if (work < 0)
+				_select_median_of_medians(begin, end, comp);
+			else if (size > SELECT_FLOYD_RIVEST_THRESHOLD)
+				_select_floyd_rivest(begin, nth, end, comp);
+			else if (size > PDQSORT_NINTHER_THRESHOLD)
+			{
+				_pdq_sort3(begin, begin + s2, end - 1, comp);
+				_pdq_sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+				_pdq_sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+				_pdq_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+				TinySTL::iter_swap(begin, begin + s2);
+			}
+			else
+				_pdq_sort3(begin + s2, begin, end - 1, comp);
+
+			/* the pivot equals the one before us : nothing smaller in there */
+			if (!leftmost && !comp(*(begin - 1), *begin))
+			{
+				RandomIter equal_last = _pdq_partition_left(begin, end, comp);
+				if (nth <= equal_last)
+					return;
+				begin = equal_last + 1;
+				continue;
+			}
+
+			RandomIter pivot_pos = _select_partition(begin, end, comp);
+			if (pivot_pos == nth)
+				return;
+			if (nth < pivot_pos)
+				end = pivot_pos;
+			else
+			{
+				begin = pivot_pos + 1;
+				leftmost = false;
+			}
+		}
+		_pdq_insertion_sort(begin, end, comp);
+	}
+
+	/*
+		*nth becomes the element a sort would put there, nothing before it
+		is greater, nothing after it is less. O(n) in the worst case.
+	*/
 	template <class RandomIter>
 	void nth_element(RandomIter first, RandomIter nth, RandomIter last)
 	{
-		nth_element(first, nth, last, less<>(), value_type(first));
+		nth_element(first, nth, last, less<>());
 	}
 
 	template <class RandomIter, class Compare>
 	void nth_element(RandomIter first, RandomIter nth, RandomIter last, Compare comp)
 	{
-		_nth_element(first, nth, last, comp, value_type(first));
+		if (nth != last)
+			_introselect(first, nth, last, comp);
 	}
 
 	template <class ForwardIter, class T>
@@ -1190,8 +2635,8 @@ namespace TinySTL
 	}
 
 	template <class ForwardIter, class T, class Compare>
-	ForwardIter lower_bound(ForwardIter first, ForwardIter last,
-							const T& val, Compare comp)
+	ForwardIter _lower_bound(ForwardIter first, ForwardIter last,
+							 const T& val, Compare comp, forward_iterator_tag)
 	{
 		ForwardIter it;
 		typename iterator_traits<ForwardIter>::difference_type count, step;
@@ -1213,6 +2658,41 @@ namespace TinySTL
 		return first;
 	}
 
+	/*
+		branchless : the range shrinks by half its length whatever the outcome,
+		the comparison only picks the base (a conditional move), so there is
+		no misprediction to pay on random keys. on pointers the two probes of
+		the next round are prefetched, their cache misses overlap this one.
+	*/
+	template <class RandomIter, class T, class Compare>
+	RandomIter _lower_bound(RandomIter first, RandomIter last,
+							const T& val, Compare comp, random_access_iterator_tag)
+	{
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		Distance len = last - first;
+		if (len == 0)
+			return first;
+		while (len > 1)
+		{
+			const Distance half = len / 2;
+			if constexpr (std::is_pointer_v<RandomIter>)
+			{
+				_prefetch(first + (len - half) / 2);
+				_prefetch(first + half + (len - half) / 2);
+			}
+			first = comp(first[half], val) ? first + half : first;
+			len -= half;
+		}
+		return first + Distance(comp(*first, val));
+	}
+
+	template <class ForwardIter, class T, class Compare>
+	ForwardIter lower_bound(ForwardIter first, ForwardIter last,
+							const T& val, Compare comp)
+	{
+		return _lower_bound(first, last, val, comp, iterator_category(first));
+	}
+
 	template <class ForwardIter, class T>
 	ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T& val)
 	{
@@ -1220,8 +2700,8 @@ namespace TinySTL
 	}
 
 	template <class ForwardIter, class T, class Compare>
-	ForwardIter upper_bound(ForwardIter first, ForwardIter last, 
-							const T& val, Compare comp)
+	ForwardIter _upper_bound(ForwardIter first, ForwardIter last,
+							 const T& val, Compare comp, forward_iterator_tag)
 	{
 		ForwardIter it;
 		typename iterator_traits<ForwardIter>::difference_type count, step;
@@ -1242,6 +2722,36 @@ namespace TinySTL
 		return first;
 	}
 
+	/* branchless, see _lower_bound */
+	template <class RandomIter, class T, class Compare>
+	RandomIter _upper_bound(RandomIter first, RandomIter last,
+							const T& val, Compare comp, random_access_iterator_tag)
+	{
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		Distance len = last - first;
+		if (len == 0)
+			return first;
+		while (len > 1)
+		{
+			const Distance half = len / 2;
+			if constexpr (std::is_pointer_v<RandomIter>)
+			{
+				_prefetch(first + (len - half) / 2);
+				_prefetch(first + half + (len - half) / 2);
+			}
+			first = comp(val, first[half]) ? first : first + half;
+			len -= half;
+		}
+		return first + Distance(!comp(val, *first));
+	}
+
+	template <class ForwardIter, class T, class Compare>
+	ForwardIter upper_bound(ForwardIter first, ForwardIter last,
+							const T& val, Compare comp)
+	{
+		return _upper_bound(first, last, val, comp, iterator_category(first));
+	}
+
 	template <class ForwardIter, class T>
 	pair<ForwardIter, ForwardIter>
 	equal_range(ForwardIter first, ForwardIter last, const T& val)
@@ -1292,6 +2802,115 @@ namespace TinySTL
 		}
 	}
 
+	/* rotate(), through the buffer when the shorter side fits in it */
+	template <class BidirectIter, class Distance, class T>
+	BidirectIter _rotate_adaptive(BidirectIter first, BidirectIter mid,
+								  BidirectIter last, Distance len1, Distance len2,
+								  T* buffer, Distance buffer_size)
+	{
+		if (len1 == 0)return last;
+		if (len2 == 0)return first;
+		_buffer_guard<T> saved(buffer);
+		if (len2 <= len1 && len2 <= buffer_size)
+		{
+			saved.move_in(mid, last);
+			TinySTL::move_backward(first, mid, last);
+			return TinySTL::move(saved.first, saved.last, first);
+		}
+		if (len1 <= buffer_size)
+		{
+			saved.move_in(first, mid);
+			first = TinySTL::move(mid, last, first);
+			TinySTL::move(saved.first, saved.last, first);
+			return first;
+		}
+		return TinySTL::rotate(first, mid, last);
+	}
+
+	/*
+		merges sorted [first, mid) and [mid, last) with a buffer of buffer_size elements
+		-a half that fits is moved out and merged back in a single pass,
+		 front to back for the left one, back to front for the right one.
+		-otherwise the longer half is split at its middle, the other one at the
+		 matching bound, the inner quarters are swapped and both sides recurse :
+		 O(n log n) with no buffer at all, the less of it the more rotations.
+	*/
+	template <class BidirectIter, class Distance, class T, class Compare>
+	void adaptive_merge(BidirectIter first, BidirectIter mid, BidirectIter last,
+						Distance len1, Distance len2,
+						T* buffer, Distance buffer_size, Compare comp)
+	{
+		while (len1 != 0 && len2 != 0)
+		{
+			if (len1 <= len2 && len1 <= buffer_size)
+			{
+				_buffer_guard<T> left(buffer);
+				left.move_in(first, mid);
+				T* cur = left.first;
+				while (cur != left.last && mid != last)
+				{
+					if (comp(*mid, *cur))*first = TinySTL::move(*mid++);
+					else *first = TinySTL::move(*cur++);
+					++first;
+				}
+				TinySTL::move(cur, left.last, first);
+				return;
+			}
+			if (len2 <= buffer_size)
+			{
+				_buffer_guard<T> right(buffer);
+				right.move_in(mid, last);
+				T* cur = right.last;
+				while (cur != right.first && mid != first)
+				{
+					--mid;
+					if (comp(*(cur - 1), *mid))*--last = TinySTL::move(*mid);
+					else
+					{
+						++mid;
+						*--last = TinySTL::move(*--cur);
+					}
+				}
+				TinySTL::move_backward(right.first, cur, last);
+				return;
+			}
+			if (len1 + len2 == 2)
+			{
+				if (comp(*mid, *first))
+					TinySTL::iter_swap(first, mid);
+				return;
+			}
+			BidirectIter first_cut = first;
+			BidirectIter second_cut = mid;
+			Distance len11 = 0;
+			Distance len22 = 0;
+			if (len1 > len2)
+			{
+				len11 = len1 / 2;
+				advance(first_cut, len11);
+				second_cut = lower_bound(mid, last, *first_cut, comp);
+				len22 = Distance(distance(mid, second_cut));
+			}
+			else
+			{
+				len22 = len2 / 2;
+				advance(second_cut, len22);
+				first_cut = upper_bound(first, mid, *second_cut, comp);
+				len11 = Distance(distance(first, first_cut));
+			}
+			BidirectIter new_mid = _rotate_adaptive(first_cut, mid, second_cut,
+													Distance(len1 - len11), len22,
+													buffer, buffer_size);
+			adaptive_merge(first, first_cut, new_mid, len11, len22,
+						   buffer, buffer_size, comp);
+			/* the right part in the loop, recursion depth stays O(log n) */
+			first = new_mid;
+			mid   = second_cut;
+			len1 -= len11;
+			len2 -= len22;
+		}
+	}
+
 	template <class BidirectIter, class Distance>
 	void merge_without_buffer(BidirectIter first, BidirectIter mid,
 							  BidirectIter last, Distance len1, Distance len2)
@@ -1304,37 +2923,9 @@ namespace TinySTL
 							  BidirectIter last, Distance len1, Distance len2,
 							  Compare comp) 
 	{
-		if (len1 == 0 || len2 == 0)
-			return;
-		if (len1 + len2 == 2) 
-		{
-			if (comp(*mid, *first))
-				iter_swap(first, mid);
-			return;
-		}
-		BidirectIter first_cut = first;
-		BidirectIter second_cut = mid;
-		Distance len11 = 0;
-		Distance len22 = 0;
-		if (len1 > len2) 
-		{
-			len11 = len1 / 2;
-			advance(first_cut, len11);
-			second_cut = lower_bound(mid, last, *first_cut, comp);
-			distance(mid, second_cut, len22);
-		}
-		else 
-		{
-			len22 = len2 / 2;
-			advance(second_cut, len22);
-			first_cut = upper_bound(first, mid, *second_cut, comp);
-			distance(first, first_cut, len11);
-		}
-		BidirectIter new_mid = rotate(first_cut, mid, second_cut);
-		merge_without_buffer(first, first_cut, new_mid, len11, len22, comp);
-		merge_without_buffer(new_mid, second_cut, last, 
-							 len1 - len11, len2 - len22, 
-							 comp);
+		using T = typename iterator_traits<BidirectIter>::value_type;
+		adaptive_merge(first, mid, last, len1, len2,
+					   static_cast<T*>(nullptr), Distance(0), comp);
 	}
 
 	template <class BidirectIter>
@@ -1342,28 +2933,36 @@ namespace TinySTL
 	{
 		inplace_merge(first, mid, last, less<>());
 	}
-	
 
+	/* only the shorter half is ever buffered, and a partial buffer still helps */
 	template <class BidirectIter, class Compare>
 	void inplace_merge(BidirectIter first, BidirectIter mid,
 					   BidirectIter last, Compare comp) 
 	{
 		if (first == mid || mid == last)return;
 		using Distance = typename iterator_traits<BidirectIter>::difference_type;
-		using Pointer  = typename iterator_traits<BidirectIter>::pointer;
 		using T        = typename iterator_traits<BidirectIter>::value_type;
 		Distance len1 = distance(first, mid);
 		Distance len2 = distance(mid, last);
+		temporary_buffer<T> buf(len1 < len2 ? len1 : len2);
+		adaptive_merge(first, mid, last, len1, len2,
+					   buf.data(), Distance(buf.size()), comp);
+	}
 
-		Pointer ptr = malloc(sizeof(T) * len1);
-		if (ptr == 0)
-			merge_without_buffer(first, mid, last, len1, len2, comp);
-		else
-		{
-			Pointer ptr_end = copy(first, mid, ptr);
-			merge(ptr, ptr_end, mid, last, first, comp);
-		}
-		free(ptr);
+	/* the same, the scratch memory from alloc (polymorphic_allocator over a memory_resource ...) */
+	template <class BidirectIter, class Compare, class Alloc>
+	void inplace_merge(BidirectIter first, BidirectIter mid,
+					   BidirectIter last, Compare comp, const Alloc& alloc)
+	{
+		if (first == mid || mid == last)return;
+		using Distance = typename iterator_traits<BidirectIter>::difference_type;
+		using T        = typename iterator_traits<BidirectIter>::value_type;
+		using A        = typename allocator_traits<Alloc>::template rebind_alloc<T>;
+		Distance len1 = distance(first, mid);
+		Distance len2 = distance(mid, last);
+		temporary_buffer<T, A> buf(len1 < len2 ? len1 : len2, A(alloc));
+		adaptive_merge(first, mid, last, len1, len2,
+					   buf.data(), Distance(buf.size()), comp);
 	}
 
 	template <class InputIter1, class InputIter2>
@@ -1395,11 +2994,78 @@ namespace TinySTL
 		return set_union(first1, last1, first2, last2, result, less<>());
 	}
 
+	template <class Iter1, class Iter2>
+	constexpr bool _both_random_access =
+		std::is_base_of_v<random_access_iterator_tag,
+						  typename iterator_traits<Iter1>::iterator_category> &&
+		std::is_base_of_v<random_access_iterator_tag,
+						  typename iterator_traits<Iter2>::iterator_category>;
+
+	/*
+		set_union / set_intersection with one range much longer than the other :
+		every element of the short range gallops (_gallop_left) through the
+		long one from where the previous stopped, O(m log(n / m)) compares
+		instead of O(n + m). SmallFirst : the short range is the first one,
+		which the elements of equivalent pairs are taken from either way.
+	*/
+	template <bool SmallFirst, class SmallIter, class LargeIter, class OutputIter, class Compare>
+	OutputIter _set_union_gallop(SmallIter small, SmallIter small_last,
+								 LargeIter large, LargeIter large_last,
+								 OutputIter result, Compare comp)
+	{
+		using Distance = typename iterator_traits<LargeIter>::difference_type;
+		for (; small != small_last; ++small, ++result)
+		{
+			if (large == large_last)
+				return copy(small, small_last, result);
+			const Distance k = _gallop_left(*small, large, Distance(large_last - large),
+											Distance(0), comp);
+			result = copy(large, large + k, result);
+			large += k;
+			if (large != large_last && !comp(*small, *large))
+			{
+				*result = SmallFirst ? *small : *large;
+				++large;
+			}
+			else
+				*result = *small;
+		}
+		return copy(large, large_last, result);
+	}
+
+	template <bool SmallFirst, class SmallIter, class LargeIter, class OutputIter, class Compare>
+	OutputIter _set_intersection_gallop(SmallIter small, SmallIter small_last,
+										LargeIter large, LargeIter large_last,
+										OutputIter result, Compare comp)
+	{
+		using Distance = typename iterator_traits<LargeIter>::difference_type;
+		for (; small != small_last && large != large_last; ++small)
+		{
+			large += _gallop_left(*small, large, Distance(large_last - large),
+								  Distance(0), comp);
+			if (large != large_last && !comp(*small, *large))
+			{
+				*result = SmallFirst ? *small : *large;
+				++result;
+				++large;
+			}
+		}
+		return result;
+	}
+
 	template <class InputIter1, class InputIter2, class OutputIter, class Compare>
 	OutputIter set_union(InputIter1 first1, InputIter1 last1,
 						 InputIter2 first2, InputIter2 last2,
 						 OutputIter result, Compare comp)
 	{
+		if constexpr (_both_random_access<InputIter1, InputIter2>)
+		{
+			const size_t len1 = size_t(last1 - first1), len2 = size_t(last2 - first2);
+			if (len1 / SET_GALLOP_RATIO > len2)
+				return _set_union_gallop<false>(first2, last2, first1, last1, result, comp);
+			if (len2 / SET_GALLOP_RATIO > len1)
+				return _set_union_gallop<true>(first1, last1, first2, last2, result, comp);
+		}
 		while (true)
 		{
 			if (first1 == last1) return copy(first2, last2, result);
@@ -1418,11 +3084,36 @@ namespace TinySTL
 		return set_intersection(first1, last1, first2, last2, result, less<>());
 	}
 
+	/*
+		skewed sizes : galloping, see above.
+		uint32_t arrays of similar sizes into a uint32_t* : the block kernel
+		of xsimd.h, as far as it goes (no duplicates), then the usual loop.
+	*/
 	template <class InputIter1, class InputIter2, class OutputIter, class Compare>
 	OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
 								InputIter2 first2, InputIter2 last2,
 								OutputIter result, Compare comp)
 	{
+		if constexpr (_both_random_access<InputIter1, InputIter2>)
+		{
+			const size_t len1 = size_t(last1 - first1), len2 = size_t(last2 - first2);
+			if (len1 / SET_GALLOP_RATIO > len2)
+				return _set_intersection_gallop<false>(first2, last2, first1, last1, result, comp);
+			if (len2 / SET_GALLOP_RATIO > len1)
+				return _set_intersection_gallop<true>(first1, last1, first2, last2, result, comp);
+		}
+		if constexpr (_simd_pointer_to<InputIter1, uint32_t> && _simd_pointer_to<InputIter2, uint32_t> &&
+					  std::is_same_v<OutputIter, uint32_t*> && _is_default_less<Compare, uint32_t>)
+		{
+			if (_simd_worth(first1, last1) && _simd_worth(first2, last2))
+			{
+				const void* stop1;
+				const void* stop2;
+				result += _simd_intersect_u32(first1, last1, first2, last2, result, &stop1, &stop2);
+				first1 = _simd_result<InputIter1>(stop1);
+				first2 = _simd_result<InputIter2>(stop2);
+			}
+		}
 		while (first1 != last1 && first2 != last2)
 		{
 			if (comp(*first1, *first2)) ++first1;
@@ -1506,11 +3197,38 @@ namespace TinySTL
 		return min_element(first, last, less<>());
 	}
 
+	/*
+		the positions of the kernel, or false when it can't serve this range
+		(not worth it, NaN inside) : the scalar loop answers then
+	*/
+	template <class ForwardIter, class Compare>
+	bool _simd_minmax(ForwardIter first, ForwardIter last, bool last_max,
+					  ForwardIter& smallest, ForwardIter& largest)
+	{
+		using T = typename iterator_traits<ForwardIter>::value_type;
+		if constexpr (_simd_pointer<ForwardIter> && _is_default_less<Compare, T>)
+		{
+			const void* lo;
+			const void* hi;
+			if (_simd_worth(first, last) &&
+				_simd_minmax_element(first, last, _simd_kind_of<T>, std::is_unsigned_v<T>,
+									 last_max, &lo, &hi))
+			{
+				smallest = _simd_result<ForwardIter>(lo);
+				largest  = _simd_result<ForwardIter>(hi);
+				return true;
+			}
+		}
+		return false;
+	}
+
 	template <class ForwardIter, class Compare>
 	ForwardIter min_element(ForwardIter first, ForwardIter last, Compare comp)
 	{
 		if (first == last) return last;
-		ForwardIter smallest = first;
+		ForwardIter smallest = first, largest;
+		if (_simd_minmax<ForwardIter, Compare>(first, last, false, smallest, largest))
+			return smallest;
 		while (++first != last)
 		{
 			if (comp(*first, *smallest))
@@ -1529,7 +3247,9 @@ namespace TinySTL
 	ForwardIter max_element(ForwardIter first, ForwardIter last, Compare comp)
 	{
 		if (first == last) return last;
-		ForwardIter largest = first;
+		ForwardIter smallest, largest = first;
+		if (_simd_minmax<ForwardIter, Compare>(first, last, false, smallest, largest))
+			return largest;
 		while (++first != last)
 		{
 			if (comp(*largest, *first))
@@ -1545,18 +3265,21 @@ namespace TinySTL
 		return minmax_element(first, last, less<>());
 	}
 
+	/* the first smallest and the last largest element, (last, last) when empty */
 	template <class ForwardIter, class Compare>
 	pair<ForwardIter, ForwardIter>
 	minmax_element(ForwardIter first, ForwardIter last, Compare comp)
 	{
-		if (first == last) return last;
+		if (first == last) return make_pair(last, last);
 		ForwardIter largest = first;
 		ForwardIter smallest = first;
+		if (_simd_minmax<ForwardIter, Compare>(first, last, true, smallest, largest))
+			return make_pair(smallest, largest);
 		while (++first != last)
 		{
 			if (comp(*first, *smallest))
 				smallest = first;
-			if (*largest < *first)
+			else if (!comp(*first, *largest))
 				largest = first;
 		}
 		return make_pair(smallest, largest);
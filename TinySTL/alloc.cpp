@@ -1,3 +1,5 @@
+#include <mutex>
+
 #include "alloc.h"
 
 namespace TinySTL
@@ -108,4 +110,22 @@ namespace TinySTL
         }
         return ret;
     }
+
+    static std::mutex& pool_lock()
+    {
+        static std::mutex lock;
+        return lock;
+    }
+
+    void* locked_alloc_template::allocate(size_t bytes)
+    {
+        std::lock_guard<std::mutex> guard(pool_lock());
+        return default_alloc_template::allocate(bytes);
+    }
+
+    void locked_alloc_template::deallocate(void* ptr, size_t bytes)
+    {
+        std::lock_guard<std::mutex> guard(pool_lock());
+        default_alloc_template::deallocate(ptr, bytes);
+    }
 }
\ No newline at end of file
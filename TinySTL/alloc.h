@@ -37,6 +37,11 @@ namespace TinySTL
             if (0 == ret)ret = oom_malloc(bytes);
             return ret;
         }
+        /* NOT in SGI : nullptr instead of the oom handler, for callers that can do with less */
+        static void* try_allocate(size_t bytes)
+        {
+            return malloc(bytes);
+        }
         static void deallocate(void* ptr, size_t /* bytes */)
         {
             free(ptr);
@@ -112,6 +117,18 @@ namespace TinySTL
         }
         static void* reallocate(void* ptr, size_t old_sz, size_t new_sz);
     };
+
+    /*
+        default_alloc_template is thread-unsafe,
+        concurrent containers take their nodes from the pool through this one,
+        which holds a global lock around each call (see alloc.cpp)
+    */
+    class locked_alloc_template
+    {
+    public:
+        static void* allocate(size_t bytes);
+        static void deallocate(void* ptr, size_t bytes);
+    };
 }
 
 #endif /* _TINYSTL_ALLOC_H_ */
\ No newline at end of file
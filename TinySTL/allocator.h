@@ -48,11 +48,11 @@ namespace TinySTL
 		}
 		static void deallocate(pointer ptr)
 		{
-			default_alloc_template::deallocate(ptr);
+			default_alloc_template::deallocate(ptr, sizeof(T));
 		}
 		static void deallocate(pointer ptr, size_type n)
 		{
-			if (n != 0)default_alloc_template::deallocate(ptr, n);
+			if (n != 0)default_alloc_template::deallocate(ptr, sizeof(T) * n);
 		}
 		pointer address(reference x)const
 		{
@@ -104,11 +104,11 @@ namespace TinySTL
 		}
 		static void deallocate(T* ptr)
 		{
-			Alloc::deallocate(ptr);
+			Alloc::deallocate(ptr, sizeof(T));
 		}
 		static void deallocate(T* ptr, size_t n)
 		{
-			if (n != 0)Alloc::deallocate(ptr, n);
+			if (n != 0)Alloc::deallocate(ptr, sizeof(T) * n);
 		}
 	};
 
@@ -0,0 +1,652 @@
+#pragma once
+#ifndef _TINYSTL_CONCURRENT_QUEUE_H_
+#define _TINYSTL_CONCURRENT_QUEUE_H_
+
+#include <atomic>      // std::atomic
+#include <cstdint>     // uintptr_t
+#include <new>         // placement new
+#include <type_traits> // std::aligned_storage_t
+
+#include "epoch.h"
+#include "iterator.h"
+#include "memory.h"
+#include "polymorphic_allocator.h"
+#include "utility.h"
+#include "xatomic.h"
+
+namespace TinySTL
+{
+	/*
+		bounded multi-producer/multi-consumer queue (D. Vyukov)
+		-every cell carries a sequence number telling which ticket it waits for:
+		   seq == pos     : empty, the producer holding ticket pos may write it
+		   seq == pos + 1 : full,  the consumer holding ticket pos may read it
+		-producers only contend on enqueue_pos, consumers on dequeue_pos,
+		 an uncontended operation costs a single CAS.
+		-bulk operations claim a run of consecutive ready cells with one CAS.
+		-push()/pop() spin on try_push()/try_pop() for a while, then park on a futex.
+		-capacity is rounded up to a power of 2.
+	*/
+	template <class T, class Alloc = polymorphic_allocator<T> >
+	class concurrent_bounded_queue
+	{
+	public:
+		using value_type      = T;
+		using allocator_type  = Alloc;
+		using size_type       = size_t;
+		using difference_type = ptrdiff_t;
+		using reference       = T&;
+		using const_reference = const T&;
+
+	protected:
+		struct cell
+		{
+			std::atomic<size_type>                        sequence;
+			std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+
+			T* data() { return reinterpret_cast<T*>(&storage); }
+		};
+
+		using cell_allocator_type =
+			typename allocator_traits<Alloc>::template rebind_alloc<cell>;
+		using cell_alloc_traits   = allocator_traits<cell_allocator_type>;
+
+		/* offset between a ticket and the sequence of a cell ready for it */
+		enum { PUSH_READY = 0, POP_READY = 1 };
+
+	protected:
+		cell*               buffer;
+		size_type           mask;
+		cell_allocator_type cell_allocator;
+
+		alignas(CACHE_LINE_SIZE) std::atomic<size_type> enqueue_pos;
+		alignas(CACHE_LINE_SIZE) std::atomic<size_type> dequeue_pos;
+		alignas(CACHE_LINE_SIZE) _event_count           not_empty;
+		alignas(CACHE_LINE_SIZE) _event_count           not_full;
+
+	public:
+		explicit concurrent_bounded_queue(size_type cap,
+										  const Alloc& alloc = Alloc())
+			:cell_allocator(alloc), enqueue_pos(0), dequeue_pos(0)
+		{
+			size_type n = 2;
+			while (n < cap)
+				n <<= 1;
+			mask   = n - 1;
+			buffer = cell_alloc_traits::allocate(cell_allocator, n);
+			for (size_type i = 0; i != n; ++i)
+			{
+				::new(static_cast<void*>(buffer + i)) cell;
+				buffer[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		concurrent_bounded_queue(const concurrent_bounded_queue&) = delete;
+		concurrent_bounded_queue& operator=(const concurrent_bounded_queue&) = delete;
+
+		~concurrent_bounded_queue()
+		{
+			size_type last = enqueue_pos.load(std::memory_order_relaxed);
+			for (size_type pos = dequeue_pos.load(std::memory_order_relaxed);
+				 pos != last; ++pos)
+				buffer[pos & mask].data()->~T();
+			cell_alloc_traits::deallocate(cell_allocator, buffer, mask + 1);
+		}
+
+		allocator_type get_allocator() const
+			{ return allocator_type(cell_allocator); }
+
+		size_type capacity() const noexcept
+			{ return mask + 1; }
+
+		/* only a snapshot while other threads are working on the queue */
+		size_type size_approx() const noexcept
+		{
+			size_type t = enqueue_pos.load(std::memory_order_relaxed);
+			size_type s = dequeue_pos.load(std::memory_order_relaxed);
+			return difference_type(t - s) > 0 ? t - s : 0;
+		}
+
+		bool empty_approx() const noexcept
+			{ return size_approx() == 0; }
+
+	public: // non-blocking
+		bool try_push(const T& val)
+			{ return try_emplace(val); }
+
+		bool try_push(T&& val)
+			{ return try_emplace(TinySTL::move(val)); }
+
+		/*
+			a claimed cell can't be given back, so T is built before claiming
+			unless its constructor can't throw
+		*/
+		template <class... Args>
+		bool try_emplace(Args&&... args)
+		{
+			if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+				return _try_enqueue(TinySTL::forward<Args>(args)...);
+			else
+			{
+				T tmp(TinySTL::forward<Args>(args)...);
+				return _try_enqueue(TinySTL::move(tmp));
+			}
+		}
+
+		/* a throwing move assignment loses the element, the cell is given back all the same */
+		bool try_pop(T& result)
+		{
+			size_type pos;
+			if (_claim(dequeue_pos, 1, POP_READY, pos) == 0)
+				return false;
+			try
+			{
+				result = TinySTL::move(*buffer[pos & mask].data());
+			}
+			catch (...)
+			{
+				_release_claimed(pos, 1);
+				throw;
+			}
+			_release_claimed(pos, 1);
+			return true;
+		}
+
+		/* pushes as many of [first, last) as there is room for, returns the first one left */
+		template <class ForwardIter>
+		ForwardIter try_push_range(ForwardIter first, ForwardIter last)
+		{
+			using Ref = typename iterator_traits<ForwardIter>::reference;
+			if constexpr (std::is_nothrow_constructible_v<T, Ref>)
+			{
+				size_type pos;
+				size_type n = _claim(enqueue_pos, size_type(distance(first, last)),
+									 PUSH_READY, pos);
+				return _fill_claimed(first, pos, n);
+			}
+			else
+			{
+				while (first != last && try_emplace(*first))
+					++first;
+				return first;
+			}
+		}
+
+		/* pops at most n elements into result, returns (count, end of output) */
+		template <class OutputIter>
+		pair<size_type, OutputIter> try_pop_n(size_type n, OutputIter result)
+		{
+			size_type pos;
+			n = _claim(dequeue_pos, n, POP_READY, pos);
+			result = _drain_claimed(result, pos, n);
+			return pair<size_type, OutputIter>(n, result);
+		}
+
+	public: // blocking
+		void push(const T& val)
+			{ emplace(val); }
+
+		void push(T&& val)
+			{ emplace(TinySTL::move(val)); }
+
+		template <class... Args>
+		void emplace(Args&&... args)
+		{
+			if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+				_wait_until(not_full, [&]
+					{ return _try_enqueue(TinySTL::forward<Args>(args)...); });
+			else
+			{
+				T tmp(TinySTL::forward<Args>(args)...);
+				_wait_until(not_full, [&] { return _try_enqueue(TinySTL::move(tmp)); });
+			}
+		}
+
+		void pop(T& result)
+		{
+			_wait_until(not_empty, [&] { return try_pop(result); });
+		}
+
+		template <class ForwardIter>
+		void push_range(ForwardIter first, ForwardIter last)
+		{
+			while (first != last)
+			{
+				_wait_until(not_full, [&]
+				{
+					ForwardIter next = try_push_range(first, last);
+					bool ret = (next != first);
+					first = next;
+					return ret;
+				});
+			}
+		}
+
+		/* returns once exactly n elements have been popped */
+		template <class OutputIter>
+		OutputIter pop_n(size_type n, OutputIter result)
+		{
+			while (n != 0)
+			{
+				_wait_until(not_empty, [&]
+				{
+					pair<size_type, OutputIter> now = try_pop_n(n, result);
+					n     -= now.first;
+					result = now.second;
+					return now.first != 0;
+				});
+			}
+			return result;
+		}
+
+	protected:
+		/*
+			claims up to n consecutive cells ready for a push/pop starting at pos,
+			returns how many were claimed (0 : full/empty)
+			-cell pos+i is only handed over by the holder of ticket pos+i,
+			 so cells seen ready stay ready until our CAS on the counter
+		*/
+		size_type _claim(std::atomic<size_type>& counter, size_type n,
+						 size_type ready, size_type& pos)
+		{
+			if (n == 0)return 0;
+			pos = counter.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				size_type k = 0;
+				for (; k != n; ++k)
+				{
+					size_type seq = buffer[(pos + k) & mask].sequence.load(
+										std::memory_order_acquire);
+					if (seq != pos + k + ready)
+					{
+						if (k == 0 && difference_type(seq - (pos + ready)) < 0)
+							return 0;
+						break;
+					}
+				}
+				if (k == 0)
+					pos = counter.load(std::memory_order_relaxed);
+				else if (counter.compare_exchange_weak(pos, pos + k,
+													   std::memory_order_relaxed))
+					return k;
+			}
+		}
+
+		template <class... Args>
+		bool _try_enqueue(Args&&... args)
+		{
+			size_type pos;
+			if (_claim(enqueue_pos, 1, PUSH_READY, pos) == 0)
+				return false;
+			cell* c = buffer + (pos & mask);
+			::new(static_cast<void*>(c->data())) T(TinySTL::forward<Args>(args)...);
+			c->sequence.store(pos + 1, std::memory_order_release);
+			not_empty.notify_one();
+			return true;
+		}
+
+		template <class ForwardIter>
+		ForwardIter _fill_claimed(ForwardIter first, size_type pos, size_type n)
+		{
+			if (n == 0)return first;
+			for (size_type i = 0; i != n; ++i, ++first)
+				::new(static_cast<void*>(buffer[(pos + i) & mask].data())) T(*first);
+			for (size_type i = 0; i != n; ++i)
+				buffer[(pos + i) & mask].sequence.store(pos + i + 1,
+														std::memory_order_release);
+			if (n == 1) not_empty.notify_one();
+			else not_empty.notify_all();
+			return first;
+		}
+
+		/* the elements left are lost if a move assignment throws, the cells never */
+		template <class OutputIter>
+		OutputIter _drain_claimed(OutputIter result, size_type pos, size_type n)
+		{
+			if (n == 0)return result;
+			try
+			{
+				for (size_type i = 0; i != n; ++i, ++result)
+					*result = TinySTL::move(*buffer[(pos + i) & mask].data());
+			}
+			catch (...)
+			{
+				_release_claimed(pos, n);
+				throw;
+			}
+			_release_claimed(pos, n);
+			return result;
+		}
+
+		/* destroys the elements of the n cells claimed from pos and hands the cells to the producers */
+		void _release_claimed(size_type pos, size_type n)
+		{
+			for (size_type i = 0; i != n; ++i)
+			{
+				cell* c = buffer + ((pos + i) & mask);
+				c->data()->~T();
+				c->sequence.store(pos + i + mask + 1, std::memory_order_release);
+			}
+			if (n == 1) not_full.notify_one();
+			else not_full.notify_all();
+		}
+
+		/* spin a little, then sleep on ev until op() succeeds */
+		template <class Operation>
+		static void _wait_until(_event_count& ev, Operation op)
+		{
+			for (unsigned spin = 0; spin != SPIN_LIMIT; ++spin)
+			{
+				if (op())return;
+				_cpu_relax();
+			}
+			for (;;)
+			{
+				uint32_t key = ev.prepare_wait();
+				if (op())
+				{
+					ev.cancel_wait();
+					return;
+				}
+				ev.wait(key);
+			}
+		}
+	};
+
+	/*
+		unbounded multi-producer/multi-consumer queue
+		(FAA array queue, P. Ramalhete & A. Correia)
+		-like deque, elements live in fixed-size blocks, here linked into a list.
+		-inside a block, producers and consumers take cells with a fetch_add
+		 on the block's own indexes, so an operation costs about as much as in
+		 the bounded ring; a new block is only linked when the tail one is used up.
+		-a consumer overtaking a slow producer marks the cell taken, the producer
+		 then moves its element back out and retries with another cell.
+		-consumed blocks are retired through the epoch domain (epoch.h) and
+		 given back to the allocator once no thread can still read them,
+		 so the allocator must be usable from any thread.
+	*/
+	template <class T, class Alloc = polymorphic_allocator<T> >
+	class concurrent_queue
+	{
+	public:
+		using value_type      = T;
+		using allocator_type  = Alloc;
+		using size_type       = size_t;
+		using difference_type = ptrdiff_t;
+		using reference       = T&;
+		using const_reference = const T&;
+
+	protected:
+		enum : unsigned char { CELL_EMPTY, CELL_FULL, CELL_TAKEN };
+
+		/* a block spans about 512 bytes of elements like deque, but never less than 32 cells */
+		static constexpr size_type block_size =
+			sizeof(T) < 512 / 32 ? 512 / sizeof(T) : 32;
+
+		struct cell
+		{
+			std::atomic<unsigned char>                    state;
+			std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+
+			T* data() { return reinterpret_cast<T*>(&storage); }
+		};
+
+		/* blocks are carved out of bytes : allocators need not honour alignof(block) */
+		using raw_allocator_type =
+			typename allocator_traits<Alloc>::template rebind_alloc<unsigned char>;
+		using raw_alloc_traits   = allocator_traits<raw_allocator_type>;
+
+		struct block :_epoch_node
+		{
+			alignas(CACHE_LINE_SIZE) std::atomic<size_type> enqueue_idx;
+			alignas(CACHE_LINE_SIZE) std::atomic<size_type> dequeue_idx;
+			alignas(CACHE_LINE_SIZE) std::atomic<block*>    next;
+			raw_allocator_type                              allocator;
+			unsigned char*                                  raw; // what allocator gave
+			cell                                            cells[block_size];
+
+			block(const raw_allocator_type& alloc, unsigned char* r)
+				:enqueue_idx(0), dequeue_idx(0), next(nullptr), allocator(alloc), raw(r)
+			{
+				for (size_type i = 0; i != block_size; ++i)
+					cells[i].state.store(CELL_EMPTY, std::memory_order_relaxed);
+			}
+		};
+
+		static constexpr size_type block_bytes = sizeof(block) + alignof(block) - 1;
+
+	protected:
+		raw_allocator_type                           raw_allocator;
+		alignas(CACHE_LINE_SIZE) std::atomic<block*> head;
+		alignas(CACHE_LINE_SIZE) std::atomic<block*> tail;
+		alignas(CACHE_LINE_SIZE) _event_count        not_empty;
+
+	public:
+		explicit concurrent_queue(const Alloc& alloc = Alloc())
+			:raw_allocator(alloc)
+		{
+			block* b = _new_block();
+			head.store(b, std::memory_order_relaxed);
+			tail.store(b, std::memory_order_relaxed);
+		}
+
+		concurrent_queue(const concurrent_queue&) = delete;
+		concurrent_queue& operator=(const concurrent_queue&) = delete;
+
+		/* no other thread may use the queue any more, blocks still linked are freed at once */
+		~concurrent_queue()
+		{
+			block* b = head.load(std::memory_order_relaxed);
+			while (b)
+			{
+				block* next = b->next.load(std::memory_order_relaxed);
+				for (size_type i = 0; i != block_size; ++i)
+				{
+					if (b->cells[i].state.load(std::memory_order_relaxed) == CELL_FULL)
+						b->cells[i].data()->~T();
+				}
+				_reclaim(b);
+				b = next;
+			}
+		}
+
+		allocator_type get_allocator() const
+			{ return allocator_type(raw_allocator); }
+
+		/* only a snapshot while other threads are working on the queue */
+		bool empty_approx() const
+		{
+			epoch_guard guard;
+			block* h = head.load(std::memory_order_acquire);
+			return h->dequeue_idx.load(std::memory_order_relaxed) >=
+				   h->enqueue_idx.load(std::memory_order_relaxed) &&
+				   h->next.load(std::memory_order_relaxed) == nullptr;
+		}
+
+	public:
+		void push(const T& val)
+			{ emplace(val); }
+
+		void push(T&& val)
+			{ emplace(TinySTL::move(val)); }
+
+		/* never blocks, never fails (except for bad_alloc) */
+		template <class... Args>
+		void emplace(Args&&... args)
+		{
+			T tmp(TinySTL::forward<Args>(args)...);
+			_enqueue(tmp);
+			not_empty.notify_one();
+		}
+
+		template <class InputIter>
+		void push_range(InputIter first, InputIter last)
+		{
+			if (first == last)return;
+			for (; first != last; ++first)
+			{
+				T tmp(*first);
+				_enqueue(tmp);
+			}
+			not_empty.notify_all();
+		}
+
+		bool try_pop(T& result)
+			{ return _try_pop([&result](T& x) { result = TinySTL::move(x); }); }
+
+		/* pops at most n elements into result, returns (count, end of output) */
+		template <class OutputIter>
+		pair<size_type, OutputIter> try_pop_n(size_type n, OutputIter result)
+		{
+			size_type k = 0;
+			for (; k != n && _try_pop([&result](T& x) { *result = TinySTL::move(x); }); ++k)
+				++result;
+			return pair<size_type, OutputIter>(k, result);
+		}
+
+		/* blocks until an element is available */
+		void pop(T& result)
+		{
+			for (unsigned spin = 0; spin != SPIN_LIMIT; ++spin)
+			{
+				if (try_pop(result))return;
+				_cpu_relax();
+			}
+			for (;;)
+			{
+				uint32_t key = not_empty.prepare_wait();
+				if (try_pop(result))
+				{
+					not_empty.cancel_wait();
+					return;
+				}
+				not_empty.wait(key);
+			}
+		}
+
+	protected:
+		/* take(element) moves the popped element where it goes */
+		template <class Take>
+		bool _try_pop(Take take)
+		{
+			epoch_guard guard;
+			for (;;)
+			{
+				block* h = head.load(std::memory_order_acquire);
+				if (h->dequeue_idx.load(std::memory_order_relaxed) >=
+					h->enqueue_idx.load(std::memory_order_acquire) &&
+					h->next.load(std::memory_order_acquire) == nullptr)
+					return false;
+				size_type idx = h->dequeue_idx.fetch_add(1, std::memory_order_relaxed);
+				if (idx >= block_size)
+				{
+					block* next = h->next.load(std::memory_order_acquire);
+					if (next == nullptr)
+						return false;
+					/*
+						the producer linking next may not have moved tail yet : help
+						it (Michael-Scott), h is only retired once neither head nor
+						tail reach it, so threads pinned later can't load it
+					*/
+					block* t = h;
+					if (tail.load(std::memory_order_acquire) == h)
+						tail.compare_exchange_strong(t, next, std::memory_order_release,
+													 std::memory_order_relaxed);
+					if (head.compare_exchange_strong(h, next, std::memory_order_release,
+													 std::memory_order_relaxed))
+						epoch_retire(h, &_reclaim_node);
+					continue;
+				}
+				cell& c = h->cells[idx];
+				if (c.state.exchange(CELL_TAKEN, std::memory_order_acq_rel) == CELL_FULL)
+				{
+					/* a taken cell is never destroyed by the queue : do it however the move ends */
+					try
+					{
+						take(*c.data());
+					}
+					catch (...)
+					{
+						c.data()->~T();
+						throw;
+					}
+					c.data()->~T();
+					return true;
+				}
+				/* the producer of this cell is late, it will retry elsewhere */
+			}
+		}
+
+		/* tmp is moved into a cell, or back into tmp when a consumer gave the cell up */
+		void _enqueue(T& tmp)
+		{
+			epoch_guard guard;
+			for (;;)
+			{
+				block* t = tail.load(std::memory_order_acquire);
+				size_type idx = t->enqueue_idx.fetch_add(1, std::memory_order_relaxed);
+				if (idx < block_size)
+				{
+					cell& c = t->cells[idx];
+					::new(static_cast<void*>(c.data())) T(TinySTL::move(tmp));
+					unsigned char expected = CELL_EMPTY;
+					if (c.state.compare_exchange_strong(expected, CELL_FULL,
+														std::memory_order_release,
+														std::memory_order_relaxed))
+						return;
+					tmp = TinySTL::move(*c.data());
+					c.data()->~T();
+					continue;
+				}
+				if (t != tail.load(std::memory_order_acquire))
+					continue;
+				block* next = t->next.load(std::memory_order_acquire);
+				if (next)
+				{
+					tail.compare_exchange_strong(t, next, std::memory_order_release,
+												 std::memory_order_relaxed);
+					continue;
+				}
+				/* the tail block is used up, link a new one already holding tmp */
+				block* b = _new_block();
+				::new(static_cast<void*>(b->cells[0].data())) T(TinySTL::move(tmp));
+				b->cells[0].state.store(CELL_FULL, std::memory_order_relaxed);
+				b->enqueue_idx.store(1, std::memory_order_relaxed);
+				block* expected = nullptr;
+				if (t->next.compare_exchange_strong(expected, b, std::memory_order_release,
+													std::memory_order_relaxed))
+				{
+					tail.compare_exchange_strong(t, b, std::memory_order_release,
+												 std::memory_order_relaxed);
+					return;
+				}
+				tmp = TinySTL::move(*b->cells[0].data());
+				b->cells[0].data()->~T();
+				_reclaim(b);
+			}
+		}
+
+		block* _new_block()
+		{
+			unsigned char* raw = raw_alloc_traits::allocate(raw_allocator, block_bytes);
+			const uintptr_t misalign = reinterpret_cast<uintptr_t>(raw) % alignof(block);
+			unsigned char* p = raw + (misalign ? alignof(block) - misalign : 0);
+			return ::new(static_cast<void*>(p)) block(raw_allocator, raw);
+		}
+
+		static void _reclaim(block* b)
+		{
+			raw_allocator_type alloc(b->allocator);
+			unsigned char* raw = b->raw;
+			b->~block();
+			raw_alloc_traits::deallocate(alloc, raw, block_bytes);
+		}
+
+		static void _reclaim_node(_epoch_node* node)
+			{ _reclaim(static_cast<block*>(node)); }
+	};
+}
+
+#endif /* _TINYSTL_CONCURRENT_QUEUE_H_ */
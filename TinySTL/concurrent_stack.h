@@ -0,0 +1,211 @@
+#pragma once
+#ifndef _TINYSTL_CONCURRENT_STACK_H_
+#define _TINYSTL_CONCURRENT_STACK_H_
+
+#include <atomic>      // std::atomic
+#include <cstddef>     // size_t
+#include <new>         // placement new
+#include <type_traits> // std::aligned_storage_t
+
+#include "utility.h"
+#include "xatomic.h"
+
+namespace TinySTL
+{
+	/* nodes a concurrent_stack allocates at once when its free list runs dry */
+	enum { CONCURRENT_STACK_SLAB = 64 };
+
+	/*
+		lock-free LIFO stack (R.K. Treiber)
+		-head is a tagged pointer (xatomic.h), every successful CAS bumps the tag,
+		 so a node popped and pushed back between our load and our CAS (ABA)
+		 makes the CAS fail.
+		-popped nodes go to a free list of the stack (also a tagged Treiber stack)
+		 instead of back to the allocator : node memory stays valid while the
+		 stack lives, so reading head->next of a node just taken by another
+		 thread is harmless, and the steady state allocates nothing.
+		-an empty free list is refilled with a slab of CONCURRENT_STACK_SLAB
+		 nodes from operator new (no lock of ours on the way), the slabs are
+		 freed in the destructor.
+	*/
+	template <class T>
+	class concurrent_stack
+	{
+	public:
+		using value_type      = T;
+		using size_type       = size_t;
+		using reference       = T&;
+		using const_reference = const T&;
+
+	protected:
+		struct node
+		{
+			std::atomic<node*>                            next;
+			std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+
+			T* data() { return reinterpret_cast<T*>(&storage); }
+		};
+
+		struct slab
+		{
+			slab* next;
+			node  nodes[CONCURRENT_STACK_SLAB];
+		};
+
+		using tagged = _tagged_ptr<node>;
+		using word   = typename tagged::word;
+
+	protected:
+		alignas(CACHE_LINE_SIZE) std::atomic<word> head;
+		alignas(CACHE_LINE_SIZE) std::atomic<word> free_head;
+		std::atomic<slab*>                         slabs; // only ever pushed to
+
+	public:
+		concurrent_stack() :head(0), free_head(0), slabs(nullptr) {}
+
+		concurrent_stack(const concurrent_stack&) = delete;
+		concurrent_stack& operator=(const concurrent_stack&) = delete;
+
+		~concurrent_stack()
+		{
+			for (node* n = tagged::ptr(head.load(std::memory_order_relaxed)); n; )
+			{
+				node* next = n->next.load(std::memory_order_relaxed);
+				n->data()->~T();
+				n = next;
+			}
+			for (slab* s = slabs.load(std::memory_order_relaxed); s; )
+			{
+				slab* next = s->next;
+				delete s;
+				s = next;
+			}
+		}
+
+		/* only a snapshot while other threads are working on the stack */
+		bool empty_approx() const noexcept
+			{ return tagged::ptr(head.load(std::memory_order_relaxed)) == nullptr; }
+
+	public:
+		void push(const T& val)
+			{ emplace(val); }
+
+		void push(T&& val)
+			{ emplace(TinySTL::move(val)); }
+
+		template <class... Args>
+		void emplace(Args&&... args)
+		{
+			node* n = _get_node();
+			try
+			{
+				::new(static_cast<void*>(n->data())) T(TinySTL::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				_push_chain(free_head, n, n);
+				throw;
+			}
+			_push_chain(head, n, n);
+		}
+
+		/* links the whole range first, then publishes it with a single CAS */
+		template <class InputIter>
+		void push_range(InputIter first, InputIter last)
+		{
+			if (first == last)return;
+			node* top = nullptr;
+			node* bottom = nullptr;
+			try
+			{
+				for (; first != last; ++first)
+				{
+					node* n = _get_node();
+					try
+					{
+						::new(static_cast<void*>(n->data())) T(*first);
+					}
+					catch (...)
+					{
+						_push_chain(free_head, n, n);
+						throw;
+					}
+					n->next.store(top, std::memory_order_relaxed);
+					top = n;
+					if (!bottom)bottom = n;
+				}
+			}
+			catch (...)
+			{
+				for (node* n = top; n; n = n->next.load(std::memory_order_relaxed))
+					n->data()->~T();
+				if (top)_push_chain(free_head, top, bottom);
+				throw;
+			}
+			_push_chain(head, top, bottom);
+		}
+
+		bool try_pop(T& result)
+		{
+			node* n = _pop_node(head);
+			if (!n)return false;
+			try
+			{
+				result = TinySTL::move(*n->data());
+			}
+			catch (...)
+			{
+				_push_chain(head, n, n); // the element stays in the stack
+				throw;
+			}
+			n->data()->~T();
+			_push_chain(free_head, n, n);
+			return true;
+		}
+
+	protected:
+		/* [top, bottom] is already linked through next */
+		static void _push_chain(std::atomic<word>& list, node* top, node* bottom)
+		{
+			word w = list.load(std::memory_order_relaxed);
+			do
+				bottom->next.store(tagged::ptr(w), std::memory_order_relaxed);
+			while (!list.compare_exchange_weak(w, tagged::pack(top, tagged::tag(w) + 1),
+											   std::memory_order_release,
+											   std::memory_order_relaxed));
+		}
+
+		static node* _pop_node(std::atomic<word>& list)
+		{
+			word w = list.load(std::memory_order_acquire);
+			for (;;)
+			{
+				node* n = tagged::ptr(w);
+				if (!n)return nullptr;
+				node* next = n->next.load(std::memory_order_relaxed);
+				if (list.compare_exchange_weak(w, tagged::pack(next, tagged::tag(w) + 1),
+											   std::memory_order_acquire,
+											   std::memory_order_acquire))
+					return n;
+			}
+		}
+
+		/* from the free list, else the first node of a new slab, the others going to the free list */
+		node* _get_node()
+		{
+			node* n = _pop_node(free_head);
+			if (n)return n;
+			slab* s = new slab;
+			s->next = slabs.load(std::memory_order_relaxed);
+			while (!slabs.compare_exchange_weak(s->next, s, std::memory_order_relaxed))
+				;
+			node* nodes = s->nodes;
+			for (size_t i = 1; i + 1 < CONCURRENT_STACK_SLAB; ++i)
+				nodes[i].next.store(nodes + i + 1, std::memory_order_relaxed);
+			_push_chain(free_head, nodes + 1, nodes + CONCURRENT_STACK_SLAB - 1);
+			return nodes;
+		}
+	};
+}
+
+#endif /* _TINYSTL_CONCURRENT_STACK_H_ */
@@ -112,7 +112,7 @@ namespace TinySTL
 			{
 				difference_type node_offset = //floor
 					offset > 0 ? offset / difference_type(buffer_size())
-						:difference_type((-offset - 1) / buffer_size() - 1);
+						:-difference_type((-offset - 1) / buffer_size()) - 1;
 				_set_node(node + node_offset);
 				cur = first + (offset - node_offset * difference_type(buffer_size()));
 			}
@@ -363,6 +363,21 @@ namespace TinySTL
 			}
 		}
 
+		/*
+			room in the map for new_cap elements from begin() on, so that
+			appending up to there never reallocates the map.
+			buffers are still allocated as elements arrive : anything past
+			finish.node would be lost to the destructor.
+		*/
+		void reserve(size_type new_cap)
+		{
+			if (new_cap <= size())return;
+			size_type vac = finish.last - finish.cur - 1;
+			size_type more = new_cap - size();
+			if (more > vac)
+				_reserve_map_at_back((more - vac + buffer_size() - 1) / buffer_size());
+		}
+
 		void clear();
 
 		iterator insert(iterator pos, const T& val)
@@ -449,8 +464,14 @@ namespace TinySTL
 
 		void pop_back()
 		{
-			--finish;
-			alloc_traits::destroy(data_allocator, finish);
+			if (finish.cur == finish.first) // release the emptied buffer
+			{
+				alloc_traits::deallocate(data_allocator, finish.first, buffer_size());
+				finish._set_node(finish.node - 1);
+				finish.cur = finish.last;
+			}
+			--finish.cur;
+			alloc_traits::destroy(data_allocator, finish.cur);
 		}
 
 		void push_front(const T& val)
@@ -472,8 +493,13 @@ namespace TinySTL
 
 		void pop_front()
 		{
-			alloc_traits::destroy(data_allocator, start);
-			++start;
+			alloc_traits::destroy(data_allocator, start.cur);
+			if (++start.cur == start.last) // release the emptied buffer
+			{
+				alloc_traits::deallocate(data_allocator, start.first, buffer_size());
+				start._set_node(start.node + 1);
+				start.cur = start.first;
+			}
 		}
 
 		void resize(size_type new_size, T val = T())
@@ -0,0 +1,176 @@
+#include <atomic>
+#include <mutex>
+
+#include "epoch.h"
+
+namespace TinySTL
+{
+	namespace
+	{
+		const uint64_t QUIESCENT = ~uint64_t(0);
+
+		/* one per thread, recycled when threads exit, never freed */
+		struct epoch_record
+		{
+			std::atomic<uint64_t> local_epoch;
+			std::atomic<bool>     in_use;
+			epoch_record*         next;
+			unsigned              nesting;
+			_epoch_node*          limbo; // retired by this thread, newest first
+
+			epoch_record()
+				:local_epoch(QUIESCENT), in_use(true), next(nullptr),
+				 nesting(0), limbo(nullptr) {}
+		};
+
+		std::atomic<uint64_t>      global_epoch(0);
+		std::atomic<epoch_record*> records(nullptr);
+
+		/* left behind by exited threads, reclaimed by whoever collects next */
+		std::mutex                 orphan_lock;
+		std::atomic<_epoch_node*>  orphans(nullptr);
+
+		epoch_record* acquire_record()
+		{
+			for (epoch_record* r = records.load(std::memory_order_acquire);
+				 r; r = r->next)
+			{
+				bool expected = false;
+				if (!r->in_use.load(std::memory_order_relaxed) &&
+					r->in_use.compare_exchange_strong(expected, true,
+													  std::memory_order_acquire))
+					return r;
+			}
+			epoch_record* r = new epoch_record;
+			epoch_record* head = records.load(std::memory_order_relaxed);
+			do
+				r->next = head;
+			while (!records.compare_exchange_weak(head, r,
+												  std::memory_order_release,
+												  std::memory_order_relaxed));
+			return r;
+		}
+
+		void try_advance()
+		{
+			uint64_t now = global_epoch.load(std::memory_order_seq_cst);
+			for (epoch_record* r = records.load(std::memory_order_acquire);
+				 r; r = r->next)
+			{
+				uint64_t e = r->local_epoch.load(std::memory_order_acquire);
+				if (e != QUIESCENT && e != now)
+					return;
+			}
+			global_epoch.compare_exchange_strong(now, now + 1,
+												 std::memory_order_seq_cst);
+		}
+
+		/* reclaims the safe tail of a list (newest first), returns what is left */
+		_epoch_node* reclaim_list(_epoch_node* list)
+		{
+			uint64_t now = global_epoch.load(std::memory_order_seq_cst);
+			_epoch_node** link = &list;
+			while (*link && (*link)->retired_epoch + 2 > now)
+				link = &(*link)->retired_next;
+			_epoch_node* dead = *link;
+			*link = nullptr;
+			while (dead)
+			{
+				_epoch_node* next = dead->retired_next;
+				dead->reclaim(dead);
+				dead = next;
+			}
+			return list;
+		}
+
+		/* merges two lists (newest first) into one, still newest first */
+		_epoch_node* merge_lists(_epoch_node* x, _epoch_node* y)
+		{
+			_epoch_node* list = nullptr;
+			_epoch_node** link = &list;
+			while (x && y)
+			{
+				_epoch_node*& newer = x->retired_epoch >= y->retired_epoch ? x : y;
+				*link = newer;
+				link = &newer->retired_next;
+				newer = newer->retired_next;
+			}
+			*link = x ? x : y;
+			return list;
+		}
+
+		void collect_orphans()
+		{
+			if (orphans.load(std::memory_order_relaxed) == nullptr)
+				return;
+			std::lock_guard<std::mutex> guard(orphan_lock);
+			orphans.store(reclaim_list(orphans.load(std::memory_order_relaxed)),
+						  std::memory_order_relaxed);
+		}
+
+		class thread_handle
+		{
+		public:
+			epoch_record* rec;
+
+			thread_handle() :rec(acquire_record()) {}
+
+			~thread_handle()
+			{
+				try_advance();
+				_epoch_node* left = reclaim_list(rec->limbo);
+				rec->limbo = nullptr;
+				if (left)
+				{
+					/* reclaim_list cuts at the first old enough node : the order must hold */
+					std::lock_guard<std::mutex> guard(orphan_lock);
+					orphans.store(merge_lists(left, orphans.load(std::memory_order_relaxed)),
+								  std::memory_order_relaxed);
+				}
+				rec->in_use.store(false, std::memory_order_release);
+			}
+		};
+
+		epoch_record* this_record()
+		{
+			thread_local thread_handle handle;
+			return handle.rec;
+		}
+	}
+
+	void epoch_pin()
+	{
+		epoch_record* rec = this_record();
+		if (rec->nesting++ == 0)
+		{
+			rec->local_epoch.store(global_epoch.load(std::memory_order_relaxed),
+								   std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+		}
+	}
+
+	void epoch_unpin()
+	{
+		epoch_record* rec = this_record();
+		if (--rec->nesting == 0)
+			rec->local_epoch.store(QUIESCENT, std::memory_order_release);
+	}
+
+	void epoch_retire(_epoch_node* node, void (*reclaim)(_epoch_node*))
+	{
+		epoch_record* rec = this_record();
+		node->reclaim       = reclaim;
+		node->retired_epoch = global_epoch.load(std::memory_order_seq_cst);
+		node->retired_next  = rec->limbo;
+		rec->limbo          = node;
+		epoch_collect();
+	}
+
+	void epoch_collect()
+	{
+		epoch_record* rec = this_record();
+		try_advance();
+		rec->limbo = reclaim_list(rec->limbo);
+		collect_orphans();
+	}
+}
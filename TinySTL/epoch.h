@@ -0,0 +1,49 @@
+#pragma once
+#ifndef _TINYSTL_EPOCH_H_
+#define _TINYSTL_EPOCH_H_
+
+#include <cstdint> // uint64_t
+
+/*
+	epoch based reclamation (K. Fraser) for the lock-free containers
+	-a thread pins itself around every access to shared nodes.
+	-an unlinked node is retired with the global epoch of the moment, and
+	 reclaimed once the global epoch has moved 2 steps further :
+	 the epoch can only advance when every pinned thread has seen the current one,
+	 so no thread still pinned can hold a reference to the node by then.
+	-one domain for the whole program, see epoch.cpp
+*/
+
+namespace TinySTL
+{
+	/* intrusive header of anything retired through epoch_retire() */
+	class _epoch_node
+	{
+	public:
+		_epoch_node* retired_next;
+		uint64_t     retired_epoch;
+		void       (*reclaim)(_epoch_node*);
+	};
+
+	/* may nest */
+	void epoch_pin();
+	void epoch_unpin();
+
+	/* reclaim(node) will be called by some thread once node is unreachable */
+	void epoch_retire(_epoch_node* node, void (*reclaim)(_epoch_node*));
+
+	/* try to advance the epoch and reclaim what the calling thread has retired */
+	void epoch_collect();
+
+	class epoch_guard
+	{
+	public:
+		epoch_guard() { epoch_pin(); }
+		~epoch_guard() { epoch_unpin(); }
+
+		epoch_guard(const epoch_guard&) = delete;
+		epoch_guard& operator=(const epoch_guard&) = delete;
+	};
+}
+
+#endif /* _TINYSTL_EPOCH_H_ */
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef _TINYSTL_EXECUTION_H_
+#define _TINYSTL_EXECUTION_H_
+
+#include <type_traits> // std::decay_t, std::is_same_v
+
+/*
+	execution policies, the first argument of the overloads of for_each,
+	transform, count_if, find_if ... in parallel_algorithm.h
+	-seq : the algorithm of algorithm.h, in the calling thread.
+	-par : chunks of the range run as tasks of the default thread_pool,
+	 random access iterators only (others run as seq). the functions
+	 passed shall not race on shared state.
+	-par_unseq : par, the functions passed shall besides not synchronize
+	 (no locks) : the loops of a chunk are then free to be vectorized.
+*/
+
+namespace TinySTL
+{
+	namespace execution
+	{
+		class sequenced_policy {};
+		class parallel_policy {};
+		class parallel_unsequenced_policy {};
+
+		inline constexpr sequenced_policy            seq{};
+		inline constexpr parallel_policy             par{};
+		inline constexpr parallel_unsequenced_policy par_unseq{};
+	}
+
+	template <class T>
+	constexpr bool is_execution_policy_v = false;
+
+	template <>
+	constexpr bool is_execution_policy_v<execution::sequenced_policy> = true;
+
+	template <>
+	constexpr bool is_execution_policy_v<execution::parallel_policy> = true;
+
+	template <>
+	constexpr bool is_execution_policy_v<execution::parallel_unsequenced_policy> = true;
+
+	/* the policy asks for more than one thread */
+	template <class ExecutionPolicy>
+	constexpr bool _is_parallel_policy =
+		!std::is_same_v<std::decay_t<ExecutionPolicy>, execution::sequenced_policy>;
+}
+
+#endif /* _TINYSTL_EXECUTION_H_ */
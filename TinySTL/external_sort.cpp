@@ -0,0 +1,66 @@
+#include <cerrno>
+#include <system_error>
+
+#include "external_sort.h"
+
+namespace TinySTL
+{
+	namespace
+	{
+		[[noreturn]] void io_failure(const char* what)
+		{
+			throw std::system_error(errno ? errno : EIO, std::generic_category(), what);
+		}
+	}
+
+	_binary_file::_binary_file()
+		:file(std::tmpfile())
+	{
+		if (!file)
+			io_failure("external_sort: cannot create a temporary file");
+	}
+
+	_binary_file::_binary_file(const char* path, const char* mode)
+		:file(std::fopen(path, mode))
+	{
+		if (!file)
+			io_failure(path);
+	}
+
+	_binary_file::~_binary_file()
+	{
+		if (file)
+			std::fclose(file);
+	}
+
+	size_t _binary_file::read(void* buf, size_t size, size_t count)
+	{
+		errno = 0;
+		const size_t bytes = std::fread(buf, 1, size * count, file);
+		if (bytes != size * count && std::ferror(file))
+			io_failure("external_sort: read failed");
+		if (bytes % size != 0)
+			throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+									"external_sort: the file ends within a record");
+		return bytes / size;
+	}
+
+	void _binary_file::write(const void* buf, size_t size, size_t count)
+	{
+		errno = 0;
+		if (std::fwrite(buf, size, count, file) != count)
+			io_failure("external_sort: write failed");
+	}
+
+	void _binary_file::flush()
+	{
+		errno = 0;
+		if (std::fflush(file) != 0)
+			io_failure("external_sort: write failed");
+	}
+
+	void _binary_file::rewind()
+	{
+		std::rewind(file);
+	}
+}
@@ -0,0 +1,451 @@
+#pragma once
+#ifndef _TINYSTL_EXTERNAL_SORT_H_
+#define _TINYSTL_EXTERNAL_SORT_H_
+
+#include <cstddef>     // size_t
+#include <cstdio>      // FILE
+#include <new>         // placement new
+#include <type_traits> // std::is_trivially_copyable_v
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "functional.h"
+#include "iterator.h"
+#include "loser_tree.h"
+#include "thread_pool.h"
+#include "utility.h"
+#include "vector.h"
+
+namespace TinySTL
+{
+	/* runs merged at once, more are merged in several passes */
+	enum { EXTERNAL_SORT_MAX_FANOUT = 64 };
+
+	/* bytes a run reader or writer moves at once, at least, when the budget allows */
+	enum { EXTERNAL_SORT_MIN_BLOCK = 1 << 16 };
+
+	/*
+		binary file through stdio, whole records at a time
+		-the default one is a temporary file, removed once closed.
+		-any I/O failure throws std::system_error.
+	*/
+	class _binary_file
+	{
+	protected:
+		FILE* file;
+
+	public:
+		_binary_file();
+		_binary_file(const char* path, const char* mode);
+		~_binary_file();
+
+		_binary_file(const _binary_file&) = delete;
+		_binary_file& operator=(const _binary_file&) = delete;
+
+		/* up to count records, fewer only at the end of the file */
+		size_t read(void* buf, size_t size, size_t count);
+		void write(const void* buf, size_t size, size_t count);
+		void flush();
+		void rewind();
+	};
+
+	/*
+		a run read back block by block : the next block is read by the thread
+		pool while the merge consumes the current one
+	*/
+	template <class T>
+	class _run_reader
+	{
+	protected:
+		_binary_file* file;
+		T*            front;
+		T*            back;
+		size_t        block;
+		size_t        pos;
+		size_t        count;
+		size_t        back_count;
+		task_group    io;
+
+	public:
+		/* 2 * block records at buf */
+		_run_reader(_binary_file* f, T* buf, size_t b)
+			:file(f), front(buf), back(buf + b), block(b), pos(0), count(0), back_count(0)
+		{
+			file->rewind();
+			count = file->read(front, sizeof(T), block);
+			_read_ahead();
+		}
+
+		_run_reader(const _run_reader&) = delete;
+		_run_reader& operator=(const _run_reader&) = delete;
+
+		bool done() const noexcept
+			{ return pos == count; }
+		const T& head() const noexcept
+			{ return front[pos]; }
+
+		void next()
+		{
+			if (++pos != count || count != block)
+				return;
+			io.wait();
+			TinySTL::swap(front, back);
+			count = back_count;
+			pos   = 0;
+			_read_ahead();
+		}
+
+		/* the reader as a range for loser_tree, the end being iterator() */
+		class iterator
+		{
+		public:
+			using iterator_category = input_iterator_tag;
+			using value_type        = T;
+			using difference_type   = ptrdiff_t;
+			using pointer           = const T*;
+			using reference         = const T&;
+
+		protected:
+			_run_reader* reader;
+
+		public:
+			explicit iterator(_run_reader* r = nullptr) :reader(r) {}
+
+			reference operator*() const
+				{ return reader->head(); }
+			iterator& operator++()
+			{
+				reader->next();
+				return *this;
+			}
+
+			friend bool operator==(const iterator& x, const iterator& y)
+				{ return x._at_end() == y._at_end(); }
+			friend bool operator!=(const iterator& x, const iterator& y)
+				{ return !(x == y); }
+
+		protected:
+			bool _at_end() const
+				{ return !reader || reader->done(); }
+		};
+
+	protected:
+		void _read_ahead()
+		{
+			if (count == block)
+				io.run([this] { back_count = file->read(back, sizeof(T), block); });
+		}
+	};
+
+	/* a run written block by block, the previous block written out meanwhile */
+	template <class T>
+	class _run_writer
+	{
+	protected:
+		_binary_file* file;
+		T*            front;
+		T*            back;
+		size_t        block;
+		size_t        count;
+		task_group    io;
+
+	public:
+		/* 2 * block records at buf */
+		_run_writer(_binary_file* f, T* buf, size_t b)
+			:file(f), front(buf), back(buf + b), block(b), count(0) {}
+
+		_run_writer(const _run_writer&) = delete;
+		_run_writer& operator=(const _run_writer&) = delete;
+
+		void push(const T& val)
+		{
+			front[count] = val;
+			if (++count != block)
+				return;
+			io.wait();
+			TinySTL::swap(front, back);
+			T* full = back;
+			io.run([this, full] { file->write(full, sizeof(T), block); });
+			count = 0;
+		}
+
+		void close()
+		{
+			io.wait();
+			file->write(front, sizeof(T), count);
+			file->flush();
+			count = 0;
+		}
+	};
+
+	/*
+		the runs of an external sort and their merges, in a memory arena of
+		capacity records
+		-levels[i] holds the runs merged from fanout runs of levels[i - 1]
+		 (at most EXTERNAL_SORT_MAX_FANOUT), so few files are open at once.
+		-the runs of a level come in input order, those of the higher levels
+		 before : merges keep that order, a stable run sort gives a stable
+		 sort.
+		-a merge of k runs splits the arena into 2k + 2 blocks : double
+		 buffers for every reader and the writer.
+	*/
+	template <class T, class Compare>
+	class _external_sorter
+	{
+	protected:
+		vector<vector<_binary_file*> > levels; // owned
+		T*                             arena;
+		size_t                         capacity;
+		size_t                         fanout;
+		size_t                         run_count;
+		Compare                        comp;
+
+	public:
+		_external_sorter(T* a, size_t cap, Compare c)
+			:arena(a), capacity(cap), run_count(0), comp(c)
+		{
+			const size_t blocks = cap * sizeof(T) / EXTERNAL_SORT_MIN_BLOCK;
+			fanout = blocks < 6 ? 2 : TinySTL::min(size_t(EXTERNAL_SORT_MAX_FANOUT), (blocks - 2) / 2);
+		}
+
+		~_external_sorter()
+		{
+			for (auto& level : levels)
+				for (auto run : level)
+					delete run;
+		}
+
+		_external_sorter(const _external_sorter&) = delete;
+		_external_sorter& operator=(const _external_sorter&) = delete;
+
+		bool empty() const noexcept
+			{ return run_count == 0; }
+
+		/* arena[0, n) sorted : the next run */
+		void add_run(size_t n)
+		{
+			_binary_file* run = _new_run(0);
+			run->write(arena, sizeof(T), n);
+			run->flush();
+			if (levels[0].size() == fanout)
+				_merge_level(0);
+		}
+
+		/* merges every run into out : a _binary_file* or an output iterator */
+		template <class Out>
+		void finish(Out& out)
+		{
+			/* the lowest levels first : they hold the shortest runs */
+			for (size_t level = 0; run_count > fanout; ++level)
+				_merge_level(level);
+
+			vector<_binary_file*> runs;
+			for (size_t i = levels.size(); i-- != 0; )
+				for (auto run : levels[i])
+					runs.push_back(run);
+			_merge(runs.data(), runs.size(), out);
+		}
+
+	protected:
+		_binary_file* _new_run(size_t level)
+		{
+			if (levels.size() == level)
+				levels.push_back(vector<_binary_file*>());
+			levels[level].push_back(nullptr);
+			levels[level].back() = new _binary_file();
+			++run_count;
+			return levels[level].back();
+		}
+
+		/* the runs of a level -> one run of the next */
+		void _merge_level(size_t level)
+		{
+			if (levels[level].empty())
+				return;
+			_binary_file* merged = _new_run(level + 1);
+			_merge(levels[level].data(), levels[level].size(), merged);
+			for (auto run : levels[level])
+				delete run;
+			run_count -= levels[level].size();
+			levels[level].clear();
+			if (levels[level + 1].size() == fanout)
+				_merge_level(level + 1);
+		}
+
+		template <class Out>
+		void _merge(_binary_file** runs, size_t k, Out& out)
+		{
+			using Iter = typename _run_reader<T>::iterator;
+			const size_t block = capacity / (2 * k + 2);
+
+			vector<_run_reader<T>*> readers;
+			vector<pair<Iter, Iter> > sources;
+			try
+			{
+				for (size_t i = 0; i != k; ++i)
+				{
+					readers.push_back(nullptr);
+					readers.back() = new _run_reader<T>(runs[i], arena + 2 * i * block, block);
+					sources.push_back(pair<Iter, Iter>(Iter(readers.back()), Iter()));
+				}
+				loser_tree<Iter, Compare> tree(sources.begin(), sources.end(), comp);
+				if constexpr (std::is_same_v<Out, _binary_file*>)
+				{
+					_run_writer<T> writer(out, arena + 2 * k * block, block);
+					for (; !tree.empty(); tree.pop())
+						writer.push(tree.top_value());
+					writer.close();
+				}
+				else
+				{
+					for (; !tree.empty(); tree.pop(), ++out)
+						*out = tree.top_value();
+				}
+			}
+			catch (...)
+			{
+				for (auto reader : readers)
+					delete reader;
+				throw;
+			}
+			for (auto reader : readers)
+				delete reader;
+		}
+	};
+
+	/*
+		fill(buf, n) hands out up to n records, fewer at the end of the input,
+		sort_run(first, last) sorts a run in memory, comp is its order
+	*/
+	template <class T, class Fill, class SortRun, class Compare, class Out>
+	void _external_sort_in(T* arena, size_t capacity, Fill& fill, SortRun& sort_run, Compare comp, Out& out)
+	{
+		_external_sorter<T, Compare> sorter(arena, capacity, comp);
+		for (;;)
+		{
+			const size_t n = fill(arena, capacity);
+			if (n != capacity && sorter.empty())
+			{
+				/* the whole input fits in memory */
+				sort_run(arena, arena + n);
+				if constexpr (std::is_same_v<Out, _binary_file*>)
+					out->write(arena, sizeof(T), n);
+				else
+					out = TinySTL::copy(arena, arena + n, out);
+				return;
+			}
+			if (n == 0)
+				break;
+			sort_run(arena, arena + n);
+			sorter.add_run(n);
+			if (n != capacity)
+				break;
+		}
+		sorter.finish(out);
+	}
+
+	/* the arena is raw memory the records are copied into : T needs no default constructor */
+	template <class T, class Fill, class SortRun, class Compare, class Out>
+	void _external_sort(size_t memory_bytes, Fill fill, SortRun sort_run, Compare comp, Out& out)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "external_sort records shall be trivially copyable");
+		const size_t capacity = TinySTL::max(memory_bytes / sizeof(T), size_t(6));
+		T* arena = allocator<T>::allocate(capacity);
+		try
+		{
+			_external_sort_in(arena, capacity, fill, sort_run, comp, out);
+		}
+		catch (...)
+		{
+			allocator<T>::deallocate(arena, capacity);
+			throw;
+		}
+		allocator<T>::deallocate(arena, capacity);
+	}
+
+	template <class T, class InputIter>
+	auto _external_fill(InputIter& first, InputIter last)
+	{
+		return [&first, last](T* buf, size_t n)
+		{
+			size_t i = 0;
+			for (; i != n && first != last; ++first, ++i)
+				::new(static_cast<void*>(buf + i)) T(*first);
+			return i;
+		};
+	}
+
+	template <class T>
+	auto _external_fill(_binary_file& in)
+	{
+		return [&in](T* buf, size_t n) { return in.read(buf, sizeof(T), n); };
+	}
+
+	/*
+		sorts data larger than memory, using about memory_bytes of it
+		-runs of memory_bytes are sorted by sort() and written to temporary
+		 files, then merged through a loser tree, several passes when there
+		 are too many runs for blocks of EXTERNAL_SORT_MIN_BLOCK bytes.
+		-records are trivially copyable and go to the files as raw bytes :
+		 a file holds records of sizeof(T) bytes in the machine's layout.
+		-not stable, see external_radix_sort.
+		-I/O failures throw std::system_error.
+	*/
+	template <class T, class Compare = less<> >
+	void external_sort(const char* input, const char* output, size_t memory_bytes, Compare comp = Compare())
+	{
+		_binary_file in(input, "rb");
+		_binary_file out(output, "wb");
+		_binary_file* dest = &out;
+		_external_sort<T>(memory_bytes, _external_fill<T>(in),
+			[comp](T* run_first, T* run_last) { TinySTL::sort(run_first, run_last, comp); }, comp, dest);
+		out.flush();
+	}
+
+	template <class InputIter, class OutputIter, class Compare>
+	OutputIter external_sort(InputIter first, InputIter last, OutputIter result,
+							 size_t memory_bytes, Compare comp)
+	{
+		using T = typename iterator_traits<InputIter>::value_type;
+		_external_sort<T>(memory_bytes, _external_fill<T>(first, last),
+			[comp](T* run_first, T* run_last) { TinySTL::sort(run_first, run_last, comp); }, comp, result);
+		return result;
+	}
+
+	template <class InputIter, class OutputIter>
+	OutputIter external_sort(InputIter first, InputIter last, OutputIter result, size_t memory_bytes)
+	{
+		return external_sort(first, last, result, memory_bytes, less<>());
+	}
+
+	/*
+		external_sort with radix_sort on key(record) for the runs : stable,
+		radix_sort being so on any length (the short last run, an input
+		that fits in memory). radix_sort needs a buffer as large as the
+		run, runs get half of memory_bytes.
+	*/
+	template <class T, class KeyOf>
+	void external_radix_sort(const char* input, const char* output, size_t memory_bytes, KeyOf key)
+	{
+		_binary_file in(input, "rb");
+		_binary_file out(output, "wb");
+		_binary_file* dest = &out;
+		_external_sort<T>(memory_bytes / 2, _external_fill<T>(in),
+			[key](T* run_first, T* run_last) { TinySTL::radix_sort(run_first, run_last, key); },
+			[key](const T& x, const T& y) { return _radix_bits(key(x)) < _radix_bits(key(y)); }, dest);
+		out.flush();
+	}
+
+	template <class InputIter, class OutputIter, class KeyOf>
+	OutputIter external_radix_sort(InputIter first, InputIter last, OutputIter result,
+								   size_t memory_bytes, KeyOf key)
+	{
+		using T = typename iterator_traits<InputIter>::value_type;
+		_external_sort<T>(memory_bytes / 2, _external_fill<T>(first, last),
+			[key](T* run_first, T* run_last) { TinySTL::radix_sort(run_first, run_last, key); },
+			[key](const T& x, const T& y) { return _radix_bits(key(x)) < _radix_bits(key(y)); }, result);
+		return result;
+	}
+}
+
+#endif /* _TINYSTL_EXTERNAL_SORT_H_ */
@@ -0,0 +1,199 @@
+#pragma once
+#ifndef _TINYSTL_EYTZINGER_H_
+#define _TINYSTL_EYTZINGER_H_
+
+#include <cstddef>     // size_t
+#include <cstdint>     // uintptr_t
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "functional.h"
+#include "iterator.h"
+#include "type_traits.h"
+#include "vector.h"
+#include "xsimd.h"
+
+#if defined(_MSC_VER)
+#   include <intrin.h> // _BitScanForward64, _BitScanReverse64
+#endif
+
+namespace TinySTL
+{
+	/* how many levels below the current node the search prefetches */
+	enum { EYTZINGER_PREFETCH_LEVELS = 4 };
+
+	enum { EYTZINGER_CACHE_LINE = 64 };
+
+	inline unsigned _floor_log2(size_t x)
+	{
+#if defined(_MSC_VER)
+		unsigned long i;
+		_BitScanReverse64(&i, x);
+		return unsigned(i);
+#else
+		return unsigned(63 - __builtin_clzll(x));
+#endif
+	}
+
+	inline unsigned _count_trailing_ones(size_t x)
+	{
+		x = ~x;
+		if (x == 0)
+			return unsigned(sizeof(size_t) * 8);
+#if defined(_MSC_VER)
+		unsigned long i;
+		_BitScanForward64(&i, x);
+		return unsigned(i);
+#else
+		return unsigned(__builtin_ctzll(x));
+#endif
+	}
+
+	/*
+		a sorted sequence laid out in BFS order of the implicit binary search
+		tree (Eytzinger layout) : the children of node k are 2k and 2k + 1,
+		node 1 being the root, slot 0 unused.
+		-the first levels, visited by every search, share a few cache lines,
+		 and the 2^4 descendants 4 levels down are contiguous : the search
+		 prefetches them, a cache miss is then paid once every 4 levels
+		 rather than at every level like lower_bound on the sorted array.
+		 slot 0 sits on a cache line boundary so that those descendants fill
+		 whole lines (a copy of the index may lose that, not its results).
+		-a search goes down without branching on the comparison and finds
+		 its answer in the trailing bits of the final node index, the rank
+		 in the sorted sequence is then computed from the shape of the tree.
+		-static : rebuild it to change the keys.
+	*/
+	template <class T, class Compare = less<>, class Alloc = allocator<T> >
+	class eytzinger_index
+	{
+	public:
+		using value_type     = T;
+		using size_type      = size_t;
+		using key_compare    = Compare;
+		using allocator_type = Alloc;
+		using const_pointer  = const T*;
+
+	protected:
+		/* spare slots so that one of them is cache line aligned */
+		static constexpr size_type padding =
+			EYTZINGER_CACHE_LINE % sizeof(T) == 0 ? EYTZINGER_CACHE_LINE / sizeof(T) - 1 : 0;
+
+	protected:
+		vector<T, Alloc> storage; // copies of the first key around the nodes
+		size_type        offset;  // slot 0 of the tree in storage
+		size_type        n;
+		Compare          comp;
+
+	public:
+		explicit eytzinger_index(const Compare& c = Compare(), const Alloc& alloc = Alloc())
+			:storage(alloc), offset(0), n(0), comp(c) {}
+
+		/* [first, last) sorted by c */
+		template <class InputIter, class = enable_if_t<_is_iterator_v<InputIter> > >
+		eytzinger_index(InputIter first, InputIter last,
+						const Compare& c = Compare(), const Alloc& alloc = Alloc())
+			:storage(alloc), offset(0), n(0), comp(c)
+		{
+			vector<T, Alloc> sorted(first, last, alloc);
+			n = sorted.size();
+			if (n == 0)
+				return;
+			storage.resize(n + 1 + padding, sorted[0]);
+			while (offset != padding &&
+				   reinterpret_cast<uintptr_t>(storage.data() + offset) % EYTZINGER_CACHE_LINE != 0)
+				++offset;
+			size_type rank = 0;
+			_build(sorted, rank, 1);
+		}
+
+		size_type size() const noexcept
+			{ return n; }
+		bool empty() const noexcept
+			{ return n == 0; }
+		key_compare key_comp() const
+			{ return comp; }
+
+		/* the keys in BFS order */
+		const_pointer begin() const noexcept
+			{ return _nodes() + 1; }
+		const_pointer end() const noexcept
+			{ return _nodes() + 1 + n; }
+
+		/* rank of the first key not less than val, size() when there is none */
+		template <class K>
+		size_type lower_bound(const K& val) const
+		{
+			return _rank(_descend(val, [this](const T& node, const K& v) { return comp(node, v); }));
+		}
+
+		/* rank of the first key greater than val, size() when there is none */
+		template <class K>
+		size_type upper_bound(const K& val) const
+		{
+			return _rank(_descend(val, [this](const T& node, const K& v) { return !comp(v, node); }));
+		}
+
+		template <class K>
+		bool contains(const K& val) const
+		{
+			size_type k = _descend(val, [this](const T& node, const K& v) { return comp(node, v); });
+			return k != 0 && !comp(val, _nodes()[k]);
+		}
+
+	protected:
+		const T* _nodes() const noexcept
+			{ return storage.data() + offset; }
+
+		/* in-order walk of the implicit tree, handing out the sorted keys */
+		void _build(const vector<T, Alloc>& sorted, size_type& rank, size_type k)
+		{
+			if (k > n)
+				return;
+			_build(sorted, rank, 2 * k);
+			storage[offset + k] = sorted[rank++];
+			_build(sorted, rank, 2 * k + 1);
+		}
+
+		/*
+			goes right while go_right(node, val), left otherwise, down to a
+			leaf : the answer is the last node where we went left, found by
+			dropping the trailing right turns (ones) and that left turn.
+			0 when we never went left.
+		*/
+		template <class K, class GoRight>
+		size_type _descend(const K& val, GoRight go_right) const
+		{
+			const T* base = _nodes();
+			size_type k = 1;
+			while (k <= n)
+			{
+				/* only an address : may lie past the end, _prefetch doesn't care */
+				_prefetch(reinterpret_cast<const void*>(reinterpret_cast<uintptr_t>(base) +
+					(k << EYTZINGER_PREFETCH_LEVELS) * sizeof(T)));
+				k = 2 * k + size_type(go_right(base[k], val));
+			}
+			return k >> (_count_trailing_ones(k) + 1);
+		}
+
+		/*
+			in-order position of k : its rank in the perfect tree down to the
+			last level (2^(L + 1) - 1 nodes, last level leaves at the even ranks),
+			less the leaves of that level missing before it
+		*/
+		size_type _rank(size_type k) const
+		{
+			if (k == 0)
+				return n;
+			const unsigned  last_level = _floor_log2(n);
+			const unsigned  depth      = _floor_log2(k);
+			const size_type leaves     = n - (size_type(1) << last_level) + 1;
+			const size_type perfect    = ((2 * (k - (size_type(1) << depth)) + 1)
+										  << (last_level - depth)) - 1;
+			const size_type before     = (perfect + 1) / 2;
+			return perfect - (before - TinySTL::min(before, leaves));
+		}
+	};
+}
+
+#endif /* _TINYSTL_EYTZINGER_H_ */
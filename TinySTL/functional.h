@@ -23,11 +23,11 @@ namespace TinySTL
         using result_type          = Result;
     };
 
-    template<class Arg>
+    template <class Arg = void>
     class equal_to
     {
     public:
-        bool operator ()(const Arg& x, const Arg& y) { return x == y; }
+        bool operator ()(const Arg& x, const Arg& y) const { return x == y; }
     };
 
     template<>
@@ -35,7 +35,7 @@ namespace TinySTL
     {
     public:
         template <class T, class U>
-        auto operator()(T&& x, U&& y)
+        auto operator()(T&& x, U&& y) const
         ->decltype(forward<T>(x) == forward<U>(y))
         {
             return forward<T>(x) == forward<U>(y);
@@ -46,7 +46,7 @@ namespace TinySTL
     class less
     {
     public:
-        bool operator()(const Arg& x, const Arg& y) { return x < y; }
+        bool operator()(const Arg& x, const Arg& y) const { return x < y; }
     };
 
     template <>
@@ -54,13 +54,51 @@ namespace TinySTL
     {
     public:
         template <class T, class U>
-        auto operator()(T&& x, U&& y)
+        auto operator()(T&& x, U&& y) const
         ->decltype(forward<T>(x) < forward<U>(y))
         {
             return forward<T>(x) < forward<U>(y);
         }
     };
 
+    template <class Arg = void>
+    class plus
+    {
+    public:
+        Arg operator()(const Arg& x, const Arg& y) const { return x + y; }
+    };
+
+    template <>
+    class plus<void>
+    {
+    public:
+        template <class T, class U>
+        auto operator()(T&& x, U&& y) const
+        ->decltype(forward<T>(x) + forward<U>(y))
+        {
+            return forward<T>(x) + forward<U>(y);
+        }
+    };
+
+    template <class Arg = void>
+    class multiplies
+    {
+    public:
+        Arg operator()(const Arg& x, const Arg& y) const { return x * y; }
+    };
+
+    template <>
+    class multiplies<void>
+    {
+    public:
+        template <class T, class U>
+        auto operator()(T&& x, U&& y) const
+        ->decltype(forward<T>(x) * forward<U>(y))
+        {
+            return forward<T>(x) * forward<U>(y);
+        }
+    };
+
     /* ... */
 }
 
@@ -3,6 +3,7 @@
 #define _TINYSTL_HEAP_H_
 
 #include "iterator.h"
+#include "utility.h"
 
 namespace TinySTL
 {
@@ -12,11 +13,11 @@ namespace TinySTL
 		Distance parent = (now - 1) / 2;
 		while (now > limit && comp(*(first + parent), val))
 		{
-			*(first + now) = *(first + parent);
+			*(first + now) = TinySTL::move(*(first + parent));
 			now = parent;
 			parent = (now - 1) / 2;
 		}
-		*(first + now) = val;
+		*(first + now) = TinySTL::move(val);
 	}
 
 	template <class RandomIter>
@@ -30,7 +31,7 @@ namespace TinySTL
 	{
 		using Distance = typename iterator_traits<RandomIter>::difference_type;
 		_push_heap(first, Distance((last - first) - 1),
-						  Distance(0), *(last - 1), comp);
+						  Distance(0), TinySTL::move(*(last - 1)), comp);
 	}
 
 	template <class RandomIter, class Distance, class T, class Compare>
@@ -42,17 +43,17 @@ namespace TinySTL
 		{
 			if (comp(*(first + aimchild), *(first + aimchild - 1)))
 				--aimchild;
-			*(first + now) = *(first + aimchild);
+			*(first + now) = TinySTL::move(*(first + aimchild));
 			now = aimchild;
 			aimchild = now * 2 + 2;
 		}
 		if (aimchild == limit)
 		{
 			--aimchild;
-			*(first + now) = *(first + aimchild);
+			*(first + now) = TinySTL::move(*(first + aimchild));
 			now = aimchild;
 		}
-		_push_heap(first, now, next_limit, val, comp);
+		_push_heap(first, now, next_limit, TinySTL::move(val), comp);
 	}
 
 	template <class RandomIter, class Compare, class T>
@@ -60,8 +61,8 @@ namespace TinySTL
 				   RandomIter result, T val, Compare comp)
 	{
 		using Distance = typename iterator_traits<RandomIter>::difference_type;
-		*result = *first;
-		_adjust_heap(first, Distance(0), Distance(last - first), val, comp);
+		*result = TinySTL::move(*first);
+		_adjust_heap(first, Distance(0), Distance(last - first), TinySTL::move(val), comp);
 	}
 
 	template <class RandomIter>
@@ -74,9 +75,9 @@ namespace TinySTL
 	void pop_heap(RandomIter first, RandomIter last, Compare comp)
 	{
 		using Distance = typename iterator_traits<RandomIter>::difference_type;
-		auto val = *--last;
-		*last = *first;
-		_adjust_heap(first, Distance(0), Distance(last - first), val, comp);
+		auto val = TinySTL::move(*--last);
+		*last = TinySTL::move(*first);
+		_adjust_heap(first, Distance(0), Distance(last - first), TinySTL::move(val), comp);
 	}
 
 	template <class RandomIter>
@@ -93,7 +94,7 @@ namespace TinySTL
 		auto parent = (limit - 2) / 2;
 		for (;;)
 		{
-			_adjust_heap(first, parent, limit, *(first + parent), comp);
+			_adjust_heap(first, parent, limit, TinySTL::move(*(first + parent)), comp);
 			if (parent == 0)return;
 			--parent;
 		}
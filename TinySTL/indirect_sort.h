@@ -0,0 +1,147 @@
+#pragma once
+#ifndef _TINYSTL_INDIRECT_SORT_H_
+#define _TINYSTL_INDIRECT_SORT_H_
+
+#include <cstddef>     // size_t
+#include <type_traits> // std::decay_t, std::is_arithmetic_v, std::is_floating_point_v
+
+#include "algorithm.h"
+#include "functional.h"
+#include "iterator.h"
+#include "utility.h"
+#include "vector.h"
+
+namespace TinySTL
+{
+	template <class Key, class Compare>
+	constexpr bool _radix_sortable_key = std::is_arithmetic_v<Key> && !std::is_same_v<Key, bool> &&
+										  _is_default_less<Compare, Key>;
+
+	/* the indices of [first, first + n) in the order sorting them stably by comp */
+	template <class RandomIter, class Compare>
+	vector<size_t> _sorted_indices(RandomIter first, size_t n, Compare comp)
+	{
+		vector<size_t> perm(n, 0);
+		for (size_t i = 0; i != n; ++i)
+			perm[i] = i;
+		/* a lambda : its type brings no namespace of the keys into the lookups of sort */
+		TinySTL::sort(perm.begin(), perm.end(), [first, comp](size_t i, size_t j) mutable
+		{
+			if (comp(first[i], first[j]))
+				return true;
+			return !comp(first[j], first[i]) && i < j;
+		});
+		return perm;
+	}
+
+	template <class RandomIter, class PermIter>
+	void _apply_permutation(PermIter perm, size_t n, RandomIter first, vector<unsigned char>& done)
+	{
+		using T = typename iterator_traits<RandomIter>::value_type;
+		done.assign(n, 0);
+		for (size_t start = 0; start != n; ++start)
+		{
+			if (done[start] || size_t(perm[start]) == start)
+				continue;
+			T tmp(TinySTL::move(first[start]));
+			size_t j = start;
+			for (;;)
+			{
+				done[j] = 1;
+				const size_t k = size_t(perm[j]);
+				if (k == start)
+				{
+					first[j] = TinySTL::move(tmp);
+					break;
+				}
+				first[j] = TinySTL::move(first[k]);
+				j = k;
+			}
+		}
+	}
+
+	/*
+		reorders every range at firsts... in place, element perm[i] moving to
+		position i (a gather, so the order argsort returns sorts the range) :
+		one move per element plus one per cycle of the permutation.
+		[perm_first, perm_last) is a permutation of 0 .. n - 1, the ranges
+		hold n elements at least.
+	*/
+	template <class PermIter, class... RandomIters>
+	void apply_permutation(PermIter perm_first, PermIter perm_last, RandomIters... firsts)
+	{
+		const size_t n = size_t(TinySTL::distance(perm_first, perm_last));
+		vector<unsigned char> done;
+		(_apply_permutation(perm_first, n, firsts, done), ...);
+	}
+
+	/*
+		the permutation sorting [first, last) stably by comp : first[perm[0]],
+		first[perm[1]] ... is sorted, the range itself is left alone
+	*/
+	template <class RandomIter>
+	vector<size_t> argsort(RandomIter first, RandomIter last)
+	{
+		return argsort(first, last, less<>());
+	}
+
+	template <class RandomIter, class Compare>
+	vector<size_t> argsort(RandomIter first, RandomIter last, Compare comp)
+	{
+		return _sorted_indices(first, size_t(last - first), comp);
+	}
+
+	/*
+		sorts [first, last) stably by comp on key_fn(element), key_fn called
+		once per element : the keys are cached and sorted alone, as indices
+		(arithmetic keys under less : next to their indices, by radix_sort),
+		the elements then move once, along the cycles of the permutation.
+	*/
+	template <class RandomIter, class KeyFn>
+	void sort_by_key(RandomIter first, RandomIter last, KeyFn key_fn)
+	{
+		sort_by_key(first, last, key_fn, less<>());
+	}
+
+	template <class RandomIter, class KeyFn, class Compare>
+	void sort_by_key(RandomIter first, RandomIter last, KeyFn key_fn, Compare comp)
+	{
+		using Key = std::decay_t<decltype(key_fn(*first))>;
+		const size_t n = size_t(last - first);
+		if (n < 2)
+			return;
+		vector<size_t> perm;
+		if constexpr (_radix_sortable_key<Key, Compare>)
+		{
+			/* the keys travel with their indices : radix_sort is stable from RADIX_SORT_THRESHOLD on */
+			vector<pair<Key, size_t> > keys;
+			keys.reserve(n);
+			for (size_t i = 0; i != n; ++i)
+			{
+				Key key = key_fn(first[i]);
+				if constexpr (std::is_floating_point_v<Key>)
+					key += Key(0); // -0.0 -> +0.0 : the bits order them, less doesn't
+				keys.push_back(pair<Key, size_t>(key, i));
+			}
+			if (n >= RADIX_SORT_THRESHOLD)
+				TinySTL::radix_sort(keys.begin(), keys.end(), [](const pair<Key, size_t>& p) { return p.first; });
+			else
+				TinySTL::sort(keys.begin(), keys.end(), [](const pair<Key, size_t>& x, const pair<Key, size_t>& y)
+					{ return x.first < y.first || (!(y.first < x.first) && x.second < y.second); });
+			perm.resize(n);
+			for (size_t i = 0; i != n; ++i)
+				perm[i] = keys[i].second;
+		}
+		else
+		{
+			vector<Key> keys;
+			keys.reserve(n);
+			for (size_t i = 0; i != n; ++i)
+				keys.push_back(key_fn(first[i]));
+			perm = _sorted_indices(keys.begin(), n, comp);
+		}
+		apply_permutation(perm.begin(), perm.end(), first);
+	}
+}
+
+#endif /* _TINYSTL_INDIRECT_SORT_H_ */
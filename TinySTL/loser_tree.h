@@ -0,0 +1,179 @@
+#pragma once
+#ifndef _TINYSTL_LOSER_TREE_H_
+#define _TINYSTL_LOSER_TREE_H_
+
+#include <cstddef>     // size_t
+#include <type_traits> // std::remove_cv_t
+
+#include "functional.h"
+#include "iterator.h"
+#include "utility.h"
+#include "vector.h"
+
+namespace TinySTL
+{
+	template <class T>
+	constexpr bool _is_pair = false;
+
+	template <class T1, class T2>
+	constexpr bool _is_pair<pair<T1, T2> > = true;
+
+	/* a source of a merge : pair(first, last) or anything with begin() / end() */
+	template <class Source>
+	auto _source_begin(Source& s)
+	{
+		if constexpr (_is_pair<std::remove_cv_t<Source> >)
+			return s.first;
+		else
+			return s.begin();
+	}
+
+	template <class Source>
+	auto _source_end(Source& s)
+	{
+		if constexpr (_is_pair<std::remove_cv_t<Source> >)
+			return s.second;
+		else
+			return s.end();
+	}
+
+	/*
+		tournament tree of losers over k sorted sources
+		-the leaves are the sources (k rounded up to a power of 2, the extra
+		 ones empty), every inner node keeps the loser of the match played
+		 there and nodes[0] the overall winner : the source with the smallest
+		 head.
+		-once the head of the winner is consumed only its path to the root is
+		 replayed, against the losers : ceil(log2 k) comparisons per element
+		 (a binary heap needs up to 2 per level).
+		-an empty source loses every match, ties go to the lower source
+		 index : merges through the tree are stable.
+	*/
+	template <class Iter, class Compare = less<> >
+	class loser_tree
+	{
+	public:
+		using source    = pair<Iter, Iter>;
+		using size_type = size_t;
+
+	protected:
+		vector<source>    sources;
+		vector<size_type> nodes;
+		size_type         leaves;
+		Compare           comp;
+
+	public:
+		/* [first, last) : the sources, see _source_begin */
+		template <class SourceIter>
+		loser_tree(SourceIter first, SourceIter last, Compare c = Compare())
+			:leaves(1), comp(c)
+		{
+			for (; first != last; ++first)
+				sources.push_back(source(_source_begin(*first), _source_end(*first)));
+			while (leaves < sources.size())
+				leaves *= 2;
+
+			/* winners of the matches, bottom up, the losers stay in the nodes */
+			vector<size_type> winners(2 * leaves, 0);
+			nodes.resize(leaves, 0);
+			for (size_type i = 0; i != leaves; ++i)
+				winners[leaves + i] = i;
+			for (size_type n = leaves - 1; n != 0; --n)
+			{
+				size_type a = winners[2 * n], b = winners[2 * n + 1];
+				if (!_beats(a, b))
+					TinySTL::swap(a, b);
+				winners[n] = a;
+				nodes[n]   = b;
+			}
+			nodes[0] = leaves == 1 ? 0 : winners[1];
+		}
+
+		size_type size() const noexcept
+			{ return sources.size(); }
+
+		/* every source is used up */
+		bool empty() const
+			{ return _exhausted(nodes[0]); }
+
+		/* the source holding the smallest head, not empty() */
+		size_type top() const noexcept
+			{ return nodes[0]; }
+		decltype(auto) top_value() const
+			{ return *sources[nodes[0]].first; }
+		const source& top_source() const noexcept
+			{ return sources[nodes[0]]; }
+
+		/* consumes the smallest head */
+		void pop()
+		{
+			++sources[nodes[0]].first;
+			_replay();
+		}
+
+		/*
+			consumes the first n elements of the winning source at once,
+			they shall all come before the heads of the other sources
+		*/
+		void pop(typename iterator_traits<Iter>::difference_type n)
+		{
+			advance(sources[nodes[0]].first, n);
+			_replay();
+		}
+
+		/* where every source stands */
+		const source* source_data() const noexcept
+			{ return sources.data(); }
+
+	protected:
+		bool _exhausted(size_type i) const
+			{ return i >= sources.size() || sources[i].first == sources[i].second; }
+
+		/* source i's head comes first in the merge */
+		bool _beats(size_type i, size_type j)
+		{
+			if (_exhausted(j))
+				return true;
+			if (_exhausted(i))
+				return false;
+			return i < j ? !comp(*sources[j].first, *sources[i].first)
+						 : comp(*sources[i].first, *sources[j].first);
+		}
+
+		void _replay()
+		{
+			size_type winner = nodes[0];
+			for (size_type n = (leaves + winner) / 2; n != 0; n /= 2)
+				if (_beats(nodes[n], winner))
+					TinySTL::swap(nodes[n], winner);
+			nodes[0] = winner;
+		}
+	};
+
+	/*
+		merges the sorted sources [first, last) into result, stable : among
+		equivalent elements those of the earlier sources come first. the
+		sources are pairs (first, last) of iterators or containers, all of
+		the same iterator type.
+	*/
+	template <class SourceIter, class OutputIter>
+	OutputIter multiway_merge(SourceIter first, SourceIter last, OutputIter result)
+	{
+		return multiway_merge(first, last, result, less<>());
+	}
+
+	template <class SourceIter, class OutputIter, class Compare>
+	OutputIter multiway_merge(SourceIter first, SourceIter last, OutputIter result, Compare comp)
+	{
+		using Iter = decltype(_source_begin(*first));
+		loser_tree<Iter, Compare> tree(first, last, comp);
+		for (; !tree.empty(); ++result)
+		{
+			*result = tree.top_value();
+			tree.pop();
+		}
+		return result;
+	}
+}
+
+#endif /* _TINYSTL_LOSER_TREE_H_ */
@@ -462,7 +462,7 @@ namespace TinySTL
 			for (; first != last; ++first, ++current)
 			{
 				allocator_traits<Alloc>::construct(alloc,
-					addressof(*current), *first);
+					TinySTL::addressof(*current), *first);
 			}
 			return current;
 		}
@@ -501,7 +501,7 @@ namespace TinySTL
 			for (; current != last; ++current)
 			{
 				allocator_traits<Alloc>::construct(alloc,
-					addressof(*current), val);
+					TinySTL::addressof(*current), val);
 			}
 			return current;
 		}
@@ -540,7 +540,7 @@ namespace TinySTL
 			for (; n>0; --n, ++current)
 			{
 				allocator_traits<Alloc>::construct(alloc,
-					addressof(*current), val);
+					TinySTL::addressof(*current), val);
 			}
 			return current;
 		}
@@ -566,7 +566,7 @@ namespace TinySTL
 	ForwardIter _uninitialized_move(InputIter first, InputIter last, ForwardIter result,
 									std::true_type, Alloc& alloc)
 	{
-		return move(first, last, result);
+		return TinySTL::move(first, last, result);
 	}
 
 	template <class InputIter, class ForwardIter, class Alloc>
@@ -579,7 +579,7 @@ namespace TinySTL
 			for (; first != last; ++first, ++current)
 			{
 				allocator_traits<Alloc>::construct(alloc,
-					addressof(*current), move(*first));
+					TinySTL::addressof(*current), TinySTL::move(*first));
 			}
 			return current;
 		}
@@ -0,0 +1,293 @@
+#pragma once
+#ifndef _TINYSTL_NUMERIC_H_
+#define _TINYSTL_NUMERIC_H_
+
+#include <type_traits> // std::is_arithmetic_v, std::is_pointer_v, std::is_same_v
+
+#include "functional.h"
+#include "iterator.h"
+#include "utility.h"
+#include "xsimd.h"
+
+namespace TinySTL
+{
+	/* independent partial sums kept by reduce / transform_reduce on contiguous arithmetic ranges */
+	enum { REDUCE_LANES = 8 };
+
+	/* in order, left to right : init = op(init, *first) */
+	template <class InputIter, class T>
+	T accumulate(InputIter first, InputIter last, T init)
+	{
+		for (; first != last; ++first)
+			init = TinySTL::move(init) + *first;
+		return init;
+	}
+
+	template <class InputIter, class T, class BinaryOperation>
+	T accumulate(InputIter first, InputIter last, T init, BinaryOperation op)
+	{
+		for (; first != last; ++first)
+			init = op(TinySTL::move(init), *first);
+		return init;
+	}
+
+	/* init + *first1 * *first2 + ..., in order */
+	template <class InputIter1, class InputIter2, class T>
+	T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init)
+	{
+		for (; first1 != last1; ++first1, ++first2)
+			init = TinySTL::move(init) + *first1 * *first2;
+		return init;
+	}
+
+	template <class InputIter1, class InputIter2, class T,
+			  class BinaryOperation1, class BinaryOperation2>
+	T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+					BinaryOperation1 op1, BinaryOperation2 op2)
+	{
+		for (; first1 != last1; ++first1, ++first2)
+			init = op1(TinySTL::move(init), op2(*first1, *first2));
+		return init;
+	}
+
+	/*
+		T* ranges of builtin arithmetic types under plain + : the terms are
+		spread over REDUCE_LANES partial sums, which breaks the dependency
+		chain of the single accumulator and lets the compiler keep them in
+		vector registers. floating point sums come out grouped differently
+		than with accumulate (which is what reduce allows).
+	*/
+	template <class Iter, class T, class BinaryOperation>
+	constexpr bool _reduce_lanes_able =
+		std::is_pointer_v<Iter> &&
+		std::is_arithmetic_v<typename iterator_traits<Iter>::value_type> &&
+		std::is_arithmetic_v<T> &&
+		(std::is_same_v<BinaryOperation, plus<> > || std::is_same_v<BinaryOperation, plus<T> >);
+
+	/* sum of transform(*p) for p in [first, last), lane by lane */
+	template <class T, class Pointer, class Transform>
+	T _reduce_lanes(Pointer first, Pointer last, T init, Transform transform)
+	{
+		T lanes[REDUCE_LANES] = {};
+		for (; last - first >= REDUCE_LANES; first += REDUCE_LANES)
+			for (int i = 0; i != REDUCE_LANES; ++i)
+				lanes[i] += transform(first + i);
+		for (int i = 0; first != last; ++first, ++i)
+			lanes[i] += transform(first);
+		for (int width = REDUCE_LANES / 2; width != 0; width /= 2)
+			for (int i = 0; i != width; ++i)
+				lanes[i] += lanes[i + width];
+		return init + lanes[0];
+	}
+
+	/*
+		like accumulate, but op may be applied in any order and grouping :
+		op has to be associative and commutative
+	*/
+	template <class InputIter, class T, class BinaryOperation>
+	T reduce(InputIter first, InputIter last, T init, BinaryOperation op)
+	{
+		if constexpr (_reduce_lanes_able<InputIter, T, BinaryOperation>)
+			return _reduce_lanes(first, last, init, [](InputIter p) { return T(*p); });
+		else
+			return accumulate(first, last, TinySTL::move(init), op);
+	}
+
+	template <class InputIter, class T>
+	T reduce(InputIter first, InputIter last, T init)
+	{
+		return TinySTL::reduce(first, last, TinySTL::move(init), plus<>());
+	}
+
+	template <class InputIter>
+	typename iterator_traits<InputIter>::value_type
+	reduce(InputIter first, InputIter last)
+	{
+		using T = typename iterator_traits<InputIter>::value_type;
+		return TinySTL::reduce(first, last, T(), plus<>());
+	}
+
+	/* reduce over transform(*first) */
+	template <class InputIter, class T, class BinaryOperation, class UnaryOperation>
+	T transform_reduce(InputIter first, InputIter last, T init,
+					   BinaryOperation reduce_op, UnaryOperation transform)
+	{
+		if constexpr (_reduce_lanes_able<InputIter, T, BinaryOperation>)
+			return _reduce_lanes(first, last, init,
+								 [&transform](InputIter p) { return T(transform(*p)); });
+		else
+		{
+			for (; first != last; ++first)
+				init = reduce_op(TinySTL::move(init), transform(*first));
+			return init;
+		}
+	}
+
+	/* reduce over transform(*first1, *first2) */
+	template <class InputIter1, class InputIter2, class T,
+			  class BinaryOperation1, class BinaryOperation2>
+	T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+					   BinaryOperation1 reduce_op, BinaryOperation2 transform)
+	{
+		if constexpr (_reduce_lanes_able<InputIter1, T, BinaryOperation1> &&
+					  std::is_pointer_v<InputIter2>)
+			return _reduce_lanes(first1, last1, init,
+								 [&transform, first1, first2](InputIter1 p)
+								 { return T(transform(*p, first2[p - first1])); });
+		else
+		{
+			for (; first1 != last1; ++first1, ++first2)
+				init = reduce_op(TinySTL::move(init), transform(*first1, *first2));
+			return init;
+		}
+	}
+
+	/* the dot product, in any order */
+	template <class InputIter1, class InputIter2, class T>
+	T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init)
+	{
+		return TinySTL::transform_reduce(first1, last1, first2, TinySTL::move(init),
+										 plus<>(), multiplies<>());
+	}
+
+	/* the transform of the scans without one */
+	struct _identity
+	{
+		template <class T>
+		T&& operator()(T&& x) const noexcept
+			{ return TinySTL::forward<T>(x); }
+	};
+
+	/*
+		T* ranges of integers (not bool) summed into the same type : the running
+		sums of xsimd.h, computed a vector at a time
+	*/
+	template <class InputIter, class OutputIter, class T, class BinaryOperation>
+	constexpr bool _simd_scan_able =
+		_simd_pointer_to<InputIter, T> && _simd_pointer_to<OutputIter, T> &&
+		!std::is_const_v<std::remove_pointer_t<OutputIter> > &&
+		std::is_integral_v<T> && !std::is_same_v<std::remove_cv_t<T>, bool> &&
+		(std::is_same_v<BinaryOperation, plus<> > || std::is_same_v<BinaryOperation, plus<T> >);
+
+	/*
+		running "sums" : *d_first = op(init, *first), *(d_first + 1) = op(that, *(first + 1)) ...
+		-op has to be associative, it is applied in order here.
+		-d_first may be first.
+	*/
+	template <class InputIter, class OutputIter, class BinaryOperation, class T>
+	OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter d_first,
+							  BinaryOperation op, T init)
+	{
+		if constexpr (_simd_scan_able<InputIter, OutputIter, T, BinaryOperation>)
+		{
+			if (_simd_worth(first, last))
+			{
+				_simd_scan(first, last, d_first, _simd_kind_of<T>, &init, false);
+				return d_first + (last - first);
+			}
+		}
+		for (; first != last; ++first, ++d_first)
+		{
+			init = op(TinySTL::move(init), *first);
+			*d_first = init;
+		}
+		return d_first;
+	}
+
+	/* the first element starts the sums */
+	template <class InputIter, class OutputIter, class BinaryOperation>
+	OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter d_first,
+							  BinaryOperation op)
+	{
+		if (first == last)
+			return d_first;
+		typename iterator_traits<InputIter>::value_type init = *first;
+		*d_first = init;
+		return TinySTL::inclusive_scan(++first, last, ++d_first, op, TinySTL::move(init));
+	}
+
+	template <class InputIter, class OutputIter>
+	OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter d_first)
+	{
+		return TinySTL::inclusive_scan(first, last, d_first, plus<>());
+	}
+
+	/* *d_first = init, *(d_first + 1) = op(init, *first) ... the last element isn't added */
+	template <class InputIter, class OutputIter, class T, class BinaryOperation>
+	OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter d_first,
+							  T init, BinaryOperation op)
+	{
+		if constexpr (_simd_scan_able<InputIter, OutputIter, T, BinaryOperation>)
+		{
+			if (_simd_worth(first, last))
+			{
+				_simd_scan(first, last, d_first, _simd_kind_of<T>, &init, true);
+				return d_first + (last - first);
+			}
+		}
+		for (; first != last; ++first, ++d_first)
+		{
+			T next = op(init, *first); // before *d_first is written, d_first may be first
+			*d_first = TinySTL::move(init);
+			init = TinySTL::move(next);
+		}
+		return d_first;
+	}
+
+	template <class InputIter, class OutputIter, class T>
+	OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter d_first, T init)
+	{
+		return TinySTL::exclusive_scan(first, last, d_first, TinySTL::move(init), plus<>());
+	}
+
+	/* inclusive_scan over transform(*first) */
+	template <class InputIter, class OutputIter, class BinaryOperation, class UnaryOperation, class T>
+	OutputIter transform_inclusive_scan(InputIter first, InputIter last, OutputIter d_first,
+										BinaryOperation op, UnaryOperation transform, T init)
+	{
+		if constexpr (std::is_same_v<UnaryOperation, _identity>)
+			return TinySTL::inclusive_scan(first, last, d_first, op, TinySTL::move(init));
+		else
+		{
+			for (; first != last; ++first, ++d_first)
+			{
+				init = op(TinySTL::move(init), transform(*first));
+				*d_first = init;
+			}
+			return d_first;
+		}
+	}
+
+	template <class InputIter, class OutputIter, class BinaryOperation, class UnaryOperation>
+	OutputIter transform_inclusive_scan(InputIter first, InputIter last, OutputIter d_first,
+										BinaryOperation op, UnaryOperation transform)
+	{
+		if (first == last)
+			return d_first;
+		auto init = transform(*first);
+		*d_first = init;
+		return TinySTL::transform_inclusive_scan(++first, last, ++d_first, op, transform,
+												 TinySTL::move(init));
+	}
+
+	/* exclusive_scan over transform(*first) */
+	template <class InputIter, class OutputIter, class T, class BinaryOperation, class UnaryOperation>
+	OutputIter transform_exclusive_scan(InputIter first, InputIter last, OutputIter d_first,
+										T init, BinaryOperation op, UnaryOperation transform)
+	{
+		if constexpr (std::is_same_v<UnaryOperation, _identity>)
+			return TinySTL::exclusive_scan(first, last, d_first, TinySTL::move(init), op);
+		else
+		{
+			for (; first != last; ++first, ++d_first)
+			{
+				T next = op(init, transform(*first));
+				*d_first = TinySTL::move(init);
+				init = TinySTL::move(next);
+			}
+			return d_first;
+		}
+	}
+}
+
+#endif /* _TINYSTL_NUMERIC_H_ */
@@ -0,0 +1,939 @@
+#pragma once
+#ifndef _TINYSTL_PARALLEL_ALGORITHM_H_
+#define _TINYSTL_PARALLEL_ALGORITHM_H_
+
+#include <atomic>      // std::atomic
+#include <cstdint>     // uint8_t, uint64_t
+#include <new>         // placement new
+#include <type_traits> // std::decay_t, std::is_base_of_v
+
+#include "algorithm.h"
+#include "alloc.h"
+#include "allocator.h"
+#include "execution.h"
+#include "iterator.h"
+#include "numeric.h"
+#include "random.h"
+#include "thread_pool.h"
+#include "utility.h"
+
+namespace TinySTL
+{
+	/* ranges shorter than that are not worth a task, they are sorted sequentially */
+	enum { PARALLEL_SORT_CUTOFF = 1 << 14 };
+
+	/* samples drawn per bucket when picking the splitters */
+	enum { SAMPLESORT_OVERSAMPLING = 32 };
+
+	/* bucket ids (2 per splitter + 1) fit in a byte */
+	enum { SAMPLESORT_MAX_SPLITTERS = 127 };
+
+	/* the least elements per chunk of a parallel scan, it only streams through memory */
+	enum { PARALLEL_SCAN_CUTOFF = 1 << 16 };
+
+	/* the least elements per chunk of a parallel shuffle */
+	enum { PARALLEL_SHUFFLE_CUTOFF = 1 << 16 };
+
+	/* bucket ids of a parallel shuffle fit in a byte */
+	enum { PARALLEL_SHUFFLE_MAX_CHUNKS = 256 };
+
+	/* the least elements per chunk of the loops run under an execution policy */
+	enum { PARALLEL_LOOP_CUTOFF = 1 << 12 };
+
+	/* elements a chunk of a parallel search goes through between two looks at the others */
+	enum { PARALLEL_FIND_BLOCK = 1 << 10 };
+
+	/*
+		raw scratch array shared by the tasks of a parallel algorithm
+		(from the locked pool : large ones end up in malloc anyway),
+		constructing and destroying elements is up to the user
+	*/
+	template <class T>
+	class _parallel_buffer
+	{
+	protected:
+		using data_allocator = simple_alloc<T, locked_alloc_template>;
+
+	public:
+		T*     data;
+		size_t size;
+
+		explicit _parallel_buffer(size_t n)
+			:data(data_allocator::allocate(n)), size(n) {}
+		~_parallel_buffer()
+			{ data_allocator::deallocate(data, size); }
+
+		_parallel_buffer(const _parallel_buffer&) = delete;
+		_parallel_buffer& operator=(const _parallel_buffer&) = delete;
+
+		T& operator[](size_t i) { return data[i]; }
+	};
+
+	/*
+		the elements of a _parallel_buffer built so far, by tasks in any order :
+		those are destroyed however the algorithm ends
+	*/
+	template <class T>
+	class _parallel_built
+	{
+	protected:
+		_parallel_buffer<T>&      buffer;
+		_parallel_buffer<uint8_t> built;
+
+	public:
+		explicit _parallel_built(_parallel_buffer<T>& b)
+			:buffer(b), built(b.size)
+		{
+			for (size_t i = 0; i != b.size; ++i)
+				built[i] = 0;
+		}
+		~_parallel_built()
+		{
+			for (size_t i = 0; i != buffer.size; ++i)
+				if (built[i])
+					buffer[i].~T();
+		}
+
+		_parallel_built(const _parallel_built&) = delete;
+		_parallel_built& operator=(const _parallel_built&) = delete;
+
+		template <class... Args>
+		void construct(size_t i, Args&&... args)
+		{
+			::new(static_cast<void*>(buffer.data + i)) T(TinySTL::forward<Args>(args)...);
+			built[i] = 1;
+		}
+	};
+
+	/*
+		parallel samplesort
+		-sort a random sample and pick splitter_count distinct splitters,
+		 every splitter s gets a bucket of its own for the elements equivalent
+		 to s : those need no sorting, so heavy duplicates don't pile up in
+		 a single bucket.
+		-tasks classify chunks of the input (bucket ids in a byte per element),
+		 a prefix sum of the per chunk counts gives every (chunk, bucket) its
+		 place in a scratch buffer, the tasks then scatter their chunks there.
+		-every bucket is sorted by its own task and moved back.
+		-comp and the move operations of T shall not throw.
+	*/
+	template <class RandomIter, class Compare>
+	void _samplesort(RandomIter first, RandomIter last, Compare comp,
+					 size_t splitter_count, thread_pool& pool)
+	{
+		using T        = typename iterator_traits<RandomIter>::value_type;
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		const size_t n = size_t(last - first);
+
+		_parallel_buffer<T> splitters(splitter_count);
+		size_t k = 0;
+		{
+			const size_t m = (splitter_count + 1) * SAMPLESORT_OVERSAMPLING;
+			_parallel_buffer<T> sample(m);
+			uint64_t seed = n;
+			for (size_t i = 0; i != m; ++i)
+			{
+				seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+				::new(static_cast<void*>(sample.data + i))
+					T(*(first + Distance((seed >> 16) % n)));
+			}
+			TinySTL::sort(sample.data, sample.data + m, comp);
+			for (size_t i = 1; i <= splitter_count; ++i)
+			{
+				const T& s = sample[i * SAMPLESORT_OVERSAMPLING];
+				if (k == 0 || comp(splitters[k - 1], s))
+					::new(static_cast<void*>(splitters.data + k++)) T(s);
+			}
+			for (size_t i = 0; i != m; ++i)
+				sample[i].~T();
+		}
+
+		/* 2j : between splitters j-1 and j, 2j+1 : equivalent to splitter j */
+		const size_t buckets = 2 * k + 1;
+		auto classify = [&](const T& x) -> uint8_t
+		{
+			size_t lo = 0, hi = k;
+			while (lo < hi)
+			{
+				size_t mid = (lo + hi) / 2;
+				if (comp(x, splitters[mid]))hi = mid;
+				else lo = mid + 1;
+			}
+			if (lo != 0 && !comp(splitters[lo - 1], x))
+				return uint8_t(2 * lo - 1);
+			return uint8_t(2 * lo);
+		};
+
+		const size_t chunks = TinySTL::max(size_t(1),
+			TinySTL::min(pool.concurrency() * 4, n / PARALLEL_SORT_CUTOFF));
+		auto chunk_begin = [&](size_t c) { return n / chunks * c + TinySTL::min(c, n % chunks); };
+
+		_parallel_buffer<uint8_t> ids(n);
+		_parallel_buffer<size_t>  offsets(chunks * buckets); // counts, then offsets
+		_parallel_buffer<size_t>  bucket_begin(buckets + 1);
+		_parallel_buffer<T>       buffer(n);
+		task_group group(pool);
+
+		for (size_t c = 0; c != chunks; ++c)
+			group.run([&, c]
+			{
+				size_t* count = offsets.data + c * buckets;
+				for (size_t b = 0; b != buckets; ++b)
+					count[b] = 0;
+				for (size_t i = chunk_begin(c), e = chunk_begin(c + 1); i != e; ++i)
+					++count[ids[i] = classify(*(first + Distance(i)))];
+			});
+		group.wait();
+
+		size_t sum = 0;
+		for (size_t b = 0; b != buckets; ++b)
+		{
+			bucket_begin[b] = sum;
+			for (size_t c = 0; c != chunks; ++c)
+			{
+				size_t count = offsets[c * buckets + b];
+				offsets[c * buckets + b] = sum;
+				sum += count;
+			}
+		}
+		bucket_begin[buckets] = sum;
+
+		for (size_t c = 0; c != chunks; ++c)
+			group.run([&, c]
+			{
+				size_t* offset = offsets.data + c * buckets;
+				for (size_t i = chunk_begin(c), e = chunk_begin(c + 1); i != e; ++i)
+					::new(static_cast<void*>(buffer.data + offset[ids[i]]++))
+						T(TinySTL::move(*(first + Distance(i))));
+			});
+		group.wait();
+
+		for (size_t b = 0; b != buckets; ++b)
+			group.run([&, b]
+			{
+				T* p = buffer.data + bucket_begin[b];
+				T* e = buffer.data + bucket_begin[b + 1];
+				if (b % 2 == 0)
+					TinySTL::sort(p, e, comp);
+				for (RandomIter out = first + Distance(bucket_begin[b]); p != e; ++p, ++out)
+				{
+					*out = TinySTL::move(*p);
+					p->~T();
+				}
+			});
+		group.wait();
+
+		for (size_t i = 0; i != k; ++i)
+			splitters[i].~T();
+	}
+
+	/*
+		sorts on the default thread_pool (samplesort, see above),
+		falls back to sort() for small ranges or without worker threads.
+		not stable.
+	*/
+	template <class RandomIter>
+	void parallel_sort(RandomIter first, RandomIter last)
+	{
+		parallel_sort(first, last, less<>());
+	}
+
+	template <class RandomIter, class Compare>
+	void parallel_sort(RandomIter first, RandomIter last, Compare comp)
+	{
+		thread_pool& pool = thread_pool::default_pool();
+		const size_t n = size_t(last - first);
+		size_t splitters = TinySTL::min(pool.concurrency() * 8, n / PARALLEL_SORT_CUTOFF);
+		splitters = TinySTL::min(splitters, size_t(SAMPLESORT_MAX_SPLITTERS));
+		if (pool.concurrency() == 1 || splitters < 2)
+			TinySTL::sort(first, last, comp);
+		else
+			_samplesort(first, last, comp, splitters, pool);
+	}
+
+	/*
+		co-ranking (merge path, Odeh et al. 2012) : how many of the first diag
+		elements of the stable merge of [first1, first1 + n1) and
+		[first2, first2 + n2) come from the first range (which wins ties).
+		O(log) compares, so the output of a merge can be cut into equal
+		pieces merged independently.
+	*/
+	template <class Iter1, class Iter2, class Distance, class Compare>
+	Distance _merge_path(Iter1 first1, Distance n1, Iter2 first2, Distance n2,
+						 Distance diag, Compare comp)
+	{
+		Distance lo = diag > n2 ? diag - n2 : 0;
+		Distance hi = diag < n1 ? diag : n1;
+		while (lo < hi)
+		{
+			Distance mid = lo + (hi - lo) / 2;
+			if (comp(*(first2 + (diag - mid - 1)), *(first1 + mid)))hi = mid;
+			else lo = mid + 1;
+		}
+		return lo;
+	}
+
+	/* stable merge moving the elements, into raw memory if Construct */
+	template <bool Construct, class Iter1, class Iter2, class OutputIter, class Compare>
+	void _move_merge(Iter1 first1, Iter1 last1, Iter2 first2, Iter2 last2,
+					 OutputIter result, Compare comp)
+	{
+		using T = typename iterator_traits<OutputIter>::value_type;
+		auto put = [&](auto& val)
+		{
+			if constexpr (Construct)
+				::new(static_cast<void*>(&*result)) T(TinySTL::move(val));
+			else
+				*result = TinySTL::move(val);
+			++result;
+		};
+		while (first1 != last1 && first2 != last2)
+		{
+			if (comp(*first2, *first1))put(*first2++);
+			else put(*first1++);
+		}
+		for (; first1 != last1; ++first1)
+			put(*first1);
+		for (; first2 != last2; ++first2)
+			put(*first2);
+	}
+
+	/*
+		one round of the parallel mergesort : merges the sorted chunks
+		2k and 2k + 1 (of width chunks each, bounds[] in elements) from src
+		to dst, every merge cut into pieces of about grain elements.
+	*/
+	template <bool Construct, class SrcIter, class DstIter, class Compare>
+	void _merge_round(SrcIter src, DstIter dst, const size_t* bounds, size_t chunks,
+					  size_t width, size_t grain, Compare comp, task_group& group)
+	{
+		using Distance = ptrdiff_t;
+		for (size_t c = 0; c < chunks; c += 2 * width)
+		{
+			const Distance lo  = Distance(bounds[c]);
+			const Distance mid = Distance(bounds[TinySTL::min(c + width, chunks)]);
+			const Distance hi  = Distance(bounds[TinySTL::min(c + 2 * width, chunks)]);
+			const Distance pieces = TinySTL::max(Distance(1), (hi - lo) / Distance(grain));
+			for (Distance p = 0; p != pieces; ++p)
+				group.run([=]
+				{
+					const Distance n1 = mid - lo, n2 = hi - mid;
+					const Distance d0 = (hi - lo) * p / pieces;
+					const Distance d1 = (hi - lo) * (p + 1) / pieces;
+					const Distance i0 = _merge_path(src + lo, n1, src + mid, n2, d0, comp);
+					const Distance i1 = _merge_path(src + lo, n1, src + mid, n2, d1, comp);
+					_move_merge<Construct>(src + (lo + i0), src + (lo + i1),
+										   src + (mid + d0 - i0), src + (mid + d1 - i1),
+										   dst + (lo + d0), comp);
+				});
+		}
+		group.wait();
+	}
+
+	/*
+		parallel stable mergesort
+		-the range is cut into chunks sorted by stable_sort in parallel
+		 (each worker with its own temporary_buffer).
+		-the chunks are then merged pairwise, back and forth between the range
+		 and a scratch buffer. every merge is cut by _merge_path into pieces of
+		 equal size, so the last rounds, with few and long merges, still keep
+		 every thread busy.
+		-comp and the move operations of T shall not throw.
+	*/
+	template <class RandomIter, class Compare>
+	void _parallel_stable_sort(RandomIter first, RandomIter last, Compare comp,
+							   size_t chunks, thread_pool& pool)
+	{
+		using T        = typename iterator_traits<RandomIter>::value_type;
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		const size_t n = size_t(last - first);
+
+		_parallel_buffer<size_t> bounds(chunks + 1);
+		for (size_t c = 0; c <= chunks; ++c)
+			bounds[c] = n / chunks * c + TinySTL::min(c, n % chunks);
+
+		task_group group(pool);
+		for (size_t c = 0; c != chunks; ++c)
+			group.run([&, c]
+			{
+				TinySTL::stable_sort(first + Distance(bounds[c]),
+									 first + Distance(bounds[c + 1]), comp);
+			});
+		group.wait();
+
+		_parallel_buffer<T> buffer(n);
+		const size_t grain = TinySTL::max(size_t(PARALLEL_SORT_CUTOFF),
+										  n / (pool.concurrency() * 4));
+		bool in_buffer = false;
+		for (size_t width = 1; width < chunks; width *= 2)
+		{
+			if (in_buffer)
+				_merge_round<false>(buffer.data, first, bounds.data, chunks,
+									width, grain, comp, group);
+			else if (width == 1) // the buffer is raw memory before the first round
+				_merge_round<true>(first, buffer.data, bounds.data, chunks,
+								   width, grain, comp, group);
+			else
+				_merge_round<false>(first, buffer.data, bounds.data, chunks,
+									width, grain, comp, group);
+			in_buffer = !in_buffer;
+		}
+
+		for (size_t begin = 0; begin < n; begin += grain)
+			group.run([&, begin]
+			{
+				T* p = buffer.data + begin;
+				T* e = buffer.data + TinySTL::min(begin + grain, n);
+				for (RandomIter out = first + Distance(begin); p != e; ++p, ++out)
+				{
+					if (in_buffer)
+						*out = TinySTL::move(*p);
+					p->~T();
+				}
+			});
+		group.wait();
+	}
+
+	/*
+		stable sort on the default thread_pool (mergesort, see above),
+		falls back to stable_sort() for small ranges or without worker threads.
+	*/
+	template <class RandomIter>
+	void parallel_stable_sort(RandomIter first, RandomIter last)
+	{
+		parallel_stable_sort(first, last, less<>());
+	}
+
+	template <class RandomIter, class Compare>
+	void parallel_stable_sort(RandomIter first, RandomIter last, Compare comp)
+	{
+		thread_pool& pool = thread_pool::default_pool();
+		const size_t chunks = TinySTL::min(pool.concurrency() * 2,
+										   size_t(last - first) / PARALLEL_SORT_CUTOFF);
+		if (pool.concurrency() == 1 || chunks < 2)
+			TinySTL::stable_sort(first, last, comp);
+		else
+			_parallel_stable_sort(first, last, comp, chunks, pool);
+	}
+
+	/* merge() cut by _merge_path into equal pieces, one task each */
+	template <class RandomIter1, class RandomIter2, class RandomIter3, class Compare>
+	RandomIter3 _parallel_merge(RandomIter1 first1, RandomIter1 last1,
+								RandomIter2 first2, RandomIter2 last2,
+								RandomIter3 result, Compare comp,
+								size_t pieces, thread_pool& pool)
+	{
+		using Distance = ptrdiff_t;
+		const Distance n1 = Distance(last1 - first1), n2 = Distance(last2 - first2);
+		const Distance n  = n1 + n2;
+		task_group group(pool);
+		for (Distance p = 0; p != Distance(pieces); ++p)
+			group.run([=]
+			{
+				const Distance d0 = n * p / Distance(pieces);
+				const Distance d1 = n * (p + 1) / Distance(pieces);
+				const Distance i0 = _merge_path(first1, n1, first2, n2, d0, comp);
+				const Distance i1 = _merge_path(first1, n1, first2, n2, d1, comp);
+				TinySTL::merge(first1 + i0, first1 + i1,
+							   first2 + (d0 - i0), first2 + (d1 - i1),
+							   result + d0, comp);
+			});
+		group.wait();
+		return result + n;
+	}
+
+	/*
+		merge() on the default thread_pool, every thread merges an equal share
+		of the output. stable, all iterators random access.
+	*/
+	template <class RandomIter1, class RandomIter2, class RandomIter3>
+	RandomIter3 parallel_merge(RandomIter1 first1, RandomIter1 last1,
+							   RandomIter2 first2, RandomIter2 last2,
+							   RandomIter3 result)
+	{
+		return parallel_merge(first1, last1, first2, last2, result, less<>());
+	}
+
+	template <class RandomIter1, class RandomIter2, class RandomIter3, class Compare>
+	RandomIter3 parallel_merge(RandomIter1 first1, RandomIter1 last1,
+							   RandomIter2 first2, RandomIter2 last2,
+							   RandomIter3 result, Compare comp)
+	{
+		thread_pool& pool = thread_pool::default_pool();
+		const size_t n = size_t(last1 - first1) + size_t(last2 - first2);
+		const size_t pieces = TinySTL::min(pool.concurrency() * 4, n / PARALLEL_SORT_CUTOFF);
+		if (pool.concurrency() == 1 || pieces < 2)
+			return TinySTL::merge(first1, last1, first2, last2, result, comp);
+		return _parallel_merge(first1, last1, first2, last2, result, comp, pieces, pool);
+	}
+
+	/*
+		reduce-then-scan : the range is cut into chunks,
+		-every chunk but the last is reduced by its own task,
+		-the sums are scanned sequentially into the carry of every chunk,
+		-every chunk is scanned by its own task, starting from its carry.
+		op has to be associative; each element is read twice (transformed
+		twice), d_first may be first.
+	*/
+	template <class RandomIter1, class RandomIter2, class T,
+			  class BinaryOperation, class UnaryOperation>
+	RandomIter2 _parallel_scan(RandomIter1 first, RandomIter1 last, RandomIter2 d_first,
+							   T init, BinaryOperation op, UnaryOperation transform,
+							   bool exclusive, size_t chunks, thread_pool& pool)
+	{
+		using Distance = ptrdiff_t;
+		const size_t n = size_t(last - first);
+		auto chunk_begin = [&](size_t c) { return Distance(n / chunks * c + TinySTL::min(c, n % chunks)); };
+
+		/* carries[c + 1] : the sum of chunk c, then of everything before chunk c + 1 */
+		_parallel_buffer<T> carries(chunks);
+		_parallel_built<T>  built(carries); // before group : its tasks are joined first
+		task_group group(pool);
+		for (size_t c = 0; c + 1 != chunks; ++c)
+			group.run([&, c]
+			{
+				RandomIter1 p = first + chunk_begin(c), e = first + chunk_begin(c + 1);
+				T sum = transform(*p);
+				if constexpr (std::is_same_v<UnaryOperation, _identity>)
+					sum = TinySTL::reduce(++p, e, TinySTL::move(sum), op);
+				else
+					for (++p; p != e; ++p)
+						sum = op(TinySTL::move(sum), transform(*p));
+				built.construct(c + 1, TinySTL::move(sum));
+			});
+		group.wait();
+
+		built.construct(0, TinySTL::move(init));
+		for (size_t c = 1; c != chunks; ++c)
+			carries[c] = op(carries[c - 1], carries[c]);
+
+		for (size_t c = 0; c != chunks; ++c)
+			group.run([&, c]
+			{
+				const Distance b = chunk_begin(c), e = chunk_begin(c + 1);
+				if (exclusive)
+					TinySTL::transform_exclusive_scan(first + b, first + e, d_first + b,
+													  carries[c], op, transform);
+				else
+					TinySTL::transform_inclusive_scan(first + b, first + e, d_first + b,
+													  op, transform, carries[c]);
+			});
+		group.wait();
+		return d_first + Distance(n);
+	}
+
+	/* chunks for a parallel scan of n elements, < 2 meaning sequential */
+	inline size_t _parallel_scan_chunks(size_t n, thread_pool& pool)
+	{
+		if (pool.concurrency() == 1)
+			return 1;
+		return TinySTL::min(pool.concurrency() * 4, n / PARALLEL_SCAN_CUTOFF);
+	}
+
+	/*
+		inclusive_scan() / exclusive_scan() / transform_inclusive_scan() on the
+		default thread_pool (reduce-then-scan, see above), sequential for small
+		ranges or without worker threads. random access iterators, op associative.
+	*/
+	template <class RandomIter1, class RandomIter2, class BinaryOperation,
+			  class UnaryOperation, class T>
+	RandomIter2 parallel_transform_inclusive_scan(RandomIter1 first, RandomIter1 last,
+												  RandomIter2 d_first, BinaryOperation op,
+												  UnaryOperation transform, T init)
+	{
+		thread_pool& pool = thread_pool::default_pool();
+		const size_t chunks = _parallel_scan_chunks(size_t(last - first), pool);
+		if (chunks < 2)
+			return TinySTL::transform_inclusive_scan(first, last, d_first, op, transform,
+													 TinySTL::move(init));
+		return _parallel_scan(first, last, d_first, TinySTL::move(init), op, transform,
+							  false, chunks, pool);
+	}
+
+	/* the first element starts the sums */
+	template <class RandomIter1, class RandomIter2, class BinaryOperation, class UnaryOperation>
+	RandomIter2 parallel_transform_inclusive_scan(RandomIter1 first, RandomIter1 last,
+												  RandomIter2 d_first, BinaryOperation op,
+												  UnaryOperation transform)
+	{
+		if (first == last)
+			return d_first;
+		auto init = transform(*first);
+		*d_first = init;
+		return parallel_transform_inclusive_scan(first + 1, last, d_first + 1, op, transform,
+												 TinySTL::move(init));
+	}
+
+	template <class RandomIter1, class RandomIter2, class BinaryOperation, class T>
+	RandomIter2 parallel_inclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 d_first,
+										BinaryOperation op, T init)
+	{
+		return parallel_transform_inclusive_scan(first, last, d_first, op, _identity(),
+												 TinySTL::move(init));
+	}
+
+	template <class RandomIter1, class RandomIter2, class BinaryOperation>
+	RandomIter2 parallel_inclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 d_first,
+										BinaryOperation op)
+	{
+		return parallel_transform_inclusive_scan(first, last, d_first, op, _identity());
+	}
+
+	template <class RandomIter1, class RandomIter2>
+	RandomIter2 parallel_inclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 d_first)
+	{
+		return parallel_transform_inclusive_scan(first, last, d_first, plus<>(), _identity());
+	}
+
+	template <class RandomIter1, class RandomIter2, class T, class BinaryOperation>
+	RandomIter2 parallel_exclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 d_first,
+										T init, BinaryOperation op)
+	{
+		thread_pool& pool = thread_pool::default_pool();
+		const size_t chunks = _parallel_scan_chunks(size_t(last - first), pool);
+		if (chunks < 2)
+			return TinySTL::exclusive_scan(first, last, d_first, TinySTL::move(init), op);
+		return _parallel_scan(first, last, d_first, TinySTL::move(init), op, _identity(),
+							  true, chunks, pool);
+	}
+
+	template <class RandomIter1, class RandomIter2, class T>
+	RandomIter2 parallel_exclusive_scan(RandomIter1 first, RandomIter1 last, RandomIter2 d_first,
+										T init)
+	{
+		return parallel_exclusive_scan(first, last, d_first, TinySTL::move(init), plus<>());
+	}
+	/*
+		parallel shuffle (Sanders, "Random Permutations on Distributed,
+		External and Hierarchical Memory", 1998)
+		-every element draws one of chunks buckets, uniformly : the tasks
+		 count the draws of their chunk and scatter it into a scratch buffer
+		 by a prefix sum of the counts, as _samplesort does.
+		-every bucket is then shuffled by its own task while moving back
+		 (inside-out Fisher-Yates). the sizes of the buckets being those of
+		 uniform draws, the permutation is uniform.
+		-task i draws from a xoshiro256** jumped i times from seed : the
+		 result only depends on seed and chunks, not on the scheduling.
+		-the move operations of T shall not throw.
+	*/
+	template <class RandomIter>
+	void _parallel_shuffle(RandomIter first, RandomIter last, uint64_t seed,
+						   size_t chunks, thread_pool& pool)
+	{
+		using T        = typename iterator_traits<RandomIter>::value_type;
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		const size_t n = size_t(last - first);
+		const size_t buckets = chunks;
+		auto chunk_begin = [&](size_t c) { return n / chunks * c + TinySTL::min(c, n % chunks); };
+
+		_parallel_buffer<xoshiro256ss> streams(chunks + buckets);
+		{
+			xoshiro256ss gen(seed);
+			for (size_t i = 0; i != chunks + buckets; ++i, gen.jump())
+				::new(static_cast<void*>(streams.data + i)) xoshiro256ss(gen);
+		}
+
+		_parallel_buffer<uint8_t> ids(n);
+		_parallel_buffer<size_t>  offsets(chunks * buckets); // counts, then offsets
+		_parallel_buffer<size_t>  bucket_begin(buckets + 1);
+		_parallel_buffer<T>       buffer(n);
+		task_group group(pool);
+
+		for (size_t c = 0; c != chunks; ++c)
+			group.run([&, c]
+			{
+				xoshiro256ss& gen = streams[c];
+				size_t* count = offsets.data + c * buckets;
+				for (size_t b = 0; b != buckets; ++b)
+					count[b] = 0;
+				for (size_t i = chunk_begin(c), e = chunk_begin(c + 1); i != e; ++i)
+					++count[ids[i] = uint8_t(random_below(gen, buckets))];
+			});
+		group.wait();
+
+		size_t sum = 0;
+		for (size_t b = 0; b != buckets; ++b)
+		{
+			bucket_begin[b] = sum;
+			for (size_t c = 0; c != chunks; ++c)
+			{
+				size_t count = offsets[c * buckets + b];
+				offsets[c * buckets + b] = sum;
+				sum += count;
+			}
+		}
+		bucket_begin[buckets] = sum;
+
+		for (size_t c = 0; c != chunks; ++c)
+			group.run([&, c]
+			{
+				size_t* offset = offsets.data + c * buckets;
+				for (size_t i = chunk_begin(c), e = chunk_begin(c + 1); i != e; ++i)
+					::new(static_cast<void*>(buffer.data + offset[ids[i]]++))
+						T(TinySTL::move(*(first + Distance(i))));
+			});
+		group.wait();
+
+		for (size_t b = 0; b != buckets; ++b)
+			group.run([&, b]
+			{
+				xoshiro256ss& gen = streams[chunks + b];
+				T* p = buffer.data + bucket_begin[b];
+				RandomIter out = first + Distance(bucket_begin[b]);
+				const size_t m = bucket_begin[b + 1] - bucket_begin[b];
+				for (size_t j = 0; j != m; ++j)
+				{
+					const size_t k = size_t(random_below(gen, uint64_t(j) + 1));
+					if (k != j)
+						out[Distance(j)] = TinySTL::move(out[Distance(k)]);
+					out[Distance(k)] = TinySTL::move(p[j]);
+					p[j].~T();
+				}
+			});
+		group.wait();
+	}
+
+	/*
+		shuffles on the default thread_pool (see above), the seed drawn from
+		gen, falls back to shuffle() for small ranges or without worker
+		threads. the result differs from shuffle()'s with the same gen.
+	*/
+	template <class RandomIter, class URNG>
+	void parallel_shuffle(RandomIter first, RandomIter last, URNG&& gen)
+	{
+		thread_pool& pool = thread_pool::default_pool();
+		size_t chunks = TinySTL::min(pool.concurrency() * 4,
+									 size_t(last - first) / PARALLEL_SHUFFLE_CUTOFF);
+		chunks = TinySTL::min(chunks, size_t(PARALLEL_SHUFFLE_MAX_CHUNKS));
+		if (pool.concurrency() == 1 || chunks < 2)
+			TinySTL::shuffle(first, last, gen);
+		else
+			_parallel_shuffle(first, last, random_below(gen, UINT64_MAX), chunks, pool);
+	}
+	/* the overloads below taking an ExecutionPolicy, see execution.h */
+	template <class ExecutionPolicy, class T>
+	using _enable_if_execution_policy = enable_if_t<is_execution_policy_v<std::decay_t<ExecutionPolicy> >, T>;
+
+	/* the policy splits loops over these iterators into tasks */
+	template <class ExecutionPolicy, class... Iters>
+	constexpr bool _parallel_loop_able = _is_parallel_policy<ExecutionPolicy> &&
+		(std::is_base_of_v<random_access_iterator_tag,
+						   typename iterator_traits<Iters>::iterator_category> && ...);
+
+	/* chunks for a parallel loop over n elements, < 2 meaning sequential */
+	inline size_t _parallel_loop_chunks(size_t n, thread_pool& pool)
+	{
+		if (pool.concurrency() == 1)
+			return 1;
+		return TinySTL::min(pool.concurrency() * 4, n / PARALLEL_LOOP_CUTOFF);
+	}
+
+	/*
+		body(chunk_first, chunk_last, c) for the chunks c of [first, last) of
+		equal size, one task each. the first exception thrown by a body is
+		rethrown once they are all done.
+	*/
+	template <class RandomIter, class Body>
+	void _parallel_loop(RandomIter first, RandomIter last, size_t chunks,
+						thread_pool& pool, Body body)
+	{
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		const size_t n = size_t(last - first);
+		auto chunk_begin = [&](size_t c) { return first + Distance(n / chunks * c + TinySTL::min(c, n % chunks)); };
+
+		task_group group(pool);
+		for (size_t c = 0; c != chunks; ++c)
+			group.run([&, c] { body(chunk_begin(c), chunk_begin(c + 1), c); });
+		group.wait();
+	}
+
+	/*
+		find_if() over chunks : a chunk stops at its first match, after
+		publishing its position (the least one wins), and every
+		PARALLEL_FIND_BLOCK elements checks whether a match before it was
+		published already : then nothing it could find would be the first.
+	*/
+	template <class RandomIter, class UnaryPredicate>
+	RandomIter _parallel_find_if(RandomIter first, RandomIter last, UnaryPredicate pred,
+								 size_t chunks, thread_pool& pool)
+	{
+		using Distance = typename iterator_traits<RandomIter>::difference_type;
+		std::atomic<size_t> found(size_t(last - first));
+		_parallel_loop(first, last, chunks, pool, [&](RandomIter b, RandomIter e, size_t)
+		{
+			UnaryPredicate test(pred);
+			for (size_t i = size_t(b - first); b != e; )
+			{
+				if (found.load(std::memory_order_relaxed) < i)
+					return;
+				for (RandomIter block_end = e - b > PARALLEL_FIND_BLOCK ? b + PARALLEL_FIND_BLOCK : e;
+					 b != block_end; ++b, ++i)
+				{
+					if (test(*b))
+					{
+						size_t prev = found.load(std::memory_order_relaxed);
+						while (i < prev && !found.compare_exchange_weak(prev, i, std::memory_order_relaxed));
+						return;
+					}
+				}
+			}
+		});
+		return first + Distance(found.load(std::memory_order_relaxed));
+	}
+
+	template <class ExecutionPolicy, class ForwardIter, class Function>
+	_enable_if_execution_policy<ExecutionPolicy, void>
+	for_each(ExecutionPolicy&&, ForwardIter first, ForwardIter last, Function func)
+	{
+		if constexpr (_parallel_loop_able<ExecutionPolicy, ForwardIter>)
+		{
+			thread_pool& pool = thread_pool::default_pool();
+			const size_t chunks = _parallel_loop_chunks(size_t(last - first), pool);
+			if (chunks >= 2)
+			{
+				_parallel_loop(first, last, chunks, pool, [&](ForwardIter b, ForwardIter e, size_t)
+					{ TinySTL::for_each(b, e, func); });
+				return;
+			}
+		}
+		TinySTL::for_each(first, last, func);
+	}
+
+	template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class UnaryOperator>
+	_enable_if_execution_policy<ExecutionPolicy, ForwardIter2>
+	transform(ExecutionPolicy&&, ForwardIter1 first, ForwardIter1 last,
+			  ForwardIter2 d_first, UnaryOperator op)
+	{
+		if constexpr (_parallel_loop_able<ExecutionPolicy, ForwardIter1, ForwardIter2>)
+		{
+			thread_pool& pool = thread_pool::default_pool();
+			const size_t chunks = _parallel_loop_chunks(size_t(last - first), pool);
+			if (chunks >= 2)
+			{
+				_parallel_loop(first, last, chunks, pool, [&](ForwardIter1 b, ForwardIter1 e, size_t)
+					{ TinySTL::transform(b, e, d_first + (b - first), op); });
+				return d_first + (last - first);
+			}
+		}
+		return TinySTL::transform(first, last, d_first, op);
+	}
+
+	template <class ExecutionPolicy, class ForwardIter1, class ForwardIter2, class ForwardIter3,
+			  class BinaryOperator>
+	_enable_if_execution_policy<ExecutionPolicy, ForwardIter3>
+	transform(ExecutionPolicy&&, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2,
+			  ForwardIter3 d_first, BinaryOperator op)
+	{
+		if constexpr (_parallel_loop_able<ExecutionPolicy, ForwardIter1, ForwardIter2, ForwardIter3>)
+		{
+			thread_pool& pool = thread_pool::default_pool();
+			const size_t chunks = _parallel_loop_chunks(size_t(last1 - first1), pool);
+			if (chunks >= 2)
+			{
+				_parallel_loop(first1, last1, chunks, pool, [&](ForwardIter1 b, ForwardIter1 e, size_t)
+					{ TinySTL::transform(b, e, first2 + (b - first1), d_first + (b - first1), op); });
+				return d_first + (last1 - first1);
+			}
+		}
+		return TinySTL::transform(first1, last1, first2, d_first, op);
+	}
+
+	template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+	_enable_if_execution_policy<ExecutionPolicy, typename iterator_traits<ForwardIter>::difference_type>
+	count_if(ExecutionPolicy&&, ForwardIter first, ForwardIter last, UnaryPredicate pred)
+	{
+		using Distance = typename iterator_traits<ForwardIter>::difference_type;
+		if constexpr (_parallel_loop_able<ExecutionPolicy, ForwardIter>)
+		{
+			thread_pool& pool = thread_pool::default_pool();
+			const size_t chunks = _parallel_loop_chunks(size_t(last - first), pool);
+			if (chunks >= 2)
+			{
+				_parallel_buffer<Distance> counts(chunks);
+				_parallel_loop(first, last, chunks, pool, [&](ForwardIter b, ForwardIter e, size_t c)
+					{ counts[c] = TinySTL::count_if(b, e, pred); });
+				Distance sum = 0;
+				for (size_t c = 0; c != chunks; ++c)
+					sum += counts[c];
+				return sum;
+			}
+		}
+		return TinySTL::count_if(first, last, pred);
+	}
+
+	template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+	_enable_if_execution_policy<ExecutionPolicy, ForwardIter>
+	find_if(ExecutionPolicy&&, ForwardIter first, ForwardIter last, UnaryPredicate pred)
+	{
+		if constexpr (_parallel_loop_able<ExecutionPolicy, ForwardIter>)
+		{
+			thread_pool& pool = thread_pool::default_pool();
+			const size_t chunks = _parallel_loop_chunks(size_t(last - first), pool);
+			if (chunks >= 2)
+				return _parallel_find_if(first, last, pred, chunks, pool);
+		}
+		return TinySTL::find_if(first, last, pred);
+	}
+
+	template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+	_enable_if_execution_policy<ExecutionPolicy, bool>
+	any_of(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, UnaryPredicate pred)
+	{
+		return TinySTL::find_if(policy, first, last, pred) != last;
+	}
+
+	template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+	_enable_if_execution_policy<ExecutionPolicy, bool>
+	none_of(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, UnaryPredicate pred)
+	{
+		return TinySTL::find_if(policy, first, last, pred) == last;
+	}
+
+	template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate>
+	_enable_if_execution_policy<ExecutionPolicy, bool>
+	all_of(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, UnaryPredicate pred)
+	{
+		return TinySTL::find_if(policy, first, last,
+			[pred](const auto& x) mutable { return !pred(x); }) == last;
+	}
+
+	template <class ExecutionPolicy, class ForwardIter, class UnaryPredicate, class T>
+	_enable_if_execution_policy<ExecutionPolicy, void>
+	replace_if(ExecutionPolicy&&, ForwardIter first, ForwardIter last,
+			   UnaryPredicate pred, const T& new_value)
+	{
+		if constexpr (_parallel_loop_able<ExecutionPolicy, ForwardIter>)
+		{
+			thread_pool& pool = thread_pool::default_pool();
+			const size_t chunks = _parallel_loop_chunks(size_t(last - first), pool);
+			if (chunks >= 2)
+			{
+				_parallel_loop(first, last, chunks, pool, [&](ForwardIter b, ForwardIter e, size_t)
+					{ TinySTL::replace_if(b, e, pred, new_value); });
+				return;
+			}
+		}
+		TinySTL::replace_if(first, last, pred, new_value);
+	}
+
+	/* each chunk still goes through memset when fill() would */
+	template <class ExecutionPolicy, class ForwardIter, class T>
+	_enable_if_execution_policy<ExecutionPolicy, void>
+	fill(ExecutionPolicy&&, ForwardIter first, ForwardIter last, const T& val)
+	{
+		if constexpr (_parallel_loop_able<ExecutionPolicy, ForwardIter>)
+		{
+			thread_pool& pool = thread_pool::default_pool();
+			const size_t chunks = _parallel_loop_chunks(size_t(last - first), pool);
+			if (chunks >= 2)
+			{
+				_parallel_loop(first, last, chunks, pool, [&](ForwardIter b, ForwardIter e, size_t)
+					{ TinySTL::fill(b, e, val); });
+				return;
+			}
+		}
+		TinySTL::fill(first, last, val);
+	}
+}
+
+#endif /* _TINYSTL_PARALLEL_ALGORITHM_H_ */
\ No newline at end of file
@@ -109,6 +109,22 @@ namespace TinySTL
 
 	extern default_allocator_resource default_singleton;
 
+	/*
+		NOT the standard pool either : the small-object pool of alloc.h behind
+		its mutex (locked_alloc_template), for containers touched by several threads
+	*/
+	class synchronized_pool_resource :public memory_resource
+	{
+	protected:
+		void* do_allocate(size_t bytes, size_t /* align */)
+			{ return locked_alloc_template::allocate(bytes); }
+		void do_deallocate(void* ptr, size_t bytes, size_t /* align */)
+			{ locked_alloc_template::deallocate(ptr, bytes); }
+
+		bool do_is_equal(const memory_resource& other) const noexcept
+			{ return dynamic_cast<const synchronized_pool_resource*>(&other) != nullptr; }
+	};
+
 	template <class T>
 	class polymorphic_allocator
 	{
@@ -86,12 +86,18 @@ namespace TinySTL
 		size_type size()
 			{ return container.size(); }
 
-		void push(value_type val)
+		void push(const value_type& val)
 		{
 			container.push_back(val);
 			push_heap(container.begin(), container.end(), compare);
 		}
 
+		void push(value_type&& val)
+		{
+			container.push_back(TinySTL::move(val));
+			push_heap(container.begin(), container.end(), compare);
+		}
+
 		void pop()
 		{
 			pop_heap(container.begin(),container.end(),compare);
@@ -110,6 +116,51 @@ namespace TinySTL
 			TinySTL::swap(compare, other.compare);
 			container.swap(other.container);
 		}
+
+	public: // batch operations
+		/*
+			appends the whole range, then merges it into the heap :
+			-sifting the k new elements up one by one costs O(k log(n + k)),
+			-rebuilding the heap costs O(n + k),
+			 which wins as soon as the batch is about as large as the heap.
+		*/
+		template <class InputIter>
+		void push_range(InputIter first, InputIter last)
+		{
+			size_type old_size = container.size();
+			container.insert(container.end(), first, last);
+			size_type added = container.size() - old_size;
+			if (added >= old_size)
+				make_heap(container.begin(), container.end(), compare);
+			else
+			{
+				auto begin = container.begin();
+				for (size_type i = old_size + 1; i <= container.size(); ++i)
+					push_heap(begin, begin + i, compare);
+			}
+		}
+
+		/*
+			moves min(n, size()) elements out in priority order :
+			pop_heap parks each top at the end of the heap,
+			then a single erase drops them all
+		*/
+		template <class OutputIter>
+		OutputIter pop_n(size_type n, OutputIter out)
+		{
+			auto first = container.begin(), last = container.end();
+			if (n > container.size())
+				n = container.size();
+			for (size_type i = 0; i != n; ++i, --last)
+				pop_heap(first, last, compare);
+			for (auto now = container.end(); now != last; ++out)
+				*out = TinySTL::move(*--now);
+			container.erase(last, container.end());
+			return out;
+		}
+
+		void reserve(size_type n)
+			{ container.reserve(n); }
 	};
 
 	template <class T, class Container, class Compare>
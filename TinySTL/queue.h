@@ -69,8 +69,10 @@ namespace TinySTL
 			{ return container.empty(); }
 		size_type size()
 			{ return container.size(); }
-		void push(value_type val)
+		void push(const value_type& val)
 			{ container.push_back(val); }
+		void push(value_type&& val)
+			{ container.push_back(TinySTL::move(val)); }
 
 		template <class... Args>
 		void emplace(Args&&... args)
@@ -79,10 +81,33 @@ namespace TinySTL
 		}
 		
 		void pop()
-			{ container.pop_back(); }
+			{ container.pop_front(); }
 		void swap(queue& other)
 			{ container.swap(other.container); }
 
+	public: // batch operations
+		/* one bulk append (a single spare-room reservation for deque) */
+		template <class InputIter>
+		void push_range(InputIter first, InputIter last)
+			{ container.insert(container.end(), first, last); }
+
+		/*
+			moves min(n, size()) elements out in FIFO order,
+			then removes them with a single erase
+		*/
+		template <class OutputIter>
+		OutputIter pop_n(size_type n, OutputIter out)
+		{
+			auto first = container.begin(), last = first;
+			for (auto end = container.end(); n != 0 && last != end; --n, ++last, ++out)
+				*out = TinySTL::move(*last);
+			container.erase(first, last);
+			return out;
+		}
+
+		void reserve(size_type n)
+			{ container.reserve(n); }
+
 	public:
 		template <class T, class Container>
 		friend bool operator ==(const queue<T, Container>& lhs,
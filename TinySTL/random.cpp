@@ -0,0 +1,10 @@
+#include "random.h"
+
+namespace TinySTL
+{
+	xoshiro256ss& _this_thread_random_engine()
+	{
+		thread_local xoshiro256ss engine(1);
+		return engine;
+	}
+}
@@ -0,0 +1,251 @@
+#pragma once
+#ifndef _TINYSTL_RANDOM_H_
+#define _TINYSTL_RANDOM_H_
+
+#include <cstdint>     // uint32_t, uint64_t
+#include <random>      // std::uniform_int_distribution
+#include <type_traits> // std::decay_t
+
+#if defined(_MSC_VER)
+#   include <intrin.h> // _umul128
+#endif
+
+/*
+	small and fast uniform random bit generators, for shuffle(), sample()
+	and the like : a few cycles per number against a lock and a division
+	for rand(). not for cryptography.
+*/
+
+namespace TinySTL
+{
+	inline uint64_t _rotl64(uint64_t x, int k)
+		{ return (x << k) | (x >> (64 - k)); }
+
+	/* the high and low halves of the 128 bits product */
+	inline uint64_t _mul_128(uint64_t x, uint64_t y, uint64_t* high)
+	{
+#if defined(_MSC_VER)
+		return _umul128(x, y, high);
+#else
+		unsigned __int128 p = (unsigned __int128)x * y;
+		*high = uint64_t(p >> 64);
+		return uint64_t(p);
+#endif
+	}
+
+	/*
+		splitmix64 (Steele, Lea, Flood 2014) : every seed gives a good
+		sequence, what the other engines need to fill their state.
+	*/
+	class splitmix64
+	{
+	public:
+		using result_type = uint64_t;
+
+	protected:
+		uint64_t state;
+
+	public:
+		explicit splitmix64(uint64_t seed = 0) noexcept
+			:state(seed) {}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return UINT64_MAX; }
+
+		result_type operator()() noexcept
+		{
+			uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			return z ^ (z >> 31);
+		}
+	};
+
+	/*
+		xoshiro256** (Blackman, Vigna 2018) : 64 bits per call out of 256
+		bits of state, period 2^256 - 1.
+		-jump() moves 2^128 calls ahead : engines jumped 0, 1, 2 ... times
+		 from the same seed give non-overlapping streams, one per task of a
+		 parallel algorithm.
+	*/
+	class xoshiro256ss
+	{
+	public:
+		using result_type = uint64_t;
+
+	protected:
+		uint64_t s[4];
+
+	public:
+		explicit xoshiro256ss(uint64_t seed_value = 0) noexcept
+			{ seed(seed_value); }
+
+		void seed(uint64_t seed_value) noexcept
+		{
+			splitmix64 sm(seed_value);
+			for (auto& x : s)
+				x = sm();
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return UINT64_MAX; }
+
+		result_type operator()() noexcept
+		{
+			const uint64_t result = _rotl64(s[1] * 5, 7) * 9;
+			const uint64_t t = s[1] << 17;
+			s[2] ^= s[0];
+			s[3] ^= s[1];
+			s[1] ^= s[2];
+			s[0] ^= s[3];
+			s[2] ^= t;
+			s[3] = _rotl64(s[3], 45);
+			return result;
+		}
+
+		void discard(unsigned long long z) noexcept
+		{
+			for (; z != 0; --z)
+				(*this)();
+		}
+
+		/* equivalent to 2^128 calls */
+		void jump() noexcept
+		{
+			static const uint64_t poly[4] = { 0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+											  0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+			uint64_t t[4] = { 0, 0, 0, 0 };
+			for (uint64_t p : poly)
+				for (int b = 0; b != 64; ++b)
+				{
+					if (p & (uint64_t(1) << b))
+						for (int i = 0; i != 4; ++i)
+							t[i] ^= s[i];
+					(*this)();
+				}
+			for (int i = 0; i != 4; ++i)
+				s[i] = t[i];
+		}
+
+		friend bool operator==(const xoshiro256ss& x, const xoshiro256ss& y) noexcept
+			{ return x.s[0] == y.s[0] && x.s[1] == y.s[1] && x.s[2] == y.s[2] && x.s[3] == y.s[3]; }
+		friend bool operator!=(const xoshiro256ss& x, const xoshiro256ss& y) noexcept
+			{ return !(x == y); }
+	};
+
+	/*
+		pcg32 (O'Neill 2014) : a 64 bits LCG whose state is permuted down to
+		32 bits of output, 16 bytes of state, period 2^64.
+		-every odd increment is a distinct stream : pcg32(seed, k) for k =
+		 0, 1, 2 ... are independent generators.
+	*/
+	class pcg32
+	{
+	public:
+		using result_type = uint32_t;
+
+	protected:
+		uint64_t state;
+		uint64_t inc;
+
+	public:
+		explicit pcg32(uint64_t seed_value = 0, uint64_t stream = 0) noexcept
+			{ seed(seed_value, stream); }
+
+		void seed(uint64_t seed_value, uint64_t stream = 0) noexcept
+		{
+			state = 0;
+			inc   = (stream << 1) | 1;
+			(*this)();
+			state += seed_value;
+			(*this)();
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return UINT32_MAX; }
+
+		result_type operator()() noexcept
+		{
+			const uint64_t old = state;
+			state = old * 6364136223846793005ull + inc;
+			const uint32_t xorshifted = uint32_t(((old >> 18) ^ old) >> 27);
+			const uint32_t rot = uint32_t(old >> 59);
+			return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+		}
+
+		void discard(unsigned long long z) noexcept
+		{
+			for (; z != 0; --z)
+				(*this)();
+		}
+
+		friend bool operator==(const pcg32& x, const pcg32& y) noexcept
+			{ return x.state == y.state && x.inc == y.inc; }
+		friend bool operator!=(const pcg32& x, const pcg32& y) noexcept
+			{ return !(x == y); }
+	};
+
+	/* the engine of random_shuffle(), one per thread, always seeded alike */
+	xoshiro256ss& _this_thread_random_engine();
+
+	template <class URNG>
+	constexpr bool _full_range_32 = std::decay_t<URNG>::min() == 0 &&
+									std::decay_t<URNG>::max() == UINT32_MAX;
+
+	template <class URNG>
+	constexpr bool _full_range_64 = std::decay_t<URNG>::min() == 0 &&
+									std::decay_t<URNG>::max() == UINT64_MAX;
+
+	/*
+		uniform in [0, bound), bound > 0 : the high half of gen() * bound,
+		unbiased by rejecting the few low halves below 2^w % bound (Lemire,
+		"Fast Random Integer Generation in an Interval", 2019). the division
+		computing 2^w % bound only runs when the low half is below bound,
+		hardly ever for small bounds. other generators go through
+		uniform_int_distribution.
+	*/
+	template <class URNG>
+	uint64_t random_below(URNG& gen, uint64_t bound)
+	{
+		if constexpr (_full_range_32<URNG> || _full_range_64<URNG>)
+		{
+			if (bound <= UINT32_MAX)
+			{
+				/* 32 bits are enough, from the high (better) half of a 64 bits engine */
+				const uint32_t range = uint32_t(bound);
+				auto draw = [&gen] { return _full_range_64<URNG> ? uint32_t(uint64_t(gen()) >> 32)
+																 : uint32_t(gen()); };
+				uint64_t m = uint64_t(draw()) * range;
+				if (uint32_t(m) < range)
+				{
+					const uint32_t t = (0u - range) % range;
+					while (uint32_t(m) < t)
+						m = uint64_t(draw()) * range;
+				}
+				return m >> 32;
+			}
+			if constexpr (_full_range_64<URNG>)
+			{
+				uint64_t high;
+				uint64_t low = _mul_128(uint64_t(gen()), bound, &high);
+				if (low < bound)
+				{
+					const uint64_t t = (0 - bound) % bound;
+					while (low < t)
+						low = _mul_128(uint64_t(gen()), bound, &high);
+				}
+				return high;
+			}
+		}
+		return std::uniform_int_distribution<uint64_t>(0, bound - 1)(gen);
+	}
+
+	/* uniform in (0, 1), 53 random bits */
+	template <class URNG>
+	double _random_open_unit(URNG& gen)
+	{
+		return (double(random_below(gen, uint64_t(1) << 53)) + 0.5) * (1.0 / 9007199254740992.0);
+	}
+}
+
+#endif /* _TINYSTL_RANDOM_H_ */
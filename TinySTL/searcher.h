@@ -0,0 +1,223 @@
+#pragma once
+#ifndef _TINYSTL_SEARCHER_H_
+#define _TINYSTL_SEARCHER_H_
+
+#include <cstddef>     // size_t, ptrdiff_t
+#include <type_traits> // std::is_integral_v, std::is_enum_v
+
+#include "algorithm.h"
+#include "functional.h"
+#include "iterator.h"
+#include "utility.h"
+#include "vector.h"
+
+/*
+	searchers for search(first, last, searcher) : built once per pattern,
+	searcher(first, last) returns the pair (match, end of match), (last, last)
+	when there is none.
+*/
+
+namespace TinySTL
+{
+	/* slots of the bad character tables */
+	enum { SEARCHER_TABLE_SIZE = 256 };
+
+	/*
+		the slot of an element in the bad character tables : elements equal
+		by the predicate shall hash alike. works as is for integers (bytes :
+		one slot each) and enums, other types need their own.
+	*/
+	template <class T>
+	struct searcher_hash
+	{
+		static_assert(std::is_integral_v<T> || std::is_enum_v<T>,
+					  "searcher_hash knows integers and enums only, pass a Hash");
+
+		size_t operator()(const T& val) const
+			{ return size_t(val); }
+	};
+
+	/* the naive search(), byte pointers filtered by SIMD */
+	template <class ForwardIter, class BinaryPredicate = equal_to<> >
+	class default_searcher
+	{
+	protected:
+		ForwardIter     pat_first;
+		ForwardIter     pat_last;
+		BinaryPredicate pred;
+
+	public:
+		default_searcher(ForwardIter first, ForwardIter last, BinaryPredicate p = BinaryPredicate())
+			:pat_first(first), pat_last(last), pred(p) {}
+
+		template <class ForwardIter2>
+		pair<ForwardIter2, ForwardIter2> operator()(ForwardIter2 first, ForwardIter2 last) const
+		{
+			ForwardIter2 match = TinySTL::search(first, last, pat_first, pat_last, pred);
+			if (match == last)
+				return pair<ForwardIter2, ForwardIter2>(last, last);
+			ForwardIter2 end = match;
+			TinySTL::advance(end, TinySTL::distance(pat_first, pat_last));
+			return pair<ForwardIter2, ForwardIter2>(match, end);
+		}
+	};
+
+	/*
+		Boyer-Moore-Horspool : the pattern is compared from its end, after a
+		mismatch the window moves by the skip of the text element under its
+		last position, up to m : sublinear on text over a large alphabet.
+		-the skip table has SEARCHER_TABLE_SIZE slots indexed by hash : a slot
+		 shared by several elements keeps the shortest skip, always safe.
+		-O(n * m) at worst, see boyer_moore_searcher.
+	*/
+	template <class RandomIter,
+			  class Hash = searcher_hash<typename iterator_traits<RandomIter>::value_type>,
+			  class BinaryPredicate = equal_to<> >
+	class boyer_moore_horspool_searcher
+	{
+	public:
+		using difference_type = typename iterator_traits<RandomIter>::difference_type;
+
+	protected:
+		RandomIter              pat_first;
+		difference_type         m;
+		difference_type         skip[SEARCHER_TABLE_SIZE];
+		Hash                    hash;
+		BinaryPredicate         pred;
+
+	public:
+		boyer_moore_horspool_searcher(RandomIter first, RandomIter last,
+									  Hash hf = Hash(), BinaryPredicate p = BinaryPredicate())
+			:pat_first(first), m(last - first), hash(hf), pred(p)
+		{
+			for (auto& s : skip)
+				s = m;
+			/* later positions skip less : plain assignment keeps the minimum */
+			for (difference_type i = 0; i < m - 1; ++i)
+				skip[_slot(pat_first[i])] = m - 1 - i;
+		}
+
+		template <class RandomIter2>
+		pair<RandomIter2, RandomIter2> operator()(RandomIter2 first, RandomIter2 last) const
+		{
+			if (m == 0)
+				return pair<RandomIter2, RandomIter2>(first, first);
+			for (; last - first >= m; first += skip[_slot(first[m - 1])])
+			{
+				difference_type i = m - 1;
+				while (pred(first[i], pat_first[i]))
+				{
+					if (i == 0)
+						return pair<RandomIter2, RandomIter2>(first, first + m);
+					--i;
+				}
+			}
+			return pair<RandomIter2, RandomIter2>(last, last);
+		}
+
+	protected:
+		template <class T>
+		size_t _slot(const T& val) const
+			{ return hash(val) % SEARCHER_TABLE_SIZE; }
+	};
+
+	/*
+		Boyer-Moore : Horspool's bad character rule taken at the mismatch,
+		plus the good suffix rule (the matched suffix occurs again in the
+		pattern, or a prefix of the pattern ends it) : the larger shift wins.
+		O(n / m) on most text, O(n * m) at worst, the tables cost O(m).
+		(C. Charras, T. Lecroq, "Handbook of Exact String Matching", 2004)
+	*/
+	template <class RandomIter,
+			  class Hash = searcher_hash<typename iterator_traits<RandomIter>::value_type>,
+			  class BinaryPredicate = equal_to<> >
+	class boyer_moore_searcher
+	{
+	public:
+		using difference_type = typename iterator_traits<RandomIter>::difference_type;
+
+	protected:
+		RandomIter              pat_first;
+		difference_type         m;
+		difference_type         bad_char[SEARCHER_TABLE_SIZE];
+		vector<difference_type> good_suffix;
+		Hash                    hash;
+		BinaryPredicate         pred;
+
+	public:
+		boyer_moore_searcher(RandomIter first, RandomIter last,
+							 Hash hf = Hash(), BinaryPredicate p = BinaryPredicate())
+			:pat_first(first), m(last - first), hash(hf), pred(p)
+		{
+			for (auto& s : bad_char)
+				s = m;
+			for (difference_type i = 0; i < m - 1; ++i)
+				bad_char[_slot(pat_first[i])] = m - 1 - i;
+			_build_good_suffix();
+		}
+
+		template <class RandomIter2>
+		pair<RandomIter2, RandomIter2> operator()(RandomIter2 first, RandomIter2 last) const
+		{
+			if (m == 0)
+				return pair<RandomIter2, RandomIter2>(first, first);
+			while (last - first >= m)
+			{
+				difference_type i = m - 1;
+				while (pred(first[i], pat_first[i]))
+				{
+					if (i == 0)
+						return pair<RandomIter2, RandomIter2>(first, first + m);
+					--i;
+				}
+				/* the bad character shift, seen from the mismatch at i */
+				const difference_type bc = bad_char[_slot(first[i])] - (m - 1 - i);
+				first += TinySTL::max(good_suffix[i], bc);
+			}
+			return pair<RandomIter2, RandomIter2>(last, last);
+		}
+
+	protected:
+		template <class T>
+		size_t _slot(const T& val) const
+			{ return hash(val) % SEARCHER_TABLE_SIZE; }
+
+		/*
+			suffix[i] : length of the longest common suffix of the pattern and
+			of its prefix ending at i, then the shifts for a mismatch at i
+		*/
+		void _build_good_suffix()
+		{
+			vector<difference_type> suffix(size_t(m), difference_type(0));
+			good_suffix.assign(size_t(m), m);
+			if (m == 0)
+				return;
+			suffix[m - 1] = m;
+			for (difference_type i = m - 2, f = m - 1, g = m - 1; i >= 0; --i)
+			{
+				if (i > g && suffix[i + m - 1 - f] < i - g)
+					suffix[i] = suffix[i + m - 1 - f];
+				else
+				{
+					if (i < g)
+						g = i;
+					f = i;
+					while (g >= 0 && pred(pat_first[g], pat_first[g + m - 1 - f]))
+						--g;
+					suffix[i] = f - g;
+				}
+			}
+			/* a prefix of the pattern is a suffix of the matched part */
+			for (difference_type i = m - 1, j = 0; i >= 0; --i)
+				if (suffix[i] == i + 1)
+					for (; j < m - 1 - i; ++j)
+						if (good_suffix[j] == m)
+							good_suffix[j] = m - 1 - i;
+			/* the matched suffix occurs again, rightmost first */
+			for (difference_type i = 0; i <= m - 2; ++i)
+				good_suffix[m - 1 - suffix[i]] = m - 1 - i;
+		}
+	};
+}
+
+#endif /* _TINYSTL_SEARCHER_H_ */
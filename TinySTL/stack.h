@@ -67,8 +67,10 @@ namespace TinySTL
 			{ return container.empty(); }
 		size_type size()
 			{ return container.size(); }
-		void push(value_type val)
+		void push(const value_type& val)
 			{ container.push_back(val); }
+		void push(value_type&& val)
+			{ container.push_back(TinySTL::move(val)); }
 
 		template <class... Args>
 		void emplace(Args&&... args)
@@ -81,6 +83,29 @@ namespace TinySTL
 		void swap(stack& other)
 			{ container.swap(other.container); }
 
+	public: // batch operations
+		/* one bulk append, the last element ends up on top */
+		template <class InputIter>
+		void push_range(InputIter first, InputIter last)
+			{ container.insert(container.end(), first, last); }
+
+		/*
+			moves min(n, size()) elements out in LIFO order (top first),
+			then removes them with a single erase
+		*/
+		template <class OutputIter>
+		OutputIter pop_n(size_type n, OutputIter out)
+		{
+			auto first = container.begin(), last = container.end();
+			for (; n != 0 && last != first; --n, ++out)
+				*out = TinySTL::move(*--last);
+			container.erase(last, container.end());
+			return out;
+		}
+
+		void reserve(size_type n)
+			{ container.reserve(n); }
+
 	public:
 		template <class T, class Container>
 		friend bool operator ==(const stack<T, Container>& lhs,
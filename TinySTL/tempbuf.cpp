@@ -0,0 +1,61 @@
+#include "tempbuf.h"
+
+namespace TinySTL
+{
+	namespace
+	{
+		struct tempbuf_cache
+		{
+			void*  block;
+			size_t bytes;
+			bool   in_use;
+
+			tempbuf_cache() :block(nullptr), bytes(0), in_use(false) {}
+			~tempbuf_cache()
+				{ malloc_alloc_template::deallocate(block, bytes); }
+		};
+
+		tempbuf_cache& this_cache()
+		{
+			thread_local tempbuf_cache cache;
+			return cache;
+		}
+	}
+
+	void* _tempbuf_acquire(size_t bytes)
+	{
+		tempbuf_cache& cache = this_cache();
+		if (cache.in_use)
+			return malloc_alloc_template::try_allocate(bytes);
+		if (cache.bytes < bytes)
+		{
+			/* free first : the old block and the new one needn't both fit */
+			malloc_alloc_template::deallocate(cache.block, cache.bytes);
+			cache.block = malloc_alloc_template::try_allocate(bytes);
+			cache.bytes = cache.block ? bytes : 0;
+			if (!cache.block)
+				return nullptr;
+		}
+		cache.in_use = true;
+		return cache.block;
+	}
+
+	void _tempbuf_release(void* ptr, size_t bytes)
+	{
+		tempbuf_cache& cache = this_cache();
+		if (cache.in_use && ptr == cache.block)
+			cache.in_use = false;
+		else
+			malloc_alloc_template::deallocate(ptr, bytes);
+	}
+
+	void release_temporary_buffers()
+	{
+		tempbuf_cache& cache = this_cache();
+		if (cache.in_use)
+			return;
+		malloc_alloc_template::deallocate(cache.block, cache.bytes);
+		cache.block = nullptr;
+		cache.bytes = 0;
+	}
+}
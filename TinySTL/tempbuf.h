@@ -0,0 +1,118 @@
+#pragma once
+#ifndef _TINYSTL_TEMPBUF_H_
+#define _TINYSTL_TEMPBUF_H_
+
+#include <cstddef>     // size_t
+#include <new>         // std::bad_alloc
+#include <type_traits> // std::is_same_v
+
+#include "alloc.h"
+#include "allocator.h"
+#include "xmemory.h"
+
+namespace TinySTL
+{
+	/*
+		per thread cache behind temporary_buffer, see tempbuf.cpp
+		-one block is kept between calls and only grows : repeated sorts of
+		 similar sizes reuse pages that are already faulted in.
+		-a buffer asked for while the block is out (nested algorithms) comes
+		 straight from malloc.
+		-nullptr when out of memory, never the oom handler.
+	*/
+	void* _tempbuf_acquire(size_t bytes);
+	void  _tempbuf_release(void* ptr, size_t bytes);
+
+	/* gives the cached block of the calling thread back to the system */
+	void release_temporary_buffers();
+
+	/*
+		uninitialized scratch storage for at most `requested` elements
+		-the request is halved until an allocation succeeds, so size() may be
+		 anything from 0 to requested_size() : the algorithms adapt to it.
+		-with the default allocator<T> the memory comes from the thread cache,
+		 any other allocator (polymorphic_allocator over a memory_resource ...)
+		 is used as is, std::bad_alloc meaning "try less".
+		-elements are neither constructed nor destroyed here.
+	*/
+	template <class T, class Alloc = allocator<T> >
+	class temporary_buffer
+	{
+	public:
+		using value_type     = T;
+		using pointer        = T*;
+		using size_type      = size_t;
+		using allocator_type = Alloc;
+
+	protected:
+		using alloc_traits = allocator_traits<Alloc>;
+
+		static constexpr bool cached = std::is_same_v<Alloc, allocator<T> >;
+
+	protected:
+		T*        buffer;
+		size_type len;
+		size_type requested;
+		Alloc     alloc;
+
+	public:
+		explicit temporary_buffer(size_type n, const Alloc& a = Alloc())
+			:buffer(nullptr), len(0), requested(n), alloc(a)
+		{
+			if (n > size_type(-1) / sizeof(T))
+				n = size_type(-1) / sizeof(T);
+			for (; n != 0; n /= 2)
+				if ((buffer = _allocate(n)) != nullptr)
+				{
+					len = n;
+					break;
+				}
+		}
+
+		temporary_buffer(const temporary_buffer&) = delete;
+		temporary_buffer& operator=(const temporary_buffer&) = delete;
+
+		~temporary_buffer()
+		{
+			if (!buffer)
+				return;
+			if constexpr (cached)
+				_tempbuf_release(buffer, len * sizeof(T));
+			else
+				alloc_traits::deallocate(alloc, buffer, len);
+		}
+
+		T* data() const noexcept
+			{ return buffer; }
+		T* begin() const noexcept
+			{ return buffer; }
+		T* end() const noexcept
+			{ return buffer + len; }
+		size_type size() const noexcept
+			{ return len; }
+		size_type requested_size() const noexcept
+			{ return requested; }
+		allocator_type get_allocator() const
+			{ return alloc; }
+
+	protected:
+		T* _allocate(size_type n)
+		{
+			if constexpr (cached)
+				return static_cast<T*>(_tempbuf_acquire(n * sizeof(T)));
+			else
+			{
+				try
+				{
+					return alloc_traits::allocate(alloc, n);
+				}
+				catch (const std::bad_alloc&)
+				{
+					return nullptr;
+				}
+			}
+		}
+	};
+}
+
+#endif /* _TINYSTL_TEMPBUF_H_ */
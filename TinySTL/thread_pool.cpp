@@ -0,0 +1,134 @@
+#include <cstdint>
+
+#include "thread_pool.h"
+
+namespace TinySTL
+{
+	namespace
+	{
+		/* the deques of all the pools grow from several threads */
+		synchronized_pool_resource deque_resource;
+
+		thread_local const thread_pool* this_pool   = nullptr;
+		thread_local void*              this_worker = nullptr;
+
+		/* xorshift, spreads the thieves over the victims */
+		uint32_t next_victim()
+		{
+			thread_local uint32_t state =
+				uint32_t(reinterpret_cast<uintptr_t>(&state) >> 4) | 1;
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return state;
+		}
+	}
+
+	thread_pool::thread_pool(size_t concurrency)
+		:workers(nullptr), worker_count(0), stopping(false)
+	{
+		if (concurrency == 0)
+			concurrency = std::thread::hardware_concurrency();
+		if (concurrency > 1)
+		{
+			worker_count = concurrency - 1;
+			workers = new worker*[worker_count];
+			for (size_t i = 0; i != worker_count; ++i)
+				workers[i] = new worker(&deque_resource);
+			for (size_t i = 0; i != worker_count; ++i)
+				workers[i]->thread = std::thread([this, i] { _work(i); });
+		}
+	}
+
+	thread_pool::~thread_pool()
+	{
+		stopping.store(true, std::memory_order_relaxed);
+		idle.notify_all();
+		/* all joined before any is freed : the last ones may still steal from the first */
+		for (size_t i = 0; i != worker_count; ++i)
+			workers[i]->thread.join();
+		for (size_t i = 0; i != worker_count; ++i)
+			delete workers[i];
+		delete[] workers;
+	}
+
+	thread_pool& thread_pool::default_pool()
+	{
+		static thread_pool pool;
+		return pool;
+	}
+
+	void thread_pool::submit(_pool_task* task)
+	{
+		if (worker* self = _this_worker())
+			self->tasks.push(task);
+		else
+			injected.push(task);
+		idle.notify_one();
+	}
+
+	bool thread_pool::run_one()
+	{
+		_pool_task* task = _find_task(_this_worker());
+		if (!task)return false;
+		task->run();
+		delete task;
+		return true;
+	}
+
+	thread_pool::worker* thread_pool::_this_worker() const
+	{
+		return this_pool == this ? static_cast<worker*>(this_worker) : nullptr;
+	}
+
+	_pool_task* thread_pool::_find_task(worker* self)
+	{
+		_pool_task* task;
+		if (self && self->tasks.pop(task))
+			return task;
+		if (injected.try_pop(task))
+			return task;
+		if (worker_count == 0)
+			return nullptr;
+		size_t start = next_victim() % worker_count;
+		for (size_t i = 0; i != worker_count; ++i)
+		{
+			worker* victim = workers[(start + i) % worker_count];
+			if (victim != self && victim->tasks.steal(task))
+				return task;
+		}
+		return nullptr;
+	}
+
+	void thread_pool::_work(size_t index)
+	{
+		worker* self = workers[index];
+		this_pool   = this;
+		this_worker = self;
+		for (;;)
+		{
+			if (run_one())
+				continue;
+			unsigned spins = 0;
+			for (; spins != SPIN_LIMIT && !run_one(); ++spins)
+				_cpu_relax();
+			if (spins != SPIN_LIMIT)
+				continue;
+
+			uint32_t key = idle.prepare_wait();
+			if (stopping.load(std::memory_order_relaxed))
+			{
+				idle.cancel_wait();
+				return;
+			}
+			if (_pool_task* task = _find_task(self))
+			{
+				idle.cancel_wait();
+				task->run();
+				delete task;
+				continue;
+			}
+			idle.wait(key);
+		}
+	}
+}
@@ -0,0 +1,172 @@
+#pragma once
+#ifndef _TINYSTL_THREAD_POOL_H_
+#define _TINYSTL_THREAD_POOL_H_
+
+#include <atomic>      // std::atomic
+#include <exception>   // std::exception_ptr
+#include <thread>      // std::thread
+#include <type_traits> // std::decay_t
+
+#include "concurrent_queue.h"
+#include "polymorphic_allocator.h"
+#include "utility.h"
+#include "work_stealing_deque.h"
+#include "xatomic.h"
+
+namespace TinySTL
+{
+	/* a unit of work, deleted by the pool once run */
+	class _pool_task
+	{
+	public:
+		virtual ~_pool_task() {}
+		virtual void run() = 0;
+	};
+
+	/*
+		fork-join pool for the parallel algorithms
+		-every worker owns a work_stealing_deque : tasks forked by a worker
+		 go to its own deque (LIFO, cache-hot), idle workers steal the oldest
+		 (largest) tasks of the others.
+		-tasks from outside the pool go through a shared concurrent_queue.
+		-a thread waiting on a task_group runs pending tasks meanwhile, so the
+		 caller counts as one of the concurrency() threads and nested groups
+		 never deadlock.
+		-idle workers park on an event count, see xatomic.h
+	*/
+	class thread_pool
+	{
+	public:
+		/* concurrency == 0 : one thread per hardware thread */
+		explicit thread_pool(size_t concurrency = 0);
+		~thread_pool();
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		/* started on first use, joined at exit */
+		static thread_pool& default_pool();
+
+		/* workers + the calling thread */
+		size_t concurrency() const noexcept
+			{ return worker_count + 1; }
+
+		/* takes the ownership of task */
+		void submit(_pool_task* task);
+
+		/* runs one pending task if any, from any thread */
+		bool run_one();
+
+	protected:
+		struct worker
+		{
+			work_stealing_deque<_pool_task*> tasks;
+			std::thread                      thread;
+
+			explicit worker(memory_resource* r)
+				:tasks(256, polymorphic_allocator<_pool_task*>(r)) {}
+		};
+
+	protected:
+		worker**                      workers;
+		size_t                        worker_count;
+		concurrent_queue<_pool_task*> injected;
+		_event_count                  idle;
+		std::atomic<bool>             stopping;
+
+	protected:
+		worker* _this_worker() const;
+		_pool_task* _find_task(worker* self);
+		void _work(size_t index);
+	};
+
+	/*
+		tasks forked together and joined by wait()
+		-the first exception thrown by a task is rethrown by wait(),
+		 the other tasks still run to completion.
+	*/
+	class task_group
+	{
+	protected:
+		template <class F>
+		class _task :public _pool_task
+		{
+		protected:
+			task_group* group;
+			F           fn;
+
+		public:
+			template <class G>
+			_task(task_group* g, G&& f) :group(g), fn(TinySTL::forward<G>(f)) {}
+
+			void run()
+			{
+				try
+				{
+					fn();
+				}
+				catch (...)
+				{
+					group->_fail(std::current_exception());
+				}
+				group->pending.fetch_sub(1, std::memory_order_release); // last touch of group
+			}
+		};
+
+	protected:
+		thread_pool&        pool;
+		std::atomic<size_t> pending;
+		std::atomic<bool>   failed;
+		std::exception_ptr  error;
+
+	public:
+		explicit task_group(thread_pool& p = thread_pool::default_pool())
+			:pool(p), pending(0), failed(false) {}
+
+		~task_group()
+			{ _join(); }
+
+		task_group(const task_group&) = delete;
+		task_group& operator=(const task_group&) = delete;
+
+		template <class F>
+		void run(F&& f)
+		{
+			_pool_task* task = new _task<std::decay_t<F> >(this, TinySTL::forward<F>(f));
+			pending.fetch_add(1, std::memory_order_relaxed);
+			pool.submit(task);
+		}
+
+		void wait()
+		{
+			_join();
+			if (failed.load(std::memory_order_relaxed))
+			{
+				failed.store(false, std::memory_order_relaxed);
+				std::rethrow_exception(TinySTL::move(error));
+			}
+		}
+
+	protected:
+		void _join()
+		{
+			for (unsigned spins = 0; pending.load(std::memory_order_acquire) != 0; )
+			{
+				if (pool.run_one())
+					spins = 0;
+				else if (++spins < SPIN_LIMIT)
+					_cpu_relax();
+				else
+					std::this_thread::yield(); // our tasks are running elsewhere
+			}
+		}
+
+		void _fail(std::exception_ptr e)
+		{
+			if (!failed.exchange(true, std::memory_order_relaxed))
+				error = e;
+		}
+	};
+}
+
+#endif /* _TINYSTL_THREAD_POOL_H_ */
@@ -0,0 +1,120 @@
+#pragma once
+#ifndef _TINYSTL_TOP_K_H_
+#define _TINYSTL_TOP_K_H_
+
+#include "functional.h"
+#include "heap.h"
+#include "utility.h"
+#include "vector.h"
+
+namespace TinySTL
+{
+	/*
+		the k first elements, by compare, of a stream of any length
+		-a max-heap of k elements at most : once full, an element not before
+		 the worst one kept costs a single comparison and is dropped.
+		-threshold() / admits() let a producer skip building elements that
+		 would be dropped anyway (pruning).
+		-greater<> keeps the k largest : leaderboards, top-N queries.
+	*/
+	template <class T, class Compare = less<>, class Container = vector<T> >
+	class top_k
+	{
+	public:
+		using container_type  = Container;
+		using value_compare   = Compare;
+		using value_type      = typename Container::value_type;
+		using size_type       = typename Container::size_type;
+		using const_reference = typename Container::const_reference;
+
+	protected:
+		Container container;
+		size_type bound;
+		Compare   compare;
+
+	public:
+		explicit top_k(size_type k, const Compare& comp = Compare(), Container&& cont = Container())
+			:container(TinySTL::move(cont)), bound(k), compare(comp)
+		{
+			container.clear();
+			container.reserve(k);
+		}
+
+		template <class InputIter>
+		top_k(size_type k, InputIter first, InputIter last, const Compare& comp = Compare())
+			:top_k(k, comp)
+			{ push(first, last); }
+
+		size_type size() const noexcept
+			{ return container.size(); }
+		size_type k() const noexcept
+			{ return bound; }
+		bool empty() const noexcept
+			{ return container.empty(); }
+		bool full() const noexcept
+			{ return container.size() == bound; }
+
+		/* the worst element kept, not empty() : once full(), nothing after it gets in */
+		const_reference threshold() const
+			{ return container.front(); }
+
+		/* val would be kept by push */
+		bool admits(const T& val) const
+			{ return !full() || (bound != 0 && compare(val, container.front())); }
+
+		/* keeps val if it is among the k first so far, tells whether it was */
+		bool push(const T& val)
+		{
+			if (!admits(val))
+				return false;
+			_insert(T(val));
+			return true;
+		}
+
+		bool push(T&& val)
+		{
+			if (!admits(val))
+				return false;
+			_insert(TinySTL::move(val));
+			return true;
+		}
+
+		template <class InputIter>
+		void push(InputIter first, InputIter last)
+		{
+			for (; first != last; ++first)
+				push(*first);
+		}
+
+		void clear() noexcept
+			{ container.clear(); }
+
+		/* the elements kept, sorted by compare, left empty */
+		Container take_sorted()
+		{
+			sort_heap(container.begin(), container.end(), compare);
+			Container result(TinySTL::move(container));
+			container.clear();
+			container.reserve(bound);
+			return result;
+		}
+
+	protected:
+		void _insert(T&& val)
+		{
+			if (!full())
+			{
+				container.push_back(TinySTL::move(val));
+				push_heap(container.begin(), container.end(), compare);
+			}
+			else
+			{
+				using Distance = typename iterator_traits<typename Container::iterator>::difference_type;
+				_adjust_heap(container.begin(), Distance(0), Distance(container.size()),
+							 TinySTL::move(val), compare);
+			}
+		}
+	};
+}
+
+#endif /* _TINYSTL_TOP_K_H_ */
@@ -17,7 +17,7 @@ namespace TinySTL
 	template<class T>
 	void swap(T& x, T& y)
 	{
-		T z(move(x));
+		T z(TinySTL::move(x));
 		x = std::move(y);
 		y = std::move(z);
 	}
@@ -57,7 +57,7 @@ namespace TinySTL
 		pair(const pair<U, V>& x) :first(x.first), second(x.second) {}
 
 		template<class U, class V>
-		pair(pair<U, V>&& x) :first(forward<U>(x.first)), second(forward<V>(x.second)) {}
+		pair(pair<U, V>&& x) :first(TinySTL::forward<U>(x.first)), second(TinySTL::forward<V>(x.second)) {}
 
 		pair(const pair& x) = default;
 
@@ -66,7 +66,7 @@ namespace TinySTL
 		pair(const T1& x, const T2& y) :first(x), second(y) {}
 
 		template<class U, class V>
-		pair(U&& x, V&& y) : first(forward<U>(x)), second(forward<V>(y)) {}
+		pair(U&& x, V&& y) : first(TinySTL::forward<U>(x)), second(TinySTL::forward<V>(y)) {}
 
 		pair& operator =(const pair& x)
 		{
@@ -77,8 +77,8 @@ namespace TinySTL
 
 		pair& operator =(pair&& x)
 		{
-			first = forward<T1>(x.first);
-			second = forward<T2>(x.second);
+			first = TinySTL::forward<T1>(x.first);
+			second = TinySTL::forward<T2>(x.second);
 			return *this;
 		}
 
@@ -145,7 +145,7 @@ namespace TinySTL
 	template<class T1, class T2>
 	pair<T1, T2> make_pair(T1&& x, T2&& y)
 	{
-		return (pair<T1, T2>(forward<T1>(x), forward<T2>(y)));
+		return (pair<T1, T2>(TinySTL::forward<T1>(x), TinySTL::forward<T2>(y)));
 	}
 }
 
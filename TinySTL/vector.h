@@ -109,7 +109,7 @@ namespace TinySTL
 
 		vector& operator=(const vector& other)
 		{
-			if (this != addressof(other))
+			if (this != TinySTL::addressof(other))
 				assign(other.begin(), other.end());
 			return *this;
 		}
@@ -205,16 +205,16 @@ namespace TinySTL
 			{ return emplace(pos, val); }
 
 		iterator insert(iterator pos, T&& val)
-			{ return emplace(pos, move(val)); }
+			{ return emplace(pos, TinySTL::move(val)); }
 
 		iterator insert(iterator pos, size_type n, const T& val)
 		{
 			if (n != 0)
 			{
 				auto now = _insert_spare_n(pos, n);
-				fill(now.first, now.second, val);
+				TinySTL::fill(now.first, now.second, val);
 				n -= now.second - now.first;
-				uninitialized_fill_n(now.second, n, val, data_allocator);
+				TinySTL::uninitialized_fill_n(now.second, n, val, data_allocator);
 				return now.first;
 			}
 			return pos;
@@ -236,16 +236,16 @@ namespace TinySTL
 		{
 			auto now = _insert_spare_n(pos, 1);
 			if (now.first != now.second)
-				*(now.second) = value_type(forward<Args>(args)...);
+				*(now.first) = value_type(TinySTL::forward<Args>(args)...);
 			else
-				alloc_traits::construct(data_allocator, now.second, forward<Args>(args)...);
+				alloc_traits::construct(data_allocator, now.second, TinySTL::forward<Args>(args)...);
 			return now.first;
 		}
 
 		iterator erase(iterator pos)
 		{
 			if (pos + 1 != end())
-				move(pos + 1, finish, pos);
+				TinySTL::move(pos + 1, finish, pos);
 			--finish;
 			alloc_traits::destroy(data_allocator, finish);
 			return pos;
@@ -253,7 +253,7 @@ namespace TinySTL
 
 		iterator erase(iterator first, iterator last)
 		{
-			iterator tmp = move(last, finish, first);
+			iterator tmp = TinySTL::move(last, finish, first);
 			alloc_traits::destroy(data_allocator, tmp, finish);
 			finish = finish - (last - first);
 			return first;
@@ -273,16 +273,16 @@ namespace TinySTL
 		{
 			if (finish != end_of_storage)
 			{
-				alloc_traits::construct(data_allocator, finish, move(val));
+				alloc_traits::construct(data_allocator, finish, TinySTL::move(val));
 				++finish;
 			}
-			else emplace(end(), move(val));
+			else emplace(end(), TinySTL::move(val));
 		}
 
 		template <class... Args>
 		reference emplace_back(Args&&... args)
 		{
-			iterator now = emplace(end(), forward<Args>(args)...);
+			iterator now = emplace(end(), TinySTL::forward<Args>(args)...);
 			return *now;
 		}
 
@@ -312,14 +312,14 @@ namespace TinySTL
 		void _alloc_n_and_copy(size_type n, Iterator first, Iterator last)
 		{
 			start          = alloc_traits::allocate(data_allocator, n);
-			finish         = uninitialized_copy(first, last, start, data_allocator);
+			finish         = TinySTL::uninitialized_copy(first, last, start, data_allocator);
 			end_of_storage = start + n;
 		}
 
 		void _alloc_n_and_init(size_type n, value_type val)
 		{
 			start          = alloc_traits::allocate(data_allocator, n);
-			finish         = uninitialized_fill_n(start, n, val, data_allocator);
+			finish         = TinySTL::uninitialized_fill_n(start, n, val, data_allocator);
 			end_of_storage = start + n;
 		}
 
@@ -342,10 +342,10 @@ namespace TinySTL
 		void _range_initialize(ForwardIter first, ForwardIter last,
 							   forward_iterator_tag)
 		{
-			size_type n = distance(first, last);
+			size_type n = TinySTL::distance(first, last);
 
 			start          = alloc_traits::allocate(data_allocator, n);
-			finish         = uninitialized_copy(first, last, start, data_allocator);
+			finish         = TinySTL::uninitialized_copy(first, last, start, data_allocator);
 			end_of_storage = start + n;
 		}
 
@@ -373,12 +373,13 @@ namespace TinySTL
 		{
 			if (first != last)
 			{
-				size_type n = distance(first, last);
+				size_type n = TinySTL::distance(first, last);
 				auto now = _insert_spare_n(pos, n);
-				iterator mid = first;
-				advance(mid, now.second - now.first);
-				copy(first, mid, now.first);
-				return uninitialized_copy(mid, last, now.second, data_allocator);
+				ForwardIter mid = first;
+				TinySTL::advance(mid, now.second - now.first);
+				TinySTL::copy(first, mid, now.first);
+				TinySTL::uninitialized_copy(mid, last, now.second, data_allocator);
+				return now.first;
 			}
 			return pos;
 		}
@@ -392,7 +393,7 @@ namespace TinySTL
 		{
 			_destroy_and_dealloc();
 			start          = alloc_traits::allocate(data_allocator, n);
-			finish         = uninitialized_copy(first, last, start, data_allocator);
+			finish         = TinySTL::uninitialized_copy(first, last, start, data_allocator);
 			end_of_storage = start + n;
 		}
 
@@ -400,7 +401,7 @@ namespace TinySTL
 		void _realloc_n_and_move(size_type n, Iterator first, Iterator last)
 		{
 			iterator tmp_s = alloc_traits::allocate(data_allocator, n);
-			iterator tmp_t = uninitialized_move(first, last, tmp_s, data_allocator);
+			iterator tmp_t = TinySTL::uninitialized_move(first, last, tmp_s, data_allocator);
 			_destroy_and_dealloc();
 			start		   = tmp_s;
 			finish         = tmp_t;
@@ -426,7 +427,7 @@ namespace TinySTL
 	vector<T, Alloc>&
 	vector<T, Alloc>::operator=(vector<T, Alloc>&& other)
 	{
-		if (this != addressof(other))
+		if (this != TinySTL::addressof(other))
 		{
 			_destroy_and_dealloc();
 
@@ -444,11 +445,11 @@ namespace TinySTL
 	{
 		if (n > size())
 		{
-			fill(begin(), end(), val);
+			TinySTL::fill(begin(), end(), val);
 			insert(end(), n - size(), val);
 		}
 		else
-			erase(fill_n(begin(), n, val), end());
+			erase(TinySTL::fill_n(begin(), n, val), end());
 	}
 
 	template <class T, class Alloc>
@@ -472,7 +473,7 @@ namespace TinySTL
 	vector<T, Alloc>::_assign(ForwardIter first, ForwardIter last,
 							  forward_iterator_tag)
 	{
-		size_type n = distance(first, last);
+		size_type n = TinySTL::distance(first, last);
 		if (n > capacity())
 		{
 			_realloc_n_and_copy(n, first, last);
@@ -480,13 +481,13 @@ namespace TinySTL
 		else if (n > size())
 		{
 			ForwardIter mid = first;
-			advance(mid, size());
-			copy(first, mid, start);
-			finish = uninitialized_copy(mid, last, finish, data_allocator);
+			TinySTL::advance(mid, size());
+			TinySTL::copy(first, mid, start);
+			finish = TinySTL::uninitialized_copy(mid, last, finish, data_allocator);
 		}
 		else
 		{
-			iterator tmp_t = copy(first, last, start);
+			iterator tmp_t = TinySTL::copy(first, last, start);
 			alloc_traits::destroy(data_allocator, tmp_t, finish);
 			finish = tmp_t;
 		}
@@ -506,35 +507,35 @@ namespace TinySTL
 			iterator old_t = finish;
 			if (elems_after > n)
 			{
-				uninitialized_move(finish - n, finish, finish, data_allocator);
+				TinySTL::uninitialized_move(finish - n, finish, finish, data_allocator);
 				finish += n;
-				move_backward(pos, old_t - n, old_t);
-				return make_pair(pos, pos + n);
+				TinySTL::move_backward(pos, old_t - n, old_t);
+				return TinySTL::make_pair(pos, pos + n);
 			}
 			else
 			{
 				finish += n - elems_after;
 				if (pos != finish)
 				{
-					uninitialized_copy(pos, old_t, finish, data_allocator);
+					TinySTL::uninitialized_copy(pos, old_t, finish, data_allocator);
 					finish += elems_after;
 				}
-				return make_pair(pos, old_t);
+				return TinySTL::make_pair(pos, old_t);
 			}
 		}
 		else
 		{
-			size_type len = size() + n;
+			size_type len = size() + TinySTL::max(size(), n); // geometric growth, amortized O(1) push_back
 			iterator tmp_s = alloc_traits::allocate(data_allocator, len);
-			iterator tmp_t = uninitialized_move(start, pos, tmp_s, data_allocator);
+			iterator tmp_t = TinySTL::uninitialized_move(start, pos, tmp_s, data_allocator);
 			iterator ret = tmp_t;
-			advance(tmp_t, n);
-			tmp_t = uninitialized_move(pos, finish, tmp_t, data_allocator);
+			TinySTL::advance(tmp_t, n);
+			tmp_t = TinySTL::uninitialized_move(pos, finish, tmp_t, data_allocator);
 			_destroy_and_dealloc();
 			start          = tmp_s;
 			finish         = tmp_t;
 			end_of_storage = start + len;
-			return make_pair(ret, ret);
+			return TinySTL::make_pair(ret, ret);
 		}
 	}
 
@@ -542,7 +543,7 @@ namespace TinySTL
 	bool operator ==(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
 	{
 		return lhs.size() == rhs.size() && 
-			equal(lhs.begin(), lhs.end(), rhs.begin());
+			TinySTL::equal(lhs.begin(), lhs.end(), rhs.begin());
 	}
 
 	template <class T, class Alloc>
@@ -554,7 +555,7 @@ namespace TinySTL
 	template <class T, class Alloc>
 	bool operator <(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
 	{
-		return lexicographical_compare(lhs.begin(), lhs.end(),
+		return TinySTL::lexicographical_compare(lhs.begin(), lhs.end(),
 									   rhs.begin(), rhs.end());
 	}
 
@@ -587,7 +588,7 @@ namespace TinySTL
 	erase(vector<T, Alloc>& v, const U& value)
 	{
 		auto it = remove(v.begin(), v.end(), value);
-		auto ret = distance(it, v.end());
+		auto ret = TinySTL::distance(it, v.end());
 		v.erase(it, v.end());
 		return ret;
 	}
@@ -597,7 +598,7 @@ namespace TinySTL
 	erase_if(vector<T, Alloc>& v, Pred pred)
 	{
 		auto it = remove_if(v.begin(), v.end(), pred);
-		auto ret = distance(it, v.end());
+		auto ret = TinySTL::distance(it, v.end());
 		v.erase(it, v.end());
 		return ret;
 	}
@@ -0,0 +1,196 @@
+#pragma once
+#ifndef _TINYSTL_WORK_STEALING_DEQUE_H_
+#define _TINYSTL_WORK_STEALING_DEQUE_H_
+
+#include <atomic>      // std::atomic
+#include <new>         // placement new
+#include <type_traits> // std::is_trivially_copyable_v
+
+#include "memory.h"
+#include "polymorphic_allocator.h"
+#include "xatomic.h"
+
+namespace TinySTL
+{
+	/*
+		Chase-Lev work-stealing deque
+		(memory orders from N.M. Le et al., "Correct and Efficient Work-Stealing
+		 for Weak Memory Models", PPoPP 2013)
+		-the owner thread push()es and pop()s at the bottom (LIFO, cache friendly),
+		 any other thread steal()s from the top (FIFO, takes the oldest work).
+		-owner operations only synchronize with thieves when a single element
+		 is left; thieves race each other with a CAS on top.
+		-the circular array doubles when full. A thief may still be reading the
+		 old one, so replaced arrays are kept until the deque is destroyed
+		 (they add up to less than the current one).
+		-T is copied in and out racily, it shall be trivially copyable
+		 (typically a pointer to a task).
+	*/
+	template <class T, class Alloc = polymorphic_allocator<T> >
+	class work_stealing_deque
+	{
+		static_assert(std::is_trivially_copyable_v<T>,
+					  "work_stealing_deque requires trivially copyable elements");
+
+	public:
+		using value_type      = T;
+		using allocator_type  = Alloc;
+		using size_type       = size_t;
+		using difference_type = ptrdiff_t;
+
+	protected:
+		using slot = std::atomic<T>;
+
+		struct ring
+		{
+			difference_type capacity;
+			slot*           slots;
+			ring*           prev; // replaced arrays, freed with the deque
+
+			T get(difference_type i) const
+				{ return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+			void put(difference_type i, T val)
+				{ slots[i & (capacity - 1)].store(val, std::memory_order_relaxed); }
+		};
+
+		using slot_allocator_type =
+			typename allocator_traits<Alloc>::template rebind_alloc<slot>;
+		using ring_allocator_type =
+			typename allocator_traits<Alloc>::template rebind_alloc<ring>;
+		using slot_alloc_traits   = allocator_traits<slot_allocator_type>;
+		using ring_alloc_traits   = allocator_traits<ring_allocator_type>;
+
+		enum { INITIAL_CAPACITY = 64 };
+
+	protected:
+		alignas(CACHE_LINE_SIZE) std::atomic<difference_type> top;
+		alignas(CACHE_LINE_SIZE) std::atomic<difference_type> bottom;
+		std::atomic<ring*>                                    array;
+		slot_allocator_type                                   slot_allocator;
+		ring_allocator_type                                   ring_allocator;
+
+	public:
+		explicit work_stealing_deque(size_type cap = INITIAL_CAPACITY,
+									 const Alloc& alloc = Alloc())
+			:top(0), bottom(0), slot_allocator(alloc), ring_allocator(alloc)
+		{
+			difference_type n = 2;
+			while (n < difference_type(cap))
+				n <<= 1;
+			array.store(_new_ring(n, nullptr), std::memory_order_relaxed);
+		}
+
+		work_stealing_deque(const work_stealing_deque&) = delete;
+		work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+		~work_stealing_deque()
+		{
+			ring* r = array.load(std::memory_order_relaxed);
+			while (r)
+			{
+				ring* prev = r->prev;
+				_delete_ring(r);
+				r = prev;
+			}
+		}
+
+		allocator_type get_allocator() const
+			{ return allocator_type(slot_allocator); }
+
+		/* only a snapshot while thieves are working */
+		size_type size_approx() const noexcept
+		{
+			difference_type b = bottom.load(std::memory_order_relaxed);
+			difference_type t = top.load(std::memory_order_relaxed);
+			return b > t ? size_type(b - t) : 0;
+		}
+
+		bool empty_approx() const noexcept
+			{ return size_approx() == 0; }
+
+	public: // owner thread only
+		void push(T val)
+		{
+			difference_type b = bottom.load(std::memory_order_relaxed);
+			difference_type t = top.load(std::memory_order_acquire);
+			ring* a = array.load(std::memory_order_relaxed);
+			if (b - t > a->capacity - 1)
+				a = _grow(a, t, b);
+			a->put(b, val);
+			std::atomic_thread_fence(std::memory_order_release);
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+
+		bool pop(T& result)
+		{
+			difference_type b = bottom.load(std::memory_order_relaxed) - 1;
+			ring* a = array.load(std::memory_order_relaxed);
+			bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			difference_type t = top.load(std::memory_order_relaxed);
+			if (t > b) // empty
+			{
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return false;
+			}
+			result = a->get(b);
+			if (t == b) // the last one, race the thieves for it
+			{
+				bool won = top.compare_exchange_strong(t, t + 1,
+													   std::memory_order_seq_cst,
+													   std::memory_order_relaxed);
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return won;
+			}
+			return true;
+		}
+
+	public: // any thread
+		/* false when empty, or when another thread took the element first */
+		bool steal(T& result)
+		{
+			difference_type t = top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			difference_type b = bottom.load(std::memory_order_acquire);
+			if (t >= b)
+				return false;
+			ring* a = array.load(std::memory_order_acquire);
+			T val = a->get(t);
+			if (!top.compare_exchange_strong(t, t + 1,
+											 std::memory_order_seq_cst,
+											 std::memory_order_relaxed))
+				return false;
+			result = val;
+			return true;
+		}
+
+	protected:
+		ring* _new_ring(difference_type n, ring* prev)
+		{
+			ring* r = ring_alloc_traits::allocate(ring_allocator, 1);
+			r->capacity = n;
+			r->slots    = slot_alloc_traits::allocate(slot_allocator, size_type(n));
+			r->prev     = prev;
+			for (difference_type i = 0; i != n; ++i)
+				::new(static_cast<void*>(r->slots + i)) slot();
+			return r;
+		}
+
+		void _delete_ring(ring* r)
+		{
+			slot_alloc_traits::deallocate(slot_allocator, r->slots, size_type(r->capacity));
+			ring_alloc_traits::deallocate(ring_allocator, r, 1);
+		}
+
+		ring* _grow(ring* a, difference_type t, difference_type b)
+		{
+			ring* r = _new_ring(a->capacity * 2, a);
+			for (difference_type i = t; i != b; ++i)
+				r->put(i, a->get(i));
+			array.store(r, std::memory_order_release);
+			return r;
+		}
+	};
+}
+
+#endif /* _TINYSTL_WORK_STEALING_DEQUE_H_ */
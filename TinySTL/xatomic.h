@@ -0,0 +1,161 @@
+#pragma once
+#ifndef _TINYSTL_XATOMIC_H_
+#define _TINYSTL_XATOMIC_H_
+
+#include <atomic>  // std::atomic
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+
+/* primitives shared by the concurrent containers : padding, spinning and parking */
+
+#if defined(_WIN32)
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h> // WaitOnAddress
+#   pragma comment(lib, "Synchronization.lib")
+#elif defined(__linux__)
+#   include <linux/futex.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#else
+#   include <thread> // std::this_thread::yield
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#   include <immintrin.h> // _mm_pause
+#   define _TINYSTL_X86
+#endif
+
+namespace TinySTL
+{
+	/* keep hot counters of different threads on different lines (no false sharing) */
+	enum { CACHE_LINE_SIZE = 64 };
+
+	/* how many times to spin on a condition before parking the thread */
+	enum { SPIN_LIMIT = 64 };
+
+	inline void _cpu_relax()
+	{
+#if defined(_TINYSTL_X86)
+		_mm_pause();
+#elif defined(__aarch64__) || defined(_M_ARM64)
+		__asm__ __volatile__("yield");
+#else
+		std::this_thread::yield();
+#endif
+	}
+
+	/*
+		block while word == expected, may return spuriously
+		(callers always re-check their condition)
+	*/
+	inline void _futex_wait(std::atomic<uint32_t>& word, uint32_t expected)
+	{
+#if defined(_WIN32)
+		WaitOnAddress(&word, &expected, sizeof(uint32_t), INFINITE);
+#elif defined(__linux__)
+		syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+				FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+		if (word.load(std::memory_order_acquire) == expected)
+			std::this_thread::yield();
+#endif
+	}
+
+	inline void _futex_wake(std::atomic<uint32_t>& word, bool all)
+	{
+#if defined(_WIN32)
+		if (all) WakeByAddressAll(&word);
+		else WakeByAddressSingle(&word);
+#elif defined(__linux__)
+		syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+				FUTEX_WAKE_PRIVATE, all ? INT32_MAX : 1, nullptr, nullptr, 0);
+#else
+		(void)word; (void)all;
+#endif
+	}
+
+	/*
+		pointer + ABA tag packed into one lock-free 64-bit word
+		-x64/arm64 user space addresses fit in 48 bits, the tag takes the top 16
+		 (it would have to wrap around between a load and a CAS to fool us)
+		-32-bit pointers leave 32 bits for the tag
+	*/
+	template <class T>
+	class _tagged_ptr
+	{
+	public:
+		using word = uint64_t;
+
+		static constexpr int  ptr_bits = sizeof(void*) == 8 ? 48 : 32;
+		static constexpr word ptr_mask = (word(1) << ptr_bits) - 1;
+
+		static word pack(T* ptr, word tag)
+			{ return word(reinterpret_cast<uintptr_t>(ptr)) | (tag << ptr_bits); }
+		static T* ptr(word w)
+			{ return reinterpret_cast<T*>(uintptr_t(w & ptr_mask)); }
+		static word tag(word w)
+			{ return w >> ptr_bits; }
+	};
+
+	/*
+		event count : lets a thread sleep until some condition may have changed,
+					  without a mutex on the fast path.
+		   waiter   : key = prepare_wait(); if (cond) cancel_wait(); else wait(key);
+		   notifier : make cond true; notify_one() / notify_all();
+		-the notifier only pays a fence and a load when nobody is waiting.
+		-the seq_cst fences on both sides make sure that either the waiter sees
+		 the condition, or the notifier sees the waiter and bumps the epoch
+		 (so the futex wait on the old key fails immediately).
+	*/
+	class _event_count
+	{
+	protected:
+		std::atomic<uint32_t> epoch;
+		std::atomic<uint32_t> waiters;
+
+	public:
+		_event_count() :epoch(0), waiters(0) {}
+		_event_count(const _event_count&) = delete;
+		_event_count& operator=(const _event_count&) = delete;
+
+		uint32_t prepare_wait()
+		{
+			uint32_t key = epoch.load(std::memory_order_acquire);
+			waiters.fetch_add(1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			return key;
+		}
+
+		void cancel_wait()
+			{ waiters.fetch_sub(1, std::memory_order_relaxed); }
+
+		void wait(uint32_t key)
+		{
+			_futex_wait(epoch, key);
+			waiters.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void notify_one()
+			{ _notify(false); }
+		void notify_all()
+			{ _notify(true); }
+
+	protected:
+		void _notify(bool all)
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (waiters.load(std::memory_order_relaxed) != 0)
+			{
+				epoch.fetch_add(1, std::memory_order_release);
+				_futex_wake(epoch, all);
+			}
+		}
+	};
+}
+
+#endif /* _TINYSTL_XATOMIC_H_ */
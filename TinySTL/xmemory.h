@@ -202,8 +202,8 @@ namespace TinySTL
 		static void construct(Alloc alloc, T* ptr, Args&&... args)
 		{
 			if constexpr (_has_allocator_construct<Alloc, T*, Args...>::value)
-				alloc.construct(ptr, forward<Args>(args)...);
-			else ::new(static_cast<void*>(ptr)) T(forward<Args>(args)...);
+				alloc.construct(ptr, TinySTL::forward<Args>(args)...);
+			else ::new(static_cast<void*>(ptr)) T(TinySTL::forward<Args>(args)...);
 		}
 
 		template <class T>
@@ -292,8 +292,8 @@ namespace TinySTL
 		static void construct(Alloc alloc, T* ptr, Args&&... args)
 		{
 			if constexpr(_has_allocator_construct<Alloc, T*, Args...>::value)
-				alloc.construct(ptr, forward<Args>(args)...);
-			else ::new(static_cast<void*>(ptr)) T(forward<Args>(args)...);
+				alloc.construct(ptr, TinySTL::forward<Args>(args)...);
+			else ::new(static_cast<void*>(ptr)) T(TinySTL::forward<Args>(args)...);
 		}
 
 		template <class T>
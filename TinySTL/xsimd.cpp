@@ -0,0 +1,727 @@
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "xsimd.h"
+
+#if defined(_TINYSTL_SIMD)
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#   include <immintrin.h>
+#endif
+
+namespace TinySTL
+{
+#if defined(_TINYSTL_SIMD)
+	namespace
+	{
+		struct kernel_table
+		{
+			const void* (*find[_SIMD_KINDS])(const void*, const void*, const void*);
+			size_t      (*count[_SIMD_KINDS])(const void*, const void*, const void*);
+			const void* (*mismatch[_SIMD_KINDS])(const void*, const void*, const void*);
+			const void* (*adjacent_find[_SIMD_KINDS])(const void*, const void*);
+			bool        (*minmax_element[_SIMD_KINDS][2])(const void*, const void*, bool,
+														  const void**, const void**);
+			void        (*scan[_SIMD_F32])(const void*, const void*, void*, const void*, bool);
+			size_t      (*intersect_u32)(const void*, const void*, const void*, const void*, void*,
+										 const void**, const void**);
+			const void* (*search_bytes)(const void*, const void*, const void*, size_t);
+		};
+
+		inline int ctz64(uint64_t mask)
+		{
+#if defined(_MSC_VER)
+			unsigned long i;
+			_BitScanForward64(&i, mask);
+			return int(i);
+#else
+			return __builtin_ctzll(mask);
+#endif
+		}
+
+		/* movemask results are 32-bit ints, keep them from sign extending */
+		inline uint64_t mask32(int bits)
+			{ return uint64_t(uint32_t(bits)); }
+
+		namespace sse2
+		{
+			struct ops
+			{
+				using vec = __m128i;
+				enum { bytes = 16 };
+
+				template <class T>
+				static constexpr int stride = int(sizeof(T));
+
+				static vec load(const void* p)
+					{ return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+
+				template <class T>
+				static vec broadcast(T val)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm_castps_si128(_mm_set1_ps(val));
+					else if constexpr (std::is_same_v<T, double>)
+						return _mm_castpd_si128(_mm_set1_pd(val));
+					else if constexpr (sizeof(T) == 1)
+						return _mm_set1_epi8(char(val));
+					else if constexpr (sizeof(T) == 2)
+						return _mm_set1_epi16(short(val));
+					else if constexpr (sizeof(T) == 4)
+						return _mm_set1_epi32(int(val));
+					else
+						return _mm_set1_epi64x((long long)val);
+				}
+
+				template <class T>
+				static uint64_t eq(vec a, vec b)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return mask32(_mm_movemask_epi8(_mm_castps_si128(
+							_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)))));
+					else if constexpr (std::is_same_v<T, double>)
+						return mask32(_mm_movemask_epi8(_mm_castpd_si128(
+							_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)))));
+					else if constexpr (sizeof(T) == 1)
+						return mask32(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+					else if constexpr (sizeof(T) == 2)
+						return mask32(_mm_movemask_epi8(_mm_cmpeq_epi16(a, b)));
+					else if constexpr (sizeof(T) == 4)
+						return mask32(_mm_movemask_epi8(_mm_cmpeq_epi32(a, b)));
+					else
+					{
+						/* no 64-bit compare before SSE4.1 : both halves equal */
+						__m128i halves = _mm_cmpeq_epi32(a, b);
+						return mask32(_mm_movemask_epi8(_mm_and_si128(
+							halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)))));
+					}
+				}
+
+				static int ctz(uint64_t mask)
+					{ return ctz64(mask); }
+
+				/* no popcnt instruction guaranteed here */
+				static int popcount(uint64_t mask)
+				{
+					mask = mask - ((mask >> 1) & 0x5555555555555555ull);
+					mask = (mask & 0x3333333333333333ull) + ((mask >> 2) & 0x3333333333333333ull);
+					mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+					return int((mask * 0x0101010101010101ull) >> 56);
+				}
+
+				static void store(void* p, vec v)
+					{ _mm_storeu_si128(static_cast<__m128i*>(p), v); }
+				static vec bitxor(vec a, vec b)
+					{ return _mm_xor_si128(a, b); }
+
+				/* integers */
+				template <class T>
+				static vec add(vec a, vec b)
+				{
+					if constexpr (sizeof(T) == 1)
+						return _mm_add_epi8(a, b);
+					else if constexpr (sizeof(T) == 2)
+						return _mm_add_epi16(a, b);
+					else if constexpr (sizeof(T) == 4)
+						return _mm_add_epi32(a, b);
+					else
+						return _mm_add_epi64(a, b);
+				}
+
+				template <class T>
+				static vec sub(vec a, vec b)
+				{
+					if constexpr (sizeof(T) == 1)
+						return _mm_sub_epi8(a, b);
+					else if constexpr (sizeof(T) == 2)
+						return _mm_sub_epi16(a, b);
+					else if constexpr (sizeof(T) == 4)
+						return _mm_sub_epi32(a, b);
+					else
+						return _mm_sub_epi64(a, b);
+				}
+
+				template <int Bytes>
+				static vec shift_up(vec a)
+					{ return _mm_slli_si128(a, Bytes); }
+
+				/* 32-bit lane i gets lane (i + K) % lanes */
+				template <int K>
+				static vec rotate32(vec a)
+					{ return _mm_shuffle_epi32(a, _MM_SHUFFLE((K + 3) % 4, (K + 2) % 4, (K + 1) % 4, K % 4)); }
+
+				/* the highest lane in every lane : narrow ones widened up to 32 bits first */
+				template <class T>
+				static vec broadcast_last(vec a)
+				{
+					if constexpr (sizeof(T) == 8)
+						return _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 2, 3, 2));
+					if constexpr (sizeof(T) == 1)
+						a = _mm_unpackhi_epi8(a, a);
+					if constexpr (sizeof(T) <= 2)
+						a = _mm_shufflehi_epi16(a, _MM_SHUFFLE(3, 3, 3, 3));
+					return _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 3, 3, 3));
+				}
+
+				/* signed integers */
+				template <class T>
+				static vec gt(vec a, vec b)
+				{
+					if constexpr (sizeof(T) == 1)
+						return _mm_cmpgt_epi8(a, b);
+					else if constexpr (sizeof(T) == 2)
+						return _mm_cmpgt_epi16(a, b);
+					else if constexpr (sizeof(T) == 4)
+						return _mm_cmpgt_epi32(a, b);
+					else
+					{
+						/* high halves greater, or equal and low halves greater (unsigned) */
+						const __m128i sign = _mm_set1_epi32(int(0x80000000u));
+						__m128i hi_gt = _mm_cmpgt_epi32(a, b);
+						__m128i hi_eq = _mm_cmpeq_epi32(a, b);
+						__m128i lo_gt = _mm_cmpgt_epi32(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+						lo_gt = _mm_shuffle_epi32(lo_gt, _MM_SHUFFLE(2, 2, 0, 0));
+						__m128i r = _mm_or_si128(hi_gt, _mm_and_si128(hi_eq, lo_gt));
+						return _mm_shuffle_epi32(r, _MM_SHUFFLE(3, 3, 1, 1));
+					}
+				}
+
+				template <class T>
+				static vec min(vec a, vec b)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+					else if constexpr (std::is_same_v<T, double>)
+						return _mm_castpd_si128(_mm_min_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+					else if constexpr (sizeof(T) == 2)
+						return _mm_min_epi16(a, b);
+					else
+					{
+						__m128i a_gt = gt<T>(a, b);
+						return _mm_or_si128(_mm_and_si128(a_gt, b), _mm_andnot_si128(a_gt, a));
+					}
+				}
+
+				template <class T>
+				static vec max(vec a, vec b)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+					else if constexpr (std::is_same_v<T, double>)
+						return _mm_castpd_si128(_mm_max_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+					else if constexpr (sizeof(T) == 2)
+						return _mm_max_epi16(a, b);
+					else
+					{
+						__m128i a_gt = gt<T>(a, b);
+						return _mm_or_si128(_mm_and_si128(a_gt, a), _mm_andnot_si128(a_gt, b));
+					}
+				}
+
+				/* floating point, any NaN lane */
+				template <class T>
+				static bool has_nan(vec a)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm_movemask_ps(_mm_cmpunord_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(a))) != 0;
+					else
+						return _mm_movemask_pd(_mm_cmpunord_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(a))) != 0;
+				}
+			};
+
+#include "xsimd_kernels.h"
+		}
+
+#if defined(__clang__)
+#   pragma clang attribute push(__attribute__((target("avx2,bmi,popcnt"))), apply_to = function)
+#elif defined(__GNUC__)
+#   pragma GCC push_options
+#   pragma GCC target("avx2,bmi,popcnt")
+#endif
+		namespace avx2
+		{
+			struct ops
+			{
+				using vec = __m256i;
+				enum { bytes = 32 };
+
+				template <class T>
+				static constexpr int stride = int(sizeof(T));
+
+				static vec load(const void* p)
+					{ return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+
+				template <class T>
+				static vec broadcast(T val)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm256_castps_si256(_mm256_set1_ps(val));
+					else if constexpr (std::is_same_v<T, double>)
+						return _mm256_castpd_si256(_mm256_set1_pd(val));
+					else if constexpr (sizeof(T) == 1)
+						return _mm256_set1_epi8(char(val));
+					else if constexpr (sizeof(T) == 2)
+						return _mm256_set1_epi16(short(val));
+					else if constexpr (sizeof(T) == 4)
+						return _mm256_set1_epi32(int(val));
+					else
+						return _mm256_set1_epi64x((long long)val);
+				}
+
+				template <class T>
+				static uint64_t eq(vec a, vec b)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return mask32(_mm256_movemask_epi8(_mm256_castps_si256(
+							_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ))));
+					else if constexpr (std::is_same_v<T, double>)
+						return mask32(_mm256_movemask_epi8(_mm256_castpd_si256(
+							_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ))));
+					else if constexpr (sizeof(T) == 1)
+						return mask32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+					else if constexpr (sizeof(T) == 2)
+						return mask32(_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b)));
+					else if constexpr (sizeof(T) == 4)
+						return mask32(_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, b)));
+					else
+						return mask32(_mm256_movemask_epi8(_mm256_cmpeq_epi64(a, b)));
+				}
+
+				static int ctz(uint64_t mask)
+					{ return int(_tzcnt_u64(mask)); }
+				static int popcount(uint64_t mask)
+					{ return int(_mm_popcnt_u64(mask)); }
+
+				static void store(void* p, vec v)
+					{ _mm256_storeu_si256(static_cast<__m256i*>(p), v); }
+				static vec bitxor(vec a, vec b)
+					{ return _mm256_xor_si256(a, b); }
+
+				template <class T>
+				static vec add(vec a, vec b)
+				{
+					if constexpr (sizeof(T) == 1)
+						return _mm256_add_epi8(a, b);
+					else if constexpr (sizeof(T) == 2)
+						return _mm256_add_epi16(a, b);
+					else if constexpr (sizeof(T) == 4)
+						return _mm256_add_epi32(a, b);
+					else
+						return _mm256_add_epi64(a, b);
+				}
+
+				/* the low half moved up into the high one, then the bytes across the halves */
+				template <int Bytes>
+				static vec shift_up(vec a)
+				{
+					const __m256i low_up = _mm256_permute2x128_si256(a, a, 0x08);
+					if constexpr (Bytes == 16)
+						return low_up;
+					else
+						return _mm256_alignr_epi8(a, low_up, 16 - Bytes);
+				}
+
+				template <int K>
+				static vec rotate32(vec a)
+				{
+					return _mm256_permutevar8x32_epi32(a, _mm256_setr_epi32(
+						K % 8, (K + 1) % 8, (K + 2) % 8, (K + 3) % 8,
+						(K + 4) % 8, (K + 5) % 8, (K + 6) % 8, (K + 7) % 8));
+				}
+
+				template <class T>
+				static vec sub(vec a, vec b)
+				{
+					if constexpr (sizeof(T) == 1)
+						return _mm256_sub_epi8(a, b);
+					else if constexpr (sizeof(T) == 2)
+						return _mm256_sub_epi16(a, b);
+					else if constexpr (sizeof(T) == 4)
+						return _mm256_sub_epi32(a, b);
+					else
+						return _mm256_sub_epi64(a, b);
+				}
+
+				/* the top of each half first (like SSE2), then the top quadword everywhere */
+				template <class T>
+				static vec broadcast_last(vec a)
+				{
+					if constexpr (sizeof(T) == 1)
+						a = _mm256_unpackhi_epi8(a, a);
+					if constexpr (sizeof(T) <= 2)
+						a = _mm256_shufflehi_epi16(a, _MM_SHUFFLE(3, 3, 3, 3));
+					if constexpr (sizeof(T) <= 4)
+						a = _mm256_shuffle_epi32(a, _MM_SHUFFLE(3, 3, 3, 3));
+					return _mm256_permute4x64_epi64(a, _MM_SHUFFLE(3, 3, 3, 3));
+				}
+
+				/* signed integers or floating point */
+				template <class T>
+				static vec min(vec a, vec b)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+					else if constexpr (std::is_same_v<T, double>)
+						return _mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+					else if constexpr (sizeof(T) == 1)
+						return _mm256_min_epi8(a, b);
+					else if constexpr (sizeof(T) == 2)
+						return _mm256_min_epi16(a, b);
+					else if constexpr (sizeof(T) == 4)
+						return _mm256_min_epi32(a, b);
+					else
+						return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+				}
+
+				template <class T>
+				static vec max(vec a, vec b)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+					else if constexpr (std::is_same_v<T, double>)
+						return _mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+					else if constexpr (sizeof(T) == 1)
+						return _mm256_max_epi8(a, b);
+					else if constexpr (sizeof(T) == 2)
+						return _mm256_max_epi16(a, b);
+					else if constexpr (sizeof(T) == 4)
+						return _mm256_max_epi32(a, b);
+					else
+						return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+				}
+
+				template <class T>
+				static bool has_nan(vec a)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(a), _CMP_UNORD_Q)) != 0;
+					else
+						return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(a), _CMP_UNORD_Q)) != 0;
+				}
+			};
+
+#include "xsimd_kernels.h"
+		}
+#if defined(__clang__)
+#   pragma clang attribute pop
+#elif defined(__GNUC__)
+#   pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#   pragma clang attribute push(__attribute__((target("avx512f,avx512bw,avx2,bmi,popcnt"))), apply_to = function)
+#elif defined(__GNUC__)
+#   pragma GCC push_options
+#   pragma GCC target("avx512f,avx512bw,avx2,bmi,popcnt")
+#endif
+		namespace avx512
+		{
+			/* compares give one mask bit per element */
+			struct ops
+			{
+				using vec = __m512i;
+				enum { bytes = 64 };
+
+				template <class T>
+				static constexpr int stride = 1;
+
+				static vec load(const void* p)
+					{ return _mm512_loadu_si512(p); }
+
+				template <class T>
+				static vec broadcast(T val)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm512_castps_si512(_mm512_set1_ps(val));
+					else if constexpr (std::is_same_v<T, double>)
+						return _mm512_castpd_si512(_mm512_set1_pd(val));
+					else if constexpr (sizeof(T) == 1)
+						return _mm512_set1_epi8(char(val));
+					else if constexpr (sizeof(T) == 2)
+						return _mm512_set1_epi16(short(val));
+					else if constexpr (sizeof(T) == 4)
+						return _mm512_set1_epi32(int(val));
+					else
+						return _mm512_set1_epi64((long long)val);
+				}
+
+				template <class T>
+				static uint64_t eq(vec a, vec b)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm512_cmp_ps_mask(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b), _CMP_EQ_OQ);
+					else if constexpr (std::is_same_v<T, double>)
+						return _mm512_cmp_pd_mask(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b), _CMP_EQ_OQ);
+					else if constexpr (sizeof(T) == 1)
+						return _mm512_cmpeq_epi8_mask(a, b);
+					else if constexpr (sizeof(T) == 2)
+						return _mm512_cmpeq_epi16_mask(a, b);
+					else if constexpr (sizeof(T) == 4)
+						return _mm512_cmpeq_epi32_mask(a, b);
+					else
+						return _mm512_cmpeq_epi64_mask(a, b);
+				}
+
+				static int ctz(uint64_t mask)
+					{ return int(_tzcnt_u64(mask)); }
+				static int popcount(uint64_t mask)
+					{ return int(_mm_popcnt_u64(mask)); }
+
+				static void store(void* p, vec v)
+					{ _mm512_storeu_si512(p, v); }
+				static vec bitxor(vec a, vec b)
+					{ return _mm512_xor_si512(a, b); }
+
+				template <class T>
+				static vec add(vec a, vec b)
+				{
+					if constexpr (sizeof(T) == 1)
+						return _mm512_add_epi8(a, b);
+					else if constexpr (sizeof(T) == 2)
+						return _mm512_add_epi16(a, b);
+					else if constexpr (sizeof(T) == 4)
+						return _mm512_add_epi32(a, b);
+					else
+						return _mm512_add_epi64(a, b);
+				}
+
+				/* whole 128-bit lanes with valignq, the rest like AVX2 */
+				template <int Bytes>
+				static vec shift_up(vec a)
+				{
+					const __m512i zero = _mm512_setzero_si512();
+					if constexpr (Bytes % 16 == 0)
+						return _mm512_alignr_epi64(a, zero, 8 - Bytes / 8);
+					else
+						return _mm512_alignr_epi8(a, _mm512_alignr_epi64(a, zero, 6), 16 - Bytes);
+				}
+
+				template <int K>
+				static vec rotate32(vec a)
+					{ return _mm512_alignr_epi32(a, a, K); }
+
+				template <class T>
+				static vec sub(vec a, vec b)
+				{
+					if constexpr (sizeof(T) == 1)
+						return _mm512_sub_epi8(a, b);
+					else if constexpr (sizeof(T) == 2)
+						return _mm512_sub_epi16(a, b);
+					else if constexpr (sizeof(T) == 4)
+						return _mm512_sub_epi32(a, b);
+					else
+						return _mm512_sub_epi64(a, b);
+				}
+
+				/* no byte permute without VBMI : the top of each 128-bit lane, then the top lane */
+				template <class T>
+				static vec broadcast_last(vec a)
+				{
+					if constexpr (sizeof(T) == 1)
+						a = _mm512_shuffle_epi8(a, _mm512_set1_epi8(15));
+					else if constexpr (sizeof(T) == 2)
+						a = _mm512_shuffle_epi8(a, _mm512_set1_epi16(0x0F0E));
+					else if constexpr (sizeof(T) == 4)
+						return _mm512_permutexvar_epi32(_mm512_set1_epi32(15), a);
+					return _mm512_permutexvar_epi64(_mm512_set1_epi64(7), a);
+				}
+
+				template <class T>
+				static vec min(vec a, vec b)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm512_castps_si512(_mm512_min_ps(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b)));
+					else if constexpr (std::is_same_v<T, double>)
+						return _mm512_castpd_si512(_mm512_min_pd(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b)));
+					else if constexpr (sizeof(T) == 1)
+						return _mm512_min_epi8(a, b);
+					else if constexpr (sizeof(T) == 2)
+						return _mm512_min_epi16(a, b);
+					else if constexpr (sizeof(T) == 4)
+						return _mm512_min_epi32(a, b);
+					else
+						return _mm512_min_epi64(a, b);
+				}
+
+				template <class T>
+				static vec max(vec a, vec b)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm512_castps_si512(_mm512_max_ps(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b)));
+					else if constexpr (std::is_same_v<T, double>)
+						return _mm512_castpd_si512(_mm512_max_pd(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b)));
+					else if constexpr (sizeof(T) == 1)
+						return _mm512_max_epi8(a, b);
+					else if constexpr (sizeof(T) == 2)
+						return _mm512_max_epi16(a, b);
+					else if constexpr (sizeof(T) == 4)
+						return _mm512_max_epi32(a, b);
+					else
+						return _mm512_max_epi64(a, b);
+				}
+
+				template <class T>
+				static bool has_nan(vec a)
+				{
+					if constexpr (std::is_same_v<T, float>)
+						return _mm512_cmp_ps_mask(_mm512_castsi512_ps(a), _mm512_castsi512_ps(a), _CMP_UNORD_Q) != 0;
+					else
+						return _mm512_cmp_pd_mask(_mm512_castsi512_pd(a), _mm512_castsi512_pd(a), _CMP_UNORD_Q) != 0;
+				}
+			};
+
+#include "xsimd_kernels.h"
+		}
+#if defined(__clang__)
+#   pragma clang attribute pop
+#elif defined(__GNUC__)
+#   pragma GCC pop_options
+#endif
+
+		void cpuid(int regs[4], int leaf, int subleaf)
+		{
+#if defined(_MSC_VER)
+			__cpuidex(regs, leaf, subleaf);
+#else
+			unsigned a, b, c, d;
+			__cpuid_count(leaf, subleaf, a, b, c, d);
+			regs[0] = int(a); regs[1] = int(b); regs[2] = int(c); regs[3] = int(d);
+#endif
+		}
+
+		/* which register states the OS saves on context switches */
+		uint64_t xgetbv0()
+		{
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			unsigned lo, hi;
+			__asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+			return (uint64_t(hi) << 32) | lo;
+#endif
+		}
+
+		simd_level detect()
+		{
+			int regs[4];
+			cpuid(regs, 0, 0);
+			const int max_leaf = regs[0];
+			cpuid(regs, 1, 0);
+			const bool osxsave = (regs[2] >> 27) & 1;
+			const bool avx     = (regs[2] >> 28) & 1;
+			const bool popcnt  = (regs[2] >> 23) & 1;
+			if (!osxsave || !avx || !popcnt || max_leaf < 7)
+				return SIMD_SSE2;
+			const uint64_t xcr0 = xgetbv0();
+			if ((xcr0 & 0x6) != 0x6) // xmm, ymm
+				return SIMD_SSE2;
+			cpuid(regs, 7, 0);
+			const bool bmi1     = (regs[1] >> 3) & 1;
+			const bool avx2     = (regs[1] >> 5) & 1;
+			const bool avx512f  = (regs[1] >> 16) & 1;
+			const bool avx512bw = (regs[1] >> 30) & 1;
+			if (!avx2 || !bmi1)
+				return SIMD_SSE2;
+			if (avx512f && avx512bw && (xcr0 & 0xE6) == 0xE6) // + opmask, zmm
+				return SIMD_AVX512;
+			return SIMD_AVX2;
+		}
+
+		const kernel_table* table_of(simd_level level)
+		{
+			switch (level)
+			{
+			case SIMD_AVX512: return &avx512::table;
+			case SIMD_AVX2:   return &avx2::table;
+			default:          return &sse2::table;
+			}
+		}
+
+		struct dispatch
+		{
+			std::atomic<const kernel_table*> table;
+			std::atomic<simd_level>          level;
+
+			dispatch() :table(table_of(simd_supported_level())), level(simd_supported_level()) {}
+		};
+
+		/* function local : usable from the static initializers of other TUs */
+		dispatch& active()
+		{
+			static dispatch d;
+			return d;
+		}
+
+		const kernel_table* kernels()
+			{ return active().table.load(std::memory_order_relaxed); }
+	}
+
+	simd_level simd_supported_level()
+	{
+		static const simd_level level = detect();
+		return level;
+	}
+
+	simd_level simd_active_level()
+		{ return active().level.load(std::memory_order_relaxed); }
+
+	simd_level simd_set_level(simd_level level)
+	{
+		if (level > simd_supported_level())
+			level = simd_supported_level();
+		if (level < SIMD_SSE2) // x64 always has SSE2
+			level = SIMD_SSE2;
+		active().table.store(table_of(level), std::memory_order_relaxed);
+		active().level.store(level, std::memory_order_relaxed);
+		return level;
+	}
+
+	const void* _simd_find(const void* first, const void* last, const void* val, _simd_kind kind)
+		{ return kernels()->find[kind](first, last, val); }
+
+	size_t _simd_count(const void* first, const void* last, const void* val, _simd_kind kind)
+		{ return kernels()->count[kind](first, last, val); }
+
+	const void* _simd_mismatch(const void* first1, const void* last1,
+							   const void* first2, _simd_kind kind)
+		{ return kernels()->mismatch[kind](first1, last1, first2); }
+
+	const void* _simd_adjacent_find(const void* first, const void* last, _simd_kind kind)
+		{ return kernels()->adjacent_find[kind](first, last); }
+
+	bool _simd_minmax_element(const void* first, const void* last, _simd_kind kind,
+							  bool is_unsigned, bool last_max,
+							  const void** min_pos, const void** max_pos)
+	{
+		return kernels()->minmax_element[kind][is_unsigned](first, last, last_max,
+															min_pos, max_pos);
+	}
+
+	void _simd_scan(const void* first, const void* last, void* d_first, _simd_kind kind,
+					const void* init, bool exclusive)
+		{ kernels()->scan[kind](first, last, d_first, init, exclusive); }
+
+	size_t _simd_intersect_u32(const void* first1, const void* last1,
+							   const void* first2, const void* last2, void* result,
+							   const void** stop1, const void** stop2)
+	{
+		return kernels()->intersect_u32(first1, last1, first2, last2, result, stop1, stop2);
+	}
+
+	const void* _simd_search_bytes(const void* first, const void* last, const void* needle, size_t m)
+		{ return kernels()->search_bytes(first, last, needle, m); }
+#else
+	simd_level simd_supported_level()
+		{ return SIMD_NONE; }
+	simd_level simd_active_level()
+		{ return SIMD_NONE; }
+	simd_level simd_set_level(simd_level)
+		{ return SIMD_NONE; }
+#endif
+}
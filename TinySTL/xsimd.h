@@ -0,0 +1,145 @@
+#pragma once
+#ifndef _TINYSTL_XSIMD_H_
+#define _TINYSTL_XSIMD_H_
+
+#include <cstddef>     // size_t
+#include <type_traits> // std::is_integral_v, std::remove_cv_t
+
+/*
+	vectorized kernels behind the algorithms on contiguous arithmetic ranges
+	-the kernels live in xsimd.cpp, compiled for SSE2, AVX2 and AVX-512 (BW)
+	 side by side; the best one the CPU (and OS) supports is picked once,
+	 through CPUID, when the program starts.
+	-elements are compared like the scalar code does : integers bitwise,
+	 floating point with ordered equality (NaN != NaN, -0.0 == 0.0).
+	-anything but x64 gets no kernels, the algorithms stay scalar.
+*/
+
+#if defined(_M_X64) || defined(__x86_64__)
+#   define _TINYSTL_SIMD
+#   include <xmmintrin.h> // _mm_prefetch
+#endif
+
+namespace TinySTL
+{
+	enum simd_level { SIMD_NONE, SIMD_SSE2, SIMD_AVX2, SIMD_AVX512 };
+
+	/* the best level this machine runs */
+	simd_level simd_supported_level();
+
+	/* the level the algorithms currently use */
+	simd_level simd_active_level();
+
+	/*
+		forces a lower level (tests, benchmarks), clamped to the supported one,
+		returns the level in effect. not meant to race with running algorithms.
+	*/
+	simd_level simd_set_level(simd_level level);
+
+	/* a hint only, p may point anywhere (past the end of an array ...) */
+	inline void _prefetch(const void* p)
+	{
+#if defined(_TINYSTL_SIMD)
+		_mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+		(void)p;
+#endif
+	}
+
+	/* the element types the kernels know, one per size (integers) plus float/double */
+	enum _simd_kind { _SIMD_I8, _SIMD_I16, _SIMD_I32, _SIMD_I64, _SIMD_F32, _SIMD_F64,
+					  _SIMD_KINDS, _SIMD_NO_KIND = _SIMD_KINDS };
+
+	template <class T, class U = std::remove_cv_t<T> >
+	constexpr _simd_kind _simd_kind_of =
+		std::is_integral_v<U> ? (sizeof(U) == 1 ? _SIMD_I8  :
+								 sizeof(U) == 2 ? _SIMD_I16 :
+								 sizeof(U) == 4 ? _SIMD_I32 :
+								 sizeof(U) == 8 ? _SIMD_I64 : _SIMD_NO_KIND) :
+		std::is_same_v<U, float>  ? _SIMD_F32 :
+		std::is_same_v<U, double> ? _SIMD_F64 : _SIMD_NO_KIND;
+
+	/* Iter is a (const) T* over a type the kernels handle */
+	template <class Iter>
+	constexpr bool _simd_pointer = false;
+
+	template <class T>
+	constexpr bool _simd_pointer<T*> =
+#if defined(_TINYSTL_SIMD)
+		_simd_kind_of<T> != _SIMD_NO_KIND;
+#else
+		false;
+#endif
+
+	/* Iter points to elements of the very type of T */
+	template <class Iter, class T>
+	constexpr bool _simd_pointer_to =
+		_simd_pointer<Iter> &&
+		std::is_same_v<std::remove_cv_t<std::remove_pointer_t<Iter> >, std::remove_cv_t<T> >;
+
+	/*
+		*Iter == val can be looked up as *Iter == key, key being val converted
+		to the element type : same types, or integers (when key != val after
+		the conversion, no element can be equal to val either)
+	*/
+	template <class Iter, class T>
+	constexpr bool _simd_searchable =
+		_simd_pointer_to<Iter, T> ||
+		(_simd_pointer<Iter> && std::is_integral_v<std::remove_pointer_t<Iter> > &&
+		 std::is_integral_v<T>);
+
+	/* shorter ranges aren't worth the indirect call */
+	enum { SIMD_MIN_BYTES = 64 };
+
+	template <class T>
+	bool _simd_worth(const T* first, const T* last)
+		{ return size_t(last - first) * sizeof(T) >= SIMD_MIN_BYTES; }
+
+	template <class Iter>
+	Iter _simd_result(const void* ptr)
+		{ return static_cast<Iter>(const_cast<void*>(ptr)); }
+
+	/* first element equal to *val, or last */
+	const void* _simd_find(const void* first, const void* last, const void* val, _simd_kind kind);
+
+	size_t _simd_count(const void* first, const void* last, const void* val, _simd_kind kind);
+
+	/* first element of [first1, last1) different from its counterpart in first2, or last1 */
+	const void* _simd_mismatch(const void* first1, const void* last1,
+							   const void* first2, _simd_kind kind);
+
+	/* first element equal to the next one, or last */
+	const void* _simd_adjacent_find(const void* first, const void* last, _simd_kind kind);
+
+	/*
+		first smallest and first (or last, with last_max) largest element of the
+		non empty [first, last) by operator<, unsigned integers ordered as such.
+		false when the range holds a NaN : nothing is found then.
+	*/
+	bool _simd_minmax_element(const void* first, const void* last, _simd_kind kind,
+							  bool is_unsigned, bool last_max,
+							  const void** min_pos, const void** max_pos);
+
+	/*
+		running sums of integers (kind below _SIMD_F32), wrapping around :
+		d_first[i] = *init + first[0] + ... + first[i], or up to first[i - 1]
+		when exclusive. d_first may be first, no other overlap.
+	*/
+	void _simd_scan(const void* first, const void* last, void* d_first, _simd_kind kind,
+					const void* init, bool exclusive);
+
+	/*
+		set_intersection of sorted uint32_t arrays into result, the number of
+		elements written returned. stops early (*stop1, *stop2 : where) when
+		either array runs short or shows a duplicate, the rest is left to
+		the scalar code.
+	*/
+	size_t _simd_intersect_u32(const void* first1, const void* last1,
+							   const void* first2, const void* last2, void* result,
+							   const void** stop1, const void** stop2);
+
+	/* first occurrence of the bytes needle[0, m), m >= 2, in the bytes [first, last), or last */
+	const void* _simd_search_bytes(const void* first, const void* last, const void* needle, size_t m);
+}
+
+#endif /* _TINYSTL_XSIMD_H_ */
@@ -0,0 +1,350 @@
+/*
+	the kernels of xsimd.cpp, written once against an `ops` interface :
+	included by xsimd.cpp once per instruction set, inside the namespace of
+	that set and after its `ops`, hence no include guard.
+	  ops::vec                 : the register type
+	  ops::bytes               : its width
+	  ops::stride<T>           : bits per element in the masks of eq<T>
+	  ops::load(p)             : unaligned load
+	  ops::broadcast<T>(val)   : val in every lane
+	  ops::eq<T>(a, b)         : bit mask of the equal lanes, lowest address first
+	  ops::ctz, ops::popcount  : on the masks
+	  ops::store(p, v)         : unaligned store
+	  ops::bitxor(a, b)        : a ^ b
+	  ops::min<T>, ops::max<T> : lane wise, T signed or floating point
+	  ops::has_nan<T>(a)       : some lane of a is a NaN
+	  ops::add<T>, ops::sub<T> : lane wise, wrapping, T integral
+	  ops::broadcast_last<T>(a): the highest lane of a in every lane
+	  ops::rotate32<K>(a)      : 32-bit lane i gets lane (i + K) % lanes
+	  ops::shift_up<Bytes>(a)  : a moved Bytes bytes toward the higher addresses, zeros in
+*/
+
+template <class T>
+const void* find(const void* first_, const void* last_, const void* val_)
+{
+	const T* first = static_cast<const T*>(first_);
+	const T* last  = static_cast<const T*>(last_);
+	const T  val   = *static_cast<const T*>(val_);
+	constexpr ptrdiff_t n = ops::bytes / sizeof(T);
+	const typename ops::vec v = ops::template broadcast<T>(val);
+	for (; last - first >= n; first += n)
+		if (uint64_t mask = ops::template eq<T>(ops::load(first), v))
+			return first + ops::ctz(mask) / ops::template stride<T>;
+	for (; first != last; ++first)
+		if (*first == val)
+			return first;
+	return last;
+}
+
+template <class T>
+size_t count(const void* first_, const void* last_, const void* val_)
+{
+	const T* first = static_cast<const T*>(first_);
+	const T* last  = static_cast<const T*>(last_);
+	const T  val   = *static_cast<const T*>(val_);
+	constexpr ptrdiff_t n = ops::bytes / sizeof(T);
+	const typename ops::vec v = ops::template broadcast<T>(val);
+	size_t bits = 0;
+	for (; last - first >= n; first += n)
+		bits += ops::popcount(ops::template eq<T>(ops::load(first), v));
+	size_t ret = bits / ops::template stride<T>;
+	for (; first != last; ++first)
+		if (*first == val)
+			++ret;
+	return ret;
+}
+
+/* integers are compared byte by byte, floating point lane by lane */
+template <class T>
+const void* mismatch(const void* first1_, const void* last1_, const void* first2_)
+{
+	using C = std::conditional_t<std::is_floating_point_v<T>, T, uint8_t>;
+	const T* first1 = static_cast<const T*>(first1_);
+	const T* last1  = static_cast<const T*>(last1_);
+	const T* first2 = static_cast<const T*>(first2_);
+	constexpr ptrdiff_t n    = ops::bytes / sizeof(T);
+	constexpr int       bits = int(ops::bytes / sizeof(C)) * ops::template stride<C>;
+	constexpr uint64_t  all  = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+	for (; last1 - first1 >= n; first1 += n, first2 += n)
+		if (uint64_t mask = ~ops::template eq<C>(ops::load(first1), ops::load(first2)) & all)
+			return first1 + ops::ctz(mask) / ops::template stride<C> * sizeof(C) / sizeof(T);
+	for (; first1 != last1; ++first1, ++first2)
+		if (!(*first1 == *first2))
+			return first1;
+	return last1;
+}
+
+template <class T>
+const void* adjacent_find(const void* first_, const void* last_)
+{
+	const T* first = static_cast<const T*>(first_);
+	const T* last  = static_cast<const T*>(last_);
+	constexpr ptrdiff_t n = ops::bytes / sizeof(T);
+	for (; last - first > n; first += n)
+		if (uint64_t mask = ops::template eq<T>(ops::load(first), ops::load(first + 1)))
+			return first + ops::ctz(mask) / ops::template stride<T>;
+	for (; last - first > 1; ++first)
+		if (*first == *(first + 1))
+			return first;
+	return last;
+}
+
+/*
+	smallest element (the first one) and largest element (the first one, or
+	the last one with last_max) by operator<, in two passes :
+	-vector min/max per block of MINMAX_BLOCK bytes, remembering which block
+	 improved on the best values seen so far.
+	-a scalar scan of the winning blocks only, for the positions.
+	T is signed or floating point, unsigned integers come in biased by their
+	sign bit to order as signed ones. false (nothing written) when a NaN is
+	met : operator< isn't a strict weak order anymore, the caller goes scalar.
+*/
+enum { MINMAX_BLOCK = 4096 };
+
+template <class T, bool Unsigned>
+bool minmax_element(const void* first_, const void* last_, bool last_max,
+					const void** min_pos, const void** max_pos)
+{
+	const T* first = static_cast<const T*>(first_);
+	const T* last  = static_cast<const T*>(last_);
+	constexpr ptrdiff_t n     = ops::bytes / sizeof(T);
+	constexpr ptrdiff_t block = MINMAX_BLOCK / sizeof(T);
+	constexpr bool      fp    = std::is_floating_point_v<T>;
+	T bias = 0;
+	if constexpr (Unsigned)
+		bias = std::numeric_limits<T>::min();
+	const typename ops::vec vbias = ops::template broadcast<T>(bias);
+	auto key = [bias](T x)
+	{
+		if constexpr (Unsigned)
+			return T(x ^ bias);
+		else
+			return x;
+	};
+
+	T best_min = key(*first), best_max = best_min;
+	const T* min_block = first;
+	const T* max_block = first;
+	bool nan = false;
+	for (const T* p = first; p != last; )
+	{
+		const T* end = last - p > block ? p + block : last;
+		const T* q = p;
+		T lo = key(*p), hi = lo;
+		if (end - p >= n)
+		{
+			typename ops::vec vmin = ops::load(p);
+			if constexpr (Unsigned)
+				vmin = ops::bitxor(vmin, vbias);
+			typename ops::vec vmax = vmin;
+			if constexpr (fp)
+				nan |= ops::template has_nan<T>(vmin);
+			for (q = p + n; end - q >= n; q += n)
+			{
+				typename ops::vec x = ops::load(q);
+				if constexpr (Unsigned)
+					x = ops::bitxor(x, vbias);
+				if constexpr (fp)
+					nan |= ops::template has_nan<T>(x);
+				vmin = ops::template min<T>(vmin, x);
+				vmax = ops::template max<T>(vmax, x);
+			}
+			T lanes[n];
+			ops::store(lanes, vmin);
+			lo = lanes[0];
+			for (ptrdiff_t i = 1; i != n; ++i)
+				lo = lanes[i] < lo ? lanes[i] : lo;
+			ops::store(lanes, vmax);
+			hi = lanes[0];
+			for (ptrdiff_t i = 1; i != n; ++i)
+				hi = hi < lanes[i] ? lanes[i] : hi;
+		}
+		for (; q != end; ++q)
+		{
+			T x = key(*q);
+			if constexpr (fp)
+				nan |= x != x;
+			lo = x < lo ? x : lo;
+			hi = hi < x ? x : hi;
+		}
+		if (nan)
+			return false;
+		if (lo < best_min)
+			best_min = lo, min_block = p;
+		if (last_max ? !(hi < best_max) : best_max < hi)
+			best_max = hi, max_block = p;
+		p = end;
+	}
+
+	const T* q = min_block;
+	while (!(key(*q) == best_min))
+		++q;
+	*min_pos = q;
+	if (last_max)
+	{
+		q = last - max_block > block ? max_block + block : last;
+		while (!(key(*--q) == best_max))
+			;
+	}
+	else
+	{
+		q = max_block;
+		while (!(key(*q) == best_max))
+			++q;
+	}
+	*max_pos = q;
+	return true;
+}
+
+/* running sums inside a register : log2(lanes) shifted additions */
+template <class T, int Lanes = 1>
+typename ops::vec prefix_sum(typename ops::vec x)
+{
+	if constexpr (Lanes < int(ops::bytes / sizeof(T)))
+		return prefix_sum<T, Lanes * 2>(
+			ops::template add<T>(x, ops::template shift_up<Lanes * int(sizeof(T))>(x)));
+	else
+		return x;
+}
+
+/*
+	d_first[i] = init + first[0] + ... + first[i] (first[i - 1] when exclusive),
+	T unsigned so that the sums wrap. the carry stays in a register, every
+	lane holding it. d_first may be first : every vector is loaded before its
+	results are stored.
+*/
+template <class T>
+void scan(const void* first_, const void* last_, void* d_first_, const void* init_, bool exclusive)
+{
+	const T* first = static_cast<const T*>(first_);
+	const T* last  = static_cast<const T*>(last_);
+	T*       out   = static_cast<T*>(d_first_);
+	T        carry = *static_cast<const T*>(init_);
+	constexpr ptrdiff_t n = ops::bytes / sizeof(T);
+	if (last - first >= n)
+	{
+		typename ops::vec vcarry = ops::template broadcast<T>(carry);
+		for (; last - first >= n; first += n, out += n)
+		{
+			typename ops::vec x   = ops::load(first);
+			typename ops::vec sum = ops::template add<T>(prefix_sum<T>(x), vcarry);
+			ops::store(out, exclusive ? ops::template sub<T>(sum, x) : sum);
+			vcarry = ops::template broadcast_last<T>(sum);
+		}
+		T lanes[n];
+		ops::store(lanes, vcarry);
+		carry = lanes[0];
+	}
+	for (; first != last; ++first, ++out)
+	{
+		const T x = *first;
+		if (exclusive)
+			*out = carry;
+		carry = T(carry + x);
+		if (!exclusive)
+			*out = carry;
+	}
+}
+
+/* every other rotation of b against a : the lanes of a equal to some lane of b */
+template <int K = 1>
+uint64_t match_any32(typename ops::vec a, typename ops::vec b, uint64_t mask)
+{
+	if constexpr (K < int(ops::bytes / 4))
+		return match_any32<K + 1>(a, b, mask | ops::template eq<uint32_t>(a, ops::template rotate32<K>(b)));
+	else
+		return mask;
+}
+
+/*
+	intersection of two sorted uint32_t arrays, a block of lanes against a
+	block of lanes (all pairs, through rotations), the block with the
+	smaller maximum moves on. exact only without duplicates : each block is
+	compared with its successor shifted by one first, an equal pair stops
+	the kernel, as does the end of either array; *stop1 / *stop2 tell where,
+	the number of elements written to result is returned.
+*/
+size_t intersect_u32(const void* first1_, const void* last1_, const void* first2_,
+					 const void* last2_, void* result_, const void** stop1, const void** stop2)
+{
+	const uint32_t* a      = static_cast<const uint32_t*>(first1_);
+	const uint32_t* last1  = static_cast<const uint32_t*>(last1_);
+	const uint32_t* b      = static_cast<const uint32_t*>(first2_);
+	const uint32_t* last2  = static_cast<const uint32_t*>(last2_);
+	uint32_t*       out    = static_cast<uint32_t*>(result_);
+	uint32_t*       result = out;
+	constexpr ptrdiff_t n      = ops::bytes / 4;
+	constexpr int       stride = ops::template stride<uint32_t>;
+	constexpr uint64_t  lane   = stride == 64 ? ~uint64_t(0) : (uint64_t(1) << stride) - 1;
+	while (last1 - a > n && last2 - b > n)
+	{
+		const typename ops::vec va = ops::load(a), vb = ops::load(b);
+		if (ops::template eq<uint32_t>(va, ops::load(a + 1)) |
+			ops::template eq<uint32_t>(vb, ops::load(b + 1)))
+			break;
+		for (uint64_t mask = match_any32(va, vb, ops::template eq<uint32_t>(va, vb)); mask != 0; )
+		{
+			const int bit = ops::ctz(mask);
+			*out++ = a[bit / stride];
+			mask &= ~(lane << bit);
+		}
+		const uint32_t max1 = a[n - 1], max2 = b[n - 1];
+		a += max1 <= max2 ? n : 0;
+		b += max2 <= max1 ? n : 0;
+	}
+	*stop1 = a;
+	*stop2 = b;
+	return size_t(out - result);
+}
+
+/*
+	first occurrence of needle[0, m) in [first, last), m >= 2 : the lanes
+	where both needle[0] and needle[m - 1] sit at the right distance are
+	candidates, checked with memcmp (W. Mula, "SIMD-friendly algorithms for
+	substring searching", 2016)
+*/
+const void* search_bytes(const void* first_, const void* last_, const void* needle_, size_t m)
+{
+	const uint8_t* first  = static_cast<const uint8_t*>(first_);
+	const uint8_t* last   = static_cast<const uint8_t*>(last_);
+	const uint8_t* needle = static_cast<const uint8_t*>(needle_);
+	const typename ops::vec head = ops::template broadcast<uint8_t>(needle[0]);
+	const typename ops::vec tail = ops::template broadcast<uint8_t>(needle[m - 1]);
+	const ptrdiff_t span = ptrdiff_t(m) - 1;
+	for (; last - first >= span + ptrdiff_t(ops::bytes); first += ops::bytes)
+	{
+		uint64_t mask = ops::template eq<uint8_t>(ops::load(first), head) &
+						ops::template eq<uint8_t>(ops::load(first + span), tail);
+		for (; mask != 0; mask &= mask - 1)
+		{
+			const uint8_t* candidate = first + ops::ctz(mask);
+			if (memcmp(candidate + 1, needle + 1, m - 2) == 0)
+				return candidate;
+		}
+	}
+	for (; last - first > span; ++first)
+		if (*first == needle[0] && memcmp(first + 1, needle + 1, m - 1) == 0)
+			return first;
+	return last;
+}
+
+const kernel_table table =
+{
+	{ find<uint8_t>, find<uint16_t>, find<uint32_t>, find<uint64_t>,
+	  find<float>, find<double> },
+	{ count<uint8_t>, count<uint16_t>, count<uint32_t>, count<uint64_t>,
+	  count<float>, count<double> },
+	{ mismatch<uint8_t>, mismatch<uint16_t>, mismatch<uint32_t>, mismatch<uint64_t>,
+	  mismatch<float>, mismatch<double> },
+	{ adjacent_find<uint8_t>, adjacent_find<uint16_t>, adjacent_find<uint32_t>,
+	  adjacent_find<uint64_t>, adjacent_find<float>, adjacent_find<double> },
+	{ { minmax_element<int8_t,  false>, minmax_element<int8_t,  true> },
+	  { minmax_element<int16_t, false>, minmax_element<int16_t, true> },
+	  { minmax_element<int32_t, false>, minmax_element<int32_t, true> },
+	  { minmax_element<int64_t, false>, minmax_element<int64_t, true> },
+	  { minmax_element<float,   false>, minmax_element<float,   false> },
+	  { minmax_element<double,  false>, minmax_element<double,  false> } },
+	{ scan<uint8_t>, scan<uint16_t>, scan<uint32_t>, scan<uint64_t> },
+	intersect_u32,
+	search_bytes,
+};
@@ -0,0 +1,71 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/priority_queue.h"
+#include "../TinySTL/queue.h"
+#include "../TinySTL/stack.h"
+
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace AdapterUnitTest
+{
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* queue : FIFO, push_range / pop_n */
+		TEST_METHOD(TestMethod1)
+		{
+			TinySTL::queue<int> q;
+			q.reserve(1000);
+			std::vector<int> a(1000);
+			for (int i = 0; i < 1000; ++i)
+				a[i] = i;
+			q.push(-1);
+			q.pop();
+			q.push_range(a.data(), a.data() + 1000);
+			Assert::AreEqual(0, q.front());
+			std::vector<int> b(1000);
+			int* rest = q.pop_n(600, b.data());
+			Assert::IsTrue(rest == b.data() + 600);
+			rest = q.pop_n(600, rest);
+			Assert::IsTrue(rest == b.data() + 1000);
+			Assert::IsTrue(q.empty());
+			Assert::IsTrue(a == b);
+		}
+
+		/* stack : LIFO, push_range / pop_n */
+		TEST_METHOD(TestMethod2)
+		{
+			TinySTL::stack<int> s;
+			int a[3] = { 1, 2, 3 };
+			s.push_range(a, a + 3);
+			Assert::AreEqual(3, s.top());
+			int b[3] = { 0 };
+			s.pop_n(2, b);
+			Assert::AreEqual(3, b[0]);
+			Assert::AreEqual(2, b[1]);
+			Assert::AreEqual(size_t(1), s.size());
+			Assert::AreEqual(1, s.top());
+		}
+
+		/* priority_queue : small and large batches, pop_n in priority order */
+		TEST_METHOD(TestMethod3)
+		{
+			TinySTL::priority_queue<int> q;
+			q.reserve(2000);
+			std::vector<int> a;
+			for (int i = 0; i < 1000; ++i)
+				a.push_back((i * 7919) % 1000);
+			q.push_range(a.data(), a.data() + 1000); // rebuilt
+			q.push_range(a.data(), a.data() + 10);   // sifted up
+			Assert::AreEqual(size_t(1010), q.size());
+			std::vector<int> b(1010);
+			q.pop_n(2000, b.data());
+			Assert::IsTrue(q.empty());
+			for (size_t i = 1; i < b.size(); ++i)
+				Assert::IsTrue(b[i - 1] >= b[i]);
+			Assert::AreEqual(999, b[0]);
+		}
+	};
+}
@@ -0,0 +1,928 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/algorithm.h"
+#include "../TinySTL/deque.h"
+#include "../TinySTL/polymorphic_allocator.h"
+#include "../TinySTL/tempbuf.h"
+#include "../TinySTL/vector.h"
+#include "../TinySTL/xsimd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <sstream>
+#include <string>
+#include <random>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace AlgorithmUnitTest
+{
+	struct record
+	{
+		uint32_t key;
+		int      payload;
+	};
+
+	/* refuses anything bigger than limit bytes */
+	class capped_resource :public TinySTL::memory_resource
+	{
+	public:
+		size_t limit;
+		size_t in_use;
+		size_t peak;
+
+		explicit capped_resource(size_t n) :limit(n), in_use(0), peak(0) {}
+
+	protected:
+		void* do_allocate(size_t bytes, size_t) override
+		{
+			if (bytes > limit)
+				throw std::bad_alloc();
+			in_use += bytes;
+			if (in_use > peak)
+				peak = in_use;
+			return ::operator new(bytes);
+		}
+		void do_deallocate(void* ptr, size_t bytes, size_t) override
+		{
+			in_use -= bytes;
+			::operator delete(ptr);
+		}
+		bool do_is_equal(const TinySTL::memory_resource& other) const noexcept override
+			{ return this == &other; }
+	};
+
+	/* find, count, mismatch, equal, adjacent_find against std, on every length and position */
+	template <class T>
+	void check_searches()
+	{
+		std::mt19937 gen(10);
+		for (int len = 0; len < 200; ++len)
+		{
+			std::vector<T> v(len);
+			for (auto& x : v)
+				x = T(gen() % 4);
+			const T* first = v.data();
+			const T* last  = v.data() + len;
+			for (int k = 0; k < 5; ++k)
+			{
+				Assert::IsTrue(std::find(first, last, T(k)) == TinySTL::find(first, last, T(k)));
+				Assert::AreEqual(ptrdiff_t(std::count(first, last, T(k))),
+								 ptrdiff_t(TinySTL::count(first, last, T(k))));
+			}
+			Assert::IsTrue(std::adjacent_find(first, last) == TinySTL::adjacent_find(first, last));
+			for (int pos = 0; pos <= len; pos += 1 + len / 10)
+			{
+				std::vector<T> w = v;
+				if (pos != len)
+					w[pos] = T(7);
+				Assert::IsTrue(TinySTL::mismatch(first, last, w.data()).first == first + pos);
+				Assert::AreEqual(pos == len, TinySTL::equal(first, last, w.data()));
+			}
+		}
+	}
+
+	/* min/max/minmax_element against std : narrow values (ties) and full range ones, past a kernel block */
+	template <class T>
+	void check_minmax()
+	{
+		std::mt19937_64 gen(11);
+		const int lens[] = { 0, 1, 2, 3, 15, 16, 17, 31, 64, 100, 199, 1000, 4095, 4097, 9000, 20000 };
+		for (int len : lens)
+			for (int narrow = 0; narrow < 2; ++narrow)
+			{
+				std::vector<T> v(len);
+				for (auto& x : v)
+					x = narrow ? T(gen() % 5) : T(gen());
+				const T* first = v.data();
+				const T* last  = v.data() + len;
+				Assert::IsTrue(std::min_element(first, last) == TinySTL::min_element(first, last));
+				Assert::IsTrue(std::max_element(first, last) == TinySTL::max_element(first, last));
+				auto expected = std::minmax_element(first, last);
+				auto got = TinySTL::minmax_element(first, last);
+				Assert::IsTrue(expected.first == got.first && expected.second == got.second);
+			}
+	}
+
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* radix_sort : unsigned, signed 64-bit, in vector and deque */
+		TEST_METHOD(TestMethod1)
+		{
+			std::mt19937_64 gen(1);
+			TinySTL::vector<uint32_t> v1;
+			TinySTL::deque<int64_t>   d1;
+			std::vector<uint32_t>     v2;
+			std::vector<int64_t>      d2;
+			for (int i = 0; i < 100000; ++i)
+			{
+				uint64_t x = gen();
+				v1.push_back(uint32_t(x));
+				v2.push_back(uint32_t(x));
+				d1.push_back(int64_t(x) >> (i % 40));
+				d2.push_back(int64_t(x) >> (i % 40));
+			}
+			TinySTL::radix_sort(v1.begin(), v1.end());
+			TinySTL::radix_sort(d1.begin(), d1.end());
+			std::sort(v2.begin(), v2.end());
+			std::sort(d2.begin(), d2.end());
+			for (int i = 0; i < 100000; ++i)
+			{
+				Assert::AreEqual(v2[i], v1[i]);
+				Assert::IsTrue(d2[i] == d1[i]);
+			}
+		}
+
+		/* radix_sort : floats and doubles with negatives, short ranges */
+		TEST_METHOD(TestMethod2)
+		{
+			std::mt19937 gen(2);
+			std::uniform_real_distribution<double> dist(-1e6, 1e6);
+			std::vector<float>  f1, f2;
+			std::vector<double> g1, g2;
+			for (int i = 0; i < 10000; ++i)
+			{
+				double x = dist(gen);
+				f1.push_back(float(x));
+				g1.push_back(x);
+			}
+			f2 = f1;
+			g2 = g1;
+			TinySTL::radix_sort(f1.data(), f1.data() + f1.size());
+			TinySTL::radix_sort(g1.data(), g1.data() + g1.size());
+			std::sort(f2.begin(), f2.end());
+			std::sort(g2.begin(), g2.end());
+			Assert::IsTrue(f1 == f2);
+			Assert::IsTrue(g1 == g2);
+
+			int small[6] = { 5, -3, 0, 7, -3, 1 };
+			TinySTL::radix_sort(small, small + 6);
+			Assert::IsTrue(std::is_sorted(small, small + 6));
+		}
+
+		/* radix_sort : records by key, stable, short ranges included */
+		TEST_METHOD(TestMethod3)
+		{
+			std::mt19937 gen(3);
+			for (int n : { 2, 30, 255, 256, 50000 })
+			{
+				std::vector<record> v1(n);
+				for (int i = 0; i < n; ++i)
+				{
+					v1[i].key     = gen() % (n < 1000 ? 8 : 1000);
+					v1[i].payload = i;
+				}
+				std::vector<record> v2 = v1;
+				TinySTL::radix_sort(v1.data(), v1.data() + v1.size(),
+									[](const record& r) { return r.key; });
+				std::stable_sort(v2.begin(), v2.end(),
+								 [](const record& x, const record& y) { return x.key < y.key; });
+				for (int i = 0; i < n; ++i)
+				{
+					Assert::AreEqual(v2[i].key, v1[i].key);
+					Assert::AreEqual(v2[i].payload, v1[i].payload);
+				}
+			}
+		}
+
+		/* sort : random, sorted, reversed, few distinct, organ pipe */
+		TEST_METHOD(TestMethod4)
+		{
+			std::mt19937 gen(4);
+			const int n = 100000;
+			for (int pattern = 0; pattern < 5; ++pattern)
+			{
+				std::vector<int> v1(n);
+				for (int i = 0; i < n; ++i)
+				{
+					switch (pattern)
+					{
+					case 0: v1[i] = int(gen()); break;
+					case 1: v1[i] = i; break;
+					case 2: v1[i] = n - i; break;
+					case 3: v1[i] = int(gen() % 8); break;
+					default: v1[i] = i < n / 2 ? i : n - i; break;
+					}
+				}
+				std::vector<int> v2 = v1;
+				TinySTL::sort(v1.data(), v1.data() + n);
+				std::sort(v2.begin(), v2.end());
+				Assert::IsTrue(v1 == v2);
+			}
+		}
+
+		/* sort : deque with a custom comparison, records, short ranges */
+		TEST_METHOD(TestMethod5)
+		{
+			std::mt19937 gen(5);
+			TinySTL::deque<int> d1;
+			std::vector<int>    d2;
+			for (int i = 0; i < 50000; ++i)
+			{
+				int x = int(gen() % 5000);
+				d1.push_back(x);
+				d2.push_back(x);
+			}
+			TinySTL::sort(d1.begin(), d1.end(), [](int x, int y) { return x > y; });
+			std::sort(d2.begin(), d2.end(), [](int x, int y) { return x > y; });
+			for (int i = 0; i < 50000; ++i)
+				Assert::AreEqual(d2[i], d1[i]);
+
+			std::vector<record> r(20000);
+			for (auto& x : r)
+				x.key = gen() % 100;
+			TinySTL::sort(r.data(), r.data() + r.size(),
+						  [](const record& x, const record& y) { return x.key < y.key; });
+			for (size_t i = 1; i < r.size(); ++i)
+				Assert::IsTrue(r[i - 1].key <= r[i].key);
+
+			for (int len = 0; len < 100; ++len)
+			{
+				std::vector<int> v1(len);
+				for (auto& x : v1)
+					x = int(gen() % 10);
+				std::vector<int> v2 = v1;
+				TinySTL::sort(v1.data(), v1.data() + len);
+				std::sort(v2.begin(), v2.end());
+				Assert::IsTrue(v1 == v2);
+			}
+		}
+
+		/* stable_sort : stability on records, vector and deque */
+		TEST_METHOD(TestMethod6)
+		{
+			std::mt19937 gen(6);
+			auto by_key = [](const record& x, const record& y) { return x.key < y.key; };
+			for (int n : { 0, 1, 2, 15, 16, 100, 100000 })
+			{
+				std::vector<record>    r1(n);
+				TinySTL::deque<record> r2;
+				for (int i = 0; i < n; ++i)
+				{
+					r1[i] = record{ uint32_t(gen() % 64), i };
+					r2.push_back(r1[i]);
+				}
+				std::vector<record> r3 = r1;
+				TinySTL::stable_sort(r1.data(), r1.data() + n, by_key);
+				TinySTL::stable_sort(r2.begin(), r2.end(), by_key);
+				std::stable_sort(r3.begin(), r3.end(), by_key);
+				for (int i = 0; i < n; ++i)
+				{
+					Assert::AreEqual(r3[i].payload, r1[i].payload);
+					Assert::AreEqual(r3[i].payload, r2[i].payload);
+				}
+			}
+		}
+
+		/* inplace_merge, merge_without_buffer, stable_partition, rotate */
+		TEST_METHOD(TestMethod7)
+		{
+			std::mt19937 gen(7);
+			auto by_key = [](const record& x, const record& y) { return x.key < y.key; };
+			for (int mid : { 0, 1, 500, 9999, 10000 })
+			{
+				std::vector<record> r1(10000);
+				for (int i = 0; i < 10000; ++i)
+					r1[i] = record{ uint32_t(gen() % 100), i };
+				std::sort(r1.begin(), r1.begin() + mid, by_key);
+				std::sort(r1.begin() + mid, r1.end(), by_key);
+				std::vector<record> r2 = r1, r3 = r1;
+				TinySTL::inplace_merge(r1.data(), r1.data() + mid, r1.data() + 10000, by_key);
+				TinySTL::merge_without_buffer(r2.data(), r2.data() + mid, r2.data() + 10000,
+											  ptrdiff_t(mid), ptrdiff_t(10000 - mid), by_key);
+				std::inplace_merge(r3.begin(), r3.begin() + mid, r3.end(), by_key);
+				for (int i = 0; i < 10000; ++i)
+				{
+					Assert::AreEqual(r3[i].payload, r1[i].payload);
+					Assert::AreEqual(r3[i].payload, r2[i].payload);
+				}
+			}
+
+			std::vector<int> v1(10001);
+			for (auto& x : v1)
+				x = int(gen() % 1000);
+			std::vector<int> v2 = v1;
+			auto odd = [](int x) { return x % 2 != 0; };
+			int* p = TinySTL::stable_partition(v1.data(), v1.data() + v1.size(), odd);
+			auto q = std::stable_partition(v2.begin(), v2.end(), odd);
+			Assert::AreEqual(q - v2.begin(), p - v1.data());
+			Assert::IsTrue(v1 == v2);
+
+			int a[7] = { 0, 1, 2, 3, 4, 5, 6 };
+			int* r = TinySTL::rotate(a, a + 3, a + 7);
+			Assert::IsTrue(r == a + 4);
+			for (int i = 0; i < 7; ++i)
+				Assert::AreEqual((i + 3) % 7, a[i]);
+
+			/* a one-element right side : as many passes as elements, none of them on the stack */
+			const int n = 300000;
+			std::vector<int> big(n);
+			for (int i = 0; i < n; ++i)
+				big[i] = i;
+			r = TinySTL::rotate(big.data(), big.data() + n - 1, big.data() + n);
+			Assert::IsTrue(r == big.data() + 1);
+			Assert::AreEqual(n - 1, big[0]);
+			for (int i = 1; i < n; ++i)
+				Assert::AreEqual(i - 1, big[i]);
+			for (int i = 0; i < n - 1; ++i)
+				big[i] = i + 1;
+			big[n - 1] = 0;
+			TinySTL::merge_without_buffer(big.data(), big.data() + n - 1, big.data() + n,
+										  ptrdiff_t(n - 1), ptrdiff_t(1));
+			for (int i = 0; i < n; ++i)
+				Assert::AreEqual(i, big[i]);
+		}
+
+		/* temporary_buffer : thread cache, partial buffers from a memory_resource */
+		TEST_METHOD(TestMethod8)
+		{
+			int* first;
+			{
+				TinySTL::temporary_buffer<int> buf(1000);
+				Assert::AreEqual(size_t(1000), buf.size());
+				first = buf.data();
+				TinySTL::temporary_buffer<int> nested(10);
+				Assert::AreEqual(size_t(10), nested.size());
+				Assert::IsTrue(nested.data() != first);
+			}
+			{
+				TinySTL::temporary_buffer<int> buf(500);
+				Assert::IsTrue(buf.data() == first);
+			}
+			TinySTL::release_temporary_buffers();
+
+			capped_resource res(4000 * sizeof(record));
+			using alloc_type = TinySTL::polymorphic_allocator<record>;
+			{
+				TinySTL::temporary_buffer<record, alloc_type> buf(10000, alloc_type(&res));
+				Assert::AreEqual(size_t(10000), buf.requested_size());
+				Assert::AreEqual(size_t(2500), buf.size());
+				Assert::AreEqual(2500 * sizeof(record), res.in_use);
+
+				std::mt19937 gen(8);
+				std::vector<record> r1(20000);
+				for (int i = 0; i < 20000; ++i)
+					r1[i] = record{ uint32_t(gen() % 100), i };
+				auto by_key = [](const record& x, const record& y) { return x.key < y.key; };
+				std::sort(r1.begin(), r1.begin() + 12000, by_key);
+				std::sort(r1.begin() + 12000, r1.end(), by_key);
+				TinySTL::adaptive_merge(r1.data(), r1.data() + 12000, r1.data() + 20000,
+										ptrdiff_t(12000), ptrdiff_t(8000),
+										buf.data(), ptrdiff_t(buf.size()), by_key);
+				std::vector<record> r3(r1);
+				std::stable_sort(r3.begin(), r3.end(), by_key);
+				for (int i = 0; i < 20000; ++i)
+					Assert::AreEqual(r3[i].payload, r1[i].payload);
+			}
+			Assert::AreEqual(size_t(0), res.in_use);
+
+			/* stable_sort, inplace_merge, stable_partition with their scratch memory from a resource */
+			auto by_key = [](const record& x, const record& y) { return x.key < y.key; };
+			auto even = [](const record& x) { return x.key % 2 == 0; };
+			for (size_t cap : { size_t(0), 1000 * sizeof(record), 20000 * sizeof(record) })
+			{
+				capped_resource limited(cap);
+				alloc_type alloc(&limited);
+				std::mt19937 gen(80);
+				std::vector<record> r1(20000);
+				for (int i = 0; i < 20000; ++i)
+					r1[i] = record{ uint32_t(gen() % 100), i };
+				std::vector<record> r2 = r1, r3 = r1;
+				TinySTL::stable_sort(r1.data(), r1.data() + 20000, by_key, alloc);
+				std::stable_sort(r3.begin(), r3.end(), by_key);
+				for (int i = 0; i < 20000; ++i)
+					Assert::AreEqual(r3[i].payload, r1[i].payload);
+
+				std::sort(r2.begin(), r2.begin() + 7000, by_key);
+				std::sort(r2.begin() + 7000, r2.end(), by_key);
+				r3 = r2;
+				TinySTL::inplace_merge(r2.data(), r2.data() + 7000, r2.data() + 20000, by_key,
+									   TinySTL::polymorphic_allocator<char>(&limited));
+				std::inplace_merge(r3.begin(), r3.begin() + 7000, r3.end(), by_key);
+				for (int i = 0; i < 20000; ++i)
+					Assert::AreEqual(r3[i].payload, r2[i].payload);
+
+				r3 = r1;
+				record* p = TinySTL::stable_partition(r1.data(), r1.data() + 20000, even, alloc);
+				auto q = std::stable_partition(r3.begin(), r3.end(), even);
+				Assert::AreEqual(q - r3.begin(), p - r1.data());
+				for (int i = 0; i < 20000; ++i)
+					Assert::AreEqual(r3[i].payload, r1[i].payload);
+
+				Assert::AreEqual(size_t(0), limited.in_use);
+				Assert::IsTrue(limited.peak <= cap && (cap == 0 || limited.peak != 0));
+			}
+		}
+
+		/* stable_sort : concatenated runs, descending runs, partial buffers */
+		TEST_METHOD(TestMethod9)
+		{
+			std::mt19937 gen(9);
+			auto by_key = [](const record& x, const record& y) { return x.key < y.key; };
+			const int n = 50000;
+			for (int pattern = 0; pattern < 4; ++pattern)
+			{
+				std::vector<record> r1(n);
+				for (int i = 0; i < n; ++i)
+				{
+					switch (pattern)
+					{
+					case 0: r1[i].key = uint32_t(gen() % 1000); break;
+					case 1: r1[i].key = uint32_t(i % 7000); break;
+					case 2: r1[i].key = uint32_t((n - i) / 3); break;
+					default: r1[i].key = uint32_t(i % 1000 < 900 ? i % 1000 : gen() % 1000); break;
+					}
+					r1[i].payload = i;
+				}
+				std::vector<record> r2 = r1;
+				std::stable_sort(r2.begin(), r2.end(), by_key);
+				for (ptrdiff_t buffer_size : { ptrdiff_t(0), ptrdiff_t(100), ptrdiff_t(n / 2) })
+				{
+					std::vector<record> r3 = r1;
+					std::vector<record> buffer(buffer_size);
+					TinySTL::adaptive_stable_sort(r3.data(), r3.data() + n,
+												  buffer.data(), buffer_size, by_key);
+					for (int i = 0; i < n; ++i)
+						Assert::AreEqual(r2[i].payload, r3[i].payload);
+				}
+			}
+		}
+
+		/* SIMD find/count/mismatch/equal/adjacent_find, every level the machine has */
+		TEST_METHOD(TestMethod10)
+		{
+			const TinySTL::simd_level saved = TinySTL::simd_active_level();
+			for (int level = TinySTL::SIMD_SSE2; level <= TinySTL::simd_supported_level(); ++level)
+			{
+				TinySTL::simd_set_level(TinySTL::simd_level(level));
+				check_searches<uint8_t>();
+				check_searches<int16_t>();
+				check_searches<uint32_t>();
+				check_searches<int64_t>();
+				check_searches<float>();
+				check_searches<double>();
+
+				/* value of another type, converted as by == */
+				std::vector<uint8_t> bytes(100, 44);
+				Assert::IsTrue(TinySTL::find(bytes.data(), bytes.data() + 100, 300) == bytes.data() + 100);
+				std::vector<uint32_t> words(100, 0xFFFFFFFFu);
+				Assert::AreEqual(ptrdiff_t(100), TinySTL::count(words.data(), words.data() + 100, -1));
+
+				/* ordered equality : NaN never equal, -0.0 == 0.0 */
+				std::vector<double> d(100, 1.0);
+				d[50] = -0.0;
+				d[70] = d[71] = std::nan("");
+				Assert::IsTrue(TinySTL::find(d.data(), d.data() + 100, 0.0) == d.data() + 50);
+				Assert::IsTrue(TinySTL::find(d.data(), d.data() + 100, std::nan("")) == d.data() + 100);
+				Assert::IsTrue(TinySTL::adjacent_find(d.data() + 69, d.data() + 100) == d.data() + 72);
+				std::vector<double> e = d;
+				Assert::IsTrue(TinySTL::mismatch(d.data(), d.data() + 100, e.data()).first == d.data() + 70);
+			}
+			TinySTL::simd_set_level(saved);
+		}
+
+		/* copy/move/fill memmove and memset paths : overlaps, zero and non-zero fills */
+		TEST_METHOD(TestMethod11)
+		{
+			int a[100], b[100];
+			for (int i = 0; i < 100; ++i)
+				a[i] = b[i] = i;
+			Assert::IsTrue(TinySTL::copy(a + 10, a + 60, a) == a + 50);
+			std::copy(b + 10, b + 60, b);
+			Assert::IsTrue(std::equal(a, a + 100, b));
+			Assert::IsTrue(TinySTL::copy_backward(a, a + 50, a + 70) == a + 20);
+			std::copy_backward(b, b + 50, b + 70);
+			Assert::IsTrue(std::equal(a, a + 100, b));
+			Assert::IsTrue(TinySTL::move(a + 5, a + 5, a) == a);
+			Assert::IsTrue(TinySTL::copy_n(static_cast<const int*>(b), 0, a) == a);
+			Assert::IsTrue(TinySTL::copy_n(static_cast<const int*>(b + 30), 40, a) == a + 40);
+			Assert::IsTrue(std::equal(a, a + 40, b + 30));
+
+			record r[50], s[50];
+			for (int i = 0; i < 50; ++i)
+				r[i] = record{ uint32_t(i), -i };
+			Assert::IsTrue(TinySTL::move_backward(r, r + 50, s + 50) == s);
+			for (int i = 0; i < 50; ++i)
+				Assert::AreEqual(-i, s[i].payload);
+
+			char c[64];
+			Assert::IsTrue(TinySTL::fill_n(c, 64, 'x') == c + 64);
+			Assert::IsTrue(std::count(c, c + 64, 'x') == 64);
+			double d[64];
+			TinySTL::fill(d, d + 64, 0.0);
+			Assert::IsTrue(std::count(d, d + 64, 0.0) == 64);
+			TinySTL::fill(d, d + 64, -0.0);
+			Assert::IsTrue(std::signbit(d[63]));
+			TinySTL::fill(d, d + 64, 1.5);
+			Assert::IsTrue(std::count(d, d + 64, 1.5) == 64);
+			int* p[16];
+			TinySTL::fill_n(p, 16, nullptr);
+			Assert::IsTrue(std::count(p, p + 16, nullptr) == 16);
+			Assert::IsTrue(TinySTL::fill_n(p, -3, nullptr) == p);
+
+			TinySTL::vector<uint16_t> v(1000, uint16_t(7));
+			for (int i = 0; i < 10000; ++i)
+				v.push_back(uint16_t(i));
+			v.insert(v.begin() + 10, 500, uint16_t(0));
+			Assert::AreEqual(size_t(11500), v.size());
+			Assert::AreEqual(uint16_t(7), v[9]);
+			Assert::AreEqual(uint16_t(0), v[509]);
+			Assert::AreEqual(uint16_t(7), v[510]);
+			Assert::AreEqual(uint16_t(9999), v[11499]);
+		}
+
+		/* SIMD min/max/minmax_element on every level, NaN falls back to the scalar loop */
+		TEST_METHOD(TestMethod12)
+		{
+			const TinySTL::simd_level saved = TinySTL::simd_active_level();
+			for (int level = TinySTL::SIMD_SSE2; level <= TinySTL::simd_supported_level(); ++level)
+			{
+				TinySTL::simd_set_level(TinySTL::simd_level(level));
+				check_minmax<int8_t>();
+				check_minmax<uint8_t>();
+				check_minmax<int16_t>();
+				check_minmax<uint16_t>();
+				check_minmax<int32_t>();
+				check_minmax<uint32_t>();
+				check_minmax<int64_t>();
+				check_minmax<uint64_t>();
+				check_minmax<float>();
+				check_minmax<double>();
+
+				std::vector<float> f(300);
+				for (int i = 0; i < 300; ++i)
+					f[i] = float(i % 50);
+				f[10] = -0.0f;
+				Assert::IsTrue(TinySTL::min_element(f.data(), f.data() + 300) == f.data());
+				Assert::IsTrue(TinySTL::max_element(f.data(), f.data() + 300) == f.data() + 49);
+				Assert::IsTrue(TinySTL::minmax_element(f.data(), f.data() + 300).second == f.data() + 299);
+				f[100] = std::nanf("");
+				Assert::IsTrue(std::min_element(f.data(), f.data() + 300) ==
+							   TinySTL::min_element(f.data(), f.data() + 300));
+				Assert::IsTrue(std::max_element(f.data(), f.data() + 300) ==
+							   TinySTL::max_element(f.data(), f.data() + 300));
+			}
+			TinySTL::simd_set_level(saved);
+
+			TinySTL::deque<int> d;
+			for (int i = 0; i < 100; ++i)
+				d.push_back(i % 7);
+			auto mm = TinySTL::minmax_element(d.begin(), d.end());
+			Assert::IsTrue(mm.first == d.begin() && mm.second == d.begin() + 97);
+			auto empty = TinySTL::minmax_element(d.end(), d.end());
+			Assert::IsTrue(empty.first == d.end() && empty.second == d.end());
+		}
+
+		/* lower_bound/upper_bound/equal_range : branchless on pointers and deque, forward on list-like input */
+		TEST_METHOD(TestMethod13)
+		{
+			std::mt19937 gen(13);
+			for (int len = 0; len < 70; ++len)
+			{
+				std::vector<int> v(len);
+				for (auto& x : v)
+					x = int(gen() % 20);
+				std::sort(v.begin(), v.end());
+				TinySTL::deque<int> d(v.data(), v.data() + len);
+				for (int key = -1; key <= 21; ++key)
+				{
+					const int* first = v.data();
+					const int* last  = v.data() + len;
+					Assert::IsTrue(std::lower_bound(first, last, key) == TinySTL::lower_bound(first, last, key));
+					Assert::IsTrue(std::upper_bound(first, last, key) == TinySTL::upper_bound(first, last, key));
+					Assert::AreEqual(std::binary_search(first, last, key), TinySTL::binary_search(first, last, key));
+					auto r = TinySTL::equal_range(d.begin(), d.end(), key);
+					Assert::AreEqual(ptrdiff_t(std::lower_bound(first, last, key) - first), ptrdiff_t(r.first - d.begin()));
+					Assert::AreEqual(ptrdiff_t(std::upper_bound(first, last, key) - first), ptrdiff_t(r.second - d.begin()));
+				}
+			}
+
+			/* descending order, heterogeneous comparison */
+			record r[100];
+			for (int i = 0; i < 100; ++i)
+				r[i] = record{ uint32_t(100 - i / 2), i };
+			auto below = [](const record& x, uint32_t k) { return x.key > k; };
+			auto above = [](uint32_t k, const record& x) { return k > x.key; };
+			Assert::AreEqual(20, TinySTL::lower_bound(r, r + 100, 90u, below)->payload);
+			Assert::AreEqual(22, TinySTL::upper_bound(r, r + 100, 90u, above)->payload);
+			Assert::IsTrue(TinySTL::lower_bound(r, r + 100, 0u, below) == r + 100);
+		}
+
+		/* set_union/set_intersection : skewed sizes both ways (galloping), duplicates, which range equal elements come from */
+		TEST_METHOD(TestMethod14)
+		{
+			std::mt19937 gen(14);
+			auto by_key = [](const record& x, const record& y) { return x.key < y.key; };
+			const int sizes[][2] = { { 0, 5 }, { 5, 0 }, { 3, 1000 }, { 1000, 3 }, { 40, 2000 }, { 2000, 40 }, { 300, 400 } };
+			for (auto& size : sizes)
+			{
+				std::vector<record> a(size[0]), b(size[1]);
+				for (auto& x : a)
+					x = record{ uint32_t(gen() % 500), 1 };
+				for (auto& x : b)
+					x = record{ uint32_t(gen() % 500), 2 };
+				std::sort(a.begin(), a.end(), by_key);
+				std::sort(b.begin(), b.end(), by_key);
+				std::vector<record> expected(a.size() + b.size()), got(a.size() + b.size());
+
+				auto e = std::set_union(a.begin(), a.end(), b.begin(), b.end(), expected.begin(), by_key);
+				record* g = TinySTL::set_union(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(),
+											   got.data(), by_key);
+				Assert::AreEqual(ptrdiff_t(e - expected.begin()), ptrdiff_t(g - got.data()));
+				for (ptrdiff_t i = 0; i < g - got.data(); ++i)
+					Assert::IsTrue(expected[i].key == got[i].key && expected[i].payload == got[i].payload);
+
+				e = std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), expected.begin(), by_key);
+				g = TinySTL::set_intersection(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(),
+											  got.data(), by_key);
+				Assert::AreEqual(ptrdiff_t(e - expected.begin()), ptrdiff_t(g - got.data()));
+				for (ptrdiff_t i = 0; i < g - got.data(); ++i)
+					Assert::IsTrue(expected[i].key == got[i].key && expected[i].payload == got[i].payload);
+			}
+
+			/* uint32_t posting lists : SIMD blocks, strictly increasing or with a few duplicates */
+			const TinySTL::simd_level saved = TinySTL::simd_active_level();
+			for (int level = TinySTL::SIMD_SSE2; level <= TinySTL::simd_supported_level(); ++level)
+			{
+				TinySTL::simd_set_level(TinySTL::simd_level(level));
+				for (int round = 0; round < 40; ++round)
+				{
+					std::vector<uint32_t> a(100 + gen() % 900), b(100 + gen() % 900);
+					const uint32_t range = round % 2 ? 3000 : 100000;
+					for (auto& x : a)
+						x = gen() % range;
+					for (auto& x : b)
+						x = gen() % range;
+					std::sort(a.begin(), a.end());
+					std::sort(b.begin(), b.end());
+					if (round % 4 < 2)
+					{
+						a.erase(std::unique(a.begin(), a.end()), a.end());
+						b.erase(std::unique(b.begin(), b.end()), b.end());
+					}
+					std::vector<uint32_t> expected(a.size()), got(a.size());
+					expected.resize(std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+														  expected.begin()) - expected.begin());
+					const uint32_t* ca = a.data();
+					const uint32_t* cb = b.data();
+					got.resize(TinySTL::set_intersection(ca, ca + a.size(), cb, cb + b.size(),
+														 got.data()) - got.data());
+					Assert::IsTrue(expected == got);
+				}
+			}
+			TinySTL::simd_set_level(saved);
+		}
+
+		/* nth_element : element and partition against a sort, patterns that defeat quickselect, a linear number of comparisons */
+		TEST_METHOD(TestMethod15)
+		{
+			std::mt19937 gen(15);
+			for (int n : { 1, 2, 5, 24, 25, 100, 129, 601, 5000, 100000 })
+			{
+				const int half = n / 2;
+				std::vector<std::vector<int> > inputs(7, std::vector<int>(n));
+				for (int i = 0; i < n; ++i)
+				{
+					inputs[0][i] = int(gen() % 1000000);
+					inputs[1][i] = i;
+					inputs[2][i] = n - i;
+					inputs[3][i] = i < half ? i : n - i;
+					inputs[4][i] = 7;
+					inputs[5][i] = int(gen() % 3);
+				}
+				/* median of 3 killer (D. Musser, 1997) */
+				for (int i = 1; i <= half; ++i)
+				{
+					if (i % 2)
+					{
+						inputs[6][i - 1] = i;
+						inputs[6][i] = half + i;
+					}
+					inputs[6][half + i - 1] = 2 * i;
+				}
+				for (auto& input : inputs)
+				{
+					std::vector<int> sorted(input);
+					std::sort(sorted.begin(), sorted.end());
+					for (int k : { 0, 1, n / 4, half, n - 2, n - 1 })
+					{
+						if (k < 0 || k >= n)
+							continue;
+						std::vector<int> v(input);
+						size_t comparisons = 0;
+						auto counted = [&comparisons](int x, int y) { ++comparisons; return x < y; };
+						TinySTL::nth_element(v.data(), v.data() + k, v.data() + n, counted);
+						Assert::AreEqual(sorted[k], v[k]);
+						Assert::IsTrue(std::all_of(v.begin(), v.begin() + k, [&](int x) { return x <= v[k]; }));
+						Assert::IsTrue(std::all_of(v.begin() + k, v.end(), [&](int x) { return x >= v[k]; }));
+						Assert::IsTrue(comparisons <= 20 * size_t(n) + 100);
+					}
+				}
+			}
+
+			/* descending order, records, nth == last */
+			record r[1000];
+			for (int i = 0; i < 1000; ++i)
+				r[i] = record{ uint32_t(gen() % 50), i };
+			auto by_key_desc = [](const record& x, const record& y) { return x.key > y.key; };
+			std::vector<uint32_t> keys;
+			for (auto& x : r)
+				keys.push_back(x.key);
+			std::sort(keys.rbegin(), keys.rend());
+			TinySTL::nth_element(r, r + 300, r + 1000, by_key_desc);
+			Assert::AreEqual(keys[300], r[300].key);
+			int v[] = { 3, 1, 2 };
+			TinySTL::nth_element(v, v + 3, v + 3);
+			Assert::AreEqual(3, v[0]);
+			TinySTL::nth_element(v, v + 1, v + 3);
+			Assert::AreEqual(2, v[1]);
+		}
+
+		/* partial_sort both ways (heap, select), partial_sort_copy from a single pass input */
+		TEST_METHOD(TestMethod16)
+		{
+			std::mt19937 gen(16);
+			std::vector<int> v(3000);
+			for (auto& x : v)
+				x = int(gen() % 1000);
+			std::vector<int> sorted(v);
+			std::sort(sorted.begin(), sorted.end());
+			for (int k : { 0, 1, 7, 100, 187, 188, 1500, 3000 })
+			{
+				std::vector<int> w(v);
+				TinySTL::partial_sort(w.data(), w.data() + k, w.data() + w.size());
+				Assert::IsTrue(std::equal(sorted.begin(), sorted.begin() + k, w.begin()));
+				std::sort(w.begin(), w.end());
+				Assert::IsTrue(w == sorted);
+
+				std::vector<int> out(k + 1, -1);
+				std::istringstream in;
+				std::string text;
+				for (int x : v)
+					text += std::to_string(x) + " ";
+				in.str(text);
+				int* end = TinySTL::partial_sort_copy(std::istream_iterator<int>(in), std::istream_iterator<int>(),
+													  out.data(), out.data() + k);
+				Assert::IsTrue(end == out.data() + k);
+				Assert::IsTrue(std::equal(sorted.begin(), sorted.begin() + k, out.begin()));
+				Assert::AreEqual(-1, out[k]);
+			}
+
+			std::vector<int> large(100000);
+			for (auto& x : large)
+				x = int(gen() % 100000);
+			std::vector<int> large_sorted(large);
+			std::sort(large_sorted.begin(), large_sorted.end());
+			TinySTL::partial_sort(large.data(), large.data() + 20, large.data() + large.size());
+			Assert::IsTrue(std::equal(large_sorted.begin(), large_sorted.begin() + 20, large.begin()));
+
+			auto greater = [](int x, int y) { return x > y; };
+			int a[] = { 5, 2, 8, 1 }, out[6];
+			int* end = TinySTL::partial_sort_copy(a, a + 4, out, out + 6, greater);
+			Assert::IsTrue(end == out + 4);
+			Assert::IsTrue(std::equal(out, out + 4, std::vector<int>({ 8, 5, 2, 1 }).begin()));
+		}
+
+		/* shuffle, random_shuffle : permutations, all of them equally likely ; sample on forward and input iterators */
+		TEST_METHOD(TestMethod17)
+		{
+			TinySTL::xoshiro256ss gen(17);
+			std::vector<int> v(1000);
+			for (int i = 0; i < 1000; ++i)
+				v[i] = i;
+			std::vector<int> w(v);
+			TinySTL::shuffle(w.data(), w.data() + w.size(), gen);
+			Assert::IsTrue(w != v);
+			TinySTL::random_shuffle(w.data(), w.data() + w.size());
+			std::sort(w.begin(), w.end());
+			Assert::IsTrue(w == v);
+
+			int perms[6] = {};
+			for (int i = 0; i < 60000; ++i)
+			{
+				int a[3] = { 0, 1, 2 };
+				TinySTL::shuffle(a, a + 3, gen);
+				++perms[a[0] * 2 + (a[1] > a[2])];
+			}
+			for (int c : perms)
+				Assert::IsTrue(c > 9500 && c < 10500);
+
+			/* forward iterators : in order, every element as likely */
+			TinySTL::deque<int> d;
+			for (int i = 0; i < 20; ++i)
+				d.push_back(i);
+			int picked[20] = {};
+			for (int i = 0; i < 20000; ++i)
+			{
+				int out[5];
+				int* end = TinySTL::sample(d.begin(), d.end(), out, 5, gen);
+				Assert::IsTrue(end == out + 5);
+				Assert::IsTrue(std::is_sorted(out, out + 5) && std::adjacent_find(out, out + 5) == out + 5);
+				for (int x : out)
+					++picked[x];
+			}
+			for (int c : picked)
+				Assert::IsTrue(c > 4700 && c < 5300);
+			int all[30];
+			Assert::IsTrue(TinySTL::sample(d.begin(), d.end(), all, 30, gen) == all + 20);
+			Assert::IsTrue(std::equal(d.begin(), d.end(), all));
+
+			/* input iterators : a single pass, every element as likely */
+			struct counter
+			{
+				using iterator_category = TinySTL::input_iterator_tag;
+				using value_type        = int;
+				using difference_type   = ptrdiff_t;
+				using pointer           = const int*;
+				using reference         = const int&;
+
+				int i;
+				const int& operator*() const { return i; }
+				counter& operator++() { ++i; return *this; }
+				bool operator==(const counter& x) const { return i == x.i; }
+				bool operator!=(const counter& x) const { return i != x.i; }
+			};
+			int seen[1000] = {};
+			for (int i = 0; i < 2000; ++i)
+			{
+				int out[10];
+				int* end = TinySTL::sample(counter{ 0 }, counter{ 1000 }, out, 10, gen);
+				Assert::IsTrue(end == out + 10);
+				std::sort(out, out + 10);
+				Assert::IsTrue(std::adjacent_find(out, out + 10) == out + 10);
+				for (int x : out)
+					++seen[x];
+			}
+			int first_half = 0;
+			for (int x = 0; x < 500; ++x)
+				first_half += seen[x];
+			Assert::IsTrue(first_half > 9400 && first_half < 10600);
+			for (int c : seen)
+				Assert::IsTrue(c < 60);
+			Assert::IsTrue(TinySTL::sample(counter{ 0 }, counter{ 3 }, all, 10, gen) == all + 3);
+			Assert::IsTrue(all[0] == 0 && all[1] == 1 && all[2] == 2);
+			Assert::IsTrue(TinySTL::sample(counter{ 0 }, counter{ 3 }, all, 0, gen) == all);
+		}
+
+		/* for_each : the function gets the elements, by reference, in order, and comes back */
+		TEST_METHOD(TestMethod18)
+		{
+			struct summer
+			{
+				long long sum;
+				int calls;
+				void operator()(int x) { sum = sum * 10 + x; ++calls; }
+			};
+			int a[5] = { 1, 2, 3, 4, 5 };
+			summer s = TinySTL::for_each(a, a + 5, summer{ 0, 0 });
+			Assert::AreEqual(12345LL, s.sum);
+			Assert::AreEqual(5, s.calls);
+			s = TinySTL::for_each(a, a, summer{ 0, 0 });
+			Assert::AreEqual(0, s.calls);
+
+			TinySTL::vector<int> v(a, a + 5);
+			TinySTL::for_each(v.begin(), v.end(), [](int& x) { x *= 2; });
+			for (int i = 0; i < 5; ++i)
+				Assert::AreEqual(2 * (i + 1), v[i]);
+
+			TinySTL::deque<int> d;
+			for (int i = 0; i < 1000; ++i)
+				d.push_back(i);
+			const int* prev = nullptr;
+			int next = 0;
+			TinySTL::for_each(d.begin(), d.end(), [&](const int& x)
+			{
+				Assert::AreEqual(next++, x);
+				Assert::IsTrue(&x != prev);
+				prev = &x;
+			});
+			Assert::AreEqual(1000, next);
+		}
+
+		/* replace_if, replace_copy_if : the predicate before the new value, as in std */
+		TEST_METHOD(TestMethod19)
+		{
+			auto odd = [](int x) { return x % 2 != 0; };
+			int a[6] = { 1, 2, 3, 4, 5, 6 }, out[6];
+			TinySTL::replace_copy_if(a, a + 6, out, odd, 0);
+			TinySTL::replace_if(a, a + 6, odd, 0);
+			for (int i = 0; i < 6; ++i)
+			{
+				Assert::AreEqual(i % 2 ? i + 1 : 0, a[i]);
+				Assert::AreEqual(a[i], out[i]);
+			}
+
+			TinySTL::deque<int> d;
+			for (int i = 0; i < 1000; ++i)
+				d.push_back(i);
+			TinySTL::replace_if(d.begin(), d.end(), [](int x) { return x >= 500; }, -1);
+			for (int i = 0; i < 1000; ++i)
+				Assert::AreEqual(i < 500 ? i : -1, d[i]);
+		}
+	};
+}
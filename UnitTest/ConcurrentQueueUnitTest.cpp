@@ -0,0 +1,402 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/concurrent_queue.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ConcurrentQueueUnitTest
+{
+	/* move assignment throws for negative values */
+	struct fragile
+	{
+		int val;
+		std::shared_ptr<int> owned; // leaks show up if a popped element isn't destroyed
+
+		fragile(int v = 0) noexcept :val(v), owned(std::make_shared<int>(v)) {}
+		fragile(const fragile&) = default;
+		fragile(fragile&&) noexcept = default;
+		fragile& operator=(const fragile&) = default;
+		fragile& operator=(fragile&& x)
+		{
+			if (x.val < 0)
+				throw x.val;
+			val   = x.val;
+			owned = std::move(x.owned);
+			return *this;
+		}
+	};
+
+	/* 16 bytes past a cache line boundary, whatever alignment is asked for */
+	class skewed_resource :public TinySTL::memory_resource
+	{
+	protected:
+		void* do_allocate(size_t bytes, size_t) override
+		{
+			char* base = static_cast<char*>(::operator new(bytes + 128));
+			char* p = base + (64 - reinterpret_cast<uintptr_t>(base) % 64) % 64 + 16;
+			reinterpret_cast<char**>(p)[-1] = base;
+			return p;
+		}
+		void do_deallocate(void* ptr, size_t, size_t) override
+			{ ::operator delete(static_cast<char**>(ptr)[-1]); }
+		bool do_is_equal(const TinySTL::memory_resource& other) const noexcept override
+			{ return this == &other; }
+	};
+
+	/* no default constructor */
+	struct tagged_value
+	{
+		int val;
+		explicit tagged_value(int v) :val(v) {}
+	};
+
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* try_push / try_pop, FIFO on one thread */
+		TEST_METHOD(TestMethod1)
+		{
+			TinySTL::concurrent_bounded_queue<int> q(16);
+			for (int i = 0; i < 16; ++i)
+				Assert::IsTrue(q.try_push(i));
+			Assert::IsFalse(q.try_push(16));
+			Assert::AreEqual(size_t(16), q.size_approx());
+			int val;
+			for (int i = 0; i < 16; ++i)
+			{
+				Assert::IsTrue(q.try_pop(val));
+				Assert::AreEqual(i, val);
+			}
+			Assert::IsFalse(q.try_pop(val));
+		}
+
+		/* capacity rounded up to a power of 2 */
+		TEST_METHOD(TestMethod2)
+		{
+			TinySTL::concurrent_bounded_queue<int> q(100);
+			Assert::AreEqual(size_t(128), q.capacity());
+		}
+
+		/* non-trivial elements, leftovers destroyed by the destructor */
+		TEST_METHOD(TestMethod3)
+		{
+			TinySTL::concurrent_bounded_queue<std::string> q(4);
+			q.push("a");
+			q.push(std::string(100, 'b'));
+			q.emplace(3, 'c');
+			std::string val;
+			q.pop(val);
+			Assert::IsTrue(val == "a");
+			q.pop(val);
+			Assert::IsTrue(val == std::string(100, 'b'));
+		}
+
+		/* try_push_range / try_pop_n */
+		TEST_METHOD(TestMethod4)
+		{
+			TinySTL::concurrent_bounded_queue<int> q(8);
+			int a[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+			int* rest = q.try_push_range(a, a + 10);
+			Assert::IsTrue(rest == a + 8);
+			int b[10] = { 0 };
+			auto now = q.try_pop_n(5, b);
+			Assert::AreEqual(size_t(5), now.first);
+			Assert::IsTrue(now.second == b + 5);
+			now = q.try_pop_n(5, now.second);
+			Assert::AreEqual(size_t(3), now.first);
+			for (int i = 0; i < 8; ++i)
+				Assert::AreEqual(a[i], b[i]);
+		}
+
+		/* blocking push/pop with several producers and consumers */
+		TEST_METHOD(TestMethod5)
+		{
+			const int producers = 4, consumers = 4, n = 100000;
+			TinySTL::concurrent_bounded_queue<long long> q(64);
+			std::atomic<long long> sum(0);
+			std::vector<std::thread> threads;
+			for (int p = 0; p < producers; ++p)
+				threads.emplace_back([&]
+				{
+					for (int i = 1; i <= n; ++i)
+						q.push(i);
+				});
+			for (int c = 0; c < consumers; ++c)
+				threads.emplace_back([&]
+				{
+					long long s = 0, val;
+					for (int i = 0; i < producers * n / consumers; ++i)
+					{
+						q.pop(val);
+						s += val;
+					}
+					sum += s;
+				});
+			for (auto& t : threads)
+				t.join();
+			Assert::AreEqual(producers * (long long)n * (n + 1) / 2, sum.load());
+			Assert::IsTrue(q.empty_approx());
+		}
+
+		/* blocking push_range/pop_n */
+		TEST_METHOD(TestMethod6)
+		{
+			const int n = 100000, batch = 10;
+			TinySTL::concurrent_bounded_queue<int> q(32);
+			std::thread producer([&]
+			{
+				int buf[batch];
+				for (int i = 0; i < n; i += batch)
+				{
+					for (int j = 0; j < batch; ++j)
+						buf[j] = i + j;
+					q.push_range(buf, buf + batch);
+				}
+			});
+			std::vector<int> result(n);
+			q.pop_n(n, result.data());
+			producer.join();
+			for (int i = 0; i < n; ++i)
+				Assert::AreEqual(i, result[i]);
+		}
+
+		/* concurrent_queue : FIFO on one thread, across several blocks */
+		TEST_METHOD(TestMethod7)
+		{
+			TinySTL::concurrent_queue<int> q;
+			int val;
+			Assert::IsFalse(q.try_pop(val));
+			for (int i = 0; i < 1000; ++i)
+				q.push(i);
+			for (int i = 0; i < 1000; ++i)
+			{
+				Assert::IsTrue(q.try_pop(val));
+				Assert::AreEqual(i, val);
+			}
+			Assert::IsFalse(q.try_pop(val));
+			Assert::IsTrue(q.empty_approx());
+		}
+
+		/* concurrent_queue : leftovers destroyed by the destructor */
+		TEST_METHOD(TestMethod8)
+		{
+			TinySTL::concurrent_queue<std::string> q;
+			for (int i = 0; i < 100; ++i)
+				q.emplace(size_t(i), 'a');
+			std::string val;
+			Assert::IsTrue(q.try_pop(val));
+			Assert::IsTrue(val.empty());
+			Assert::IsTrue(q.try_pop(val));
+			Assert::IsTrue(val == "a");
+		}
+
+		/* concurrent_queue : several producers and consumers */
+		TEST_METHOD(TestMethod9)
+		{
+			const int producers = 4, consumers = 4, n = 100000;
+			TinySTL::concurrent_queue<long long> q;
+			std::atomic<long long> sum(0);
+			std::vector<std::thread> threads;
+			for (int p = 0; p < producers; ++p)
+				threads.emplace_back([&]
+				{
+					long long buf[4];
+					for (int i = 1; i <= n; i += 4)
+					{
+						for (int j = 0; j < 4; ++j)
+							buf[j] = i + j;
+						q.push_range(buf, buf + 4);
+					}
+				});
+			for (int c = 0; c < consumers; ++c)
+				threads.emplace_back([&]
+				{
+					long long s = 0, val;
+					for (int i = 0; i < producers * n / consumers; ++i)
+					{
+						q.pop(val);
+						s += val;
+					}
+					sum += s;
+				});
+			for (auto& t : threads)
+				t.join();
+			Assert::AreEqual(producers * (long long)n * (n + 1) / 2, sum.load());
+			Assert::IsTrue(q.empty_approx());
+		}
+
+		/* a throwing move while popping loses the element, never the cell */
+		TEST_METHOD(TestMethod10)
+		{
+			TinySTL::concurrent_bounded_queue<fragile> q(2);
+			fragile val;
+			for (int round = 0; round < 3; ++round)
+			{
+				Assert::IsTrue(q.try_push(fragile(-1)));
+				Assert::IsTrue(q.try_push(fragile(round)));
+				Assert::IsFalse(q.try_push(fragile(9)));
+				bool thrown = false;
+				try
+				{
+					q.try_pop(val);
+				}
+				catch (int)
+				{
+					thrown = true;
+				}
+				Assert::IsTrue(thrown);
+				Assert::IsTrue(q.try_push(fragile(10 + round)));
+				Assert::IsTrue(q.try_pop(val));
+				Assert::AreEqual(round, val.val);
+				Assert::IsTrue(q.try_pop(val));
+				Assert::AreEqual(10 + round, val.val);
+			}
+
+			fragile out[4];
+			fragile in[4] = { fragile(1), fragile(-2), fragile(3), fragile(4) };
+			Assert::IsTrue(q.try_push_range(in, in + 2) == in + 2);
+			bool thrown = false;
+			try
+			{
+				q.try_pop_n(2, out);
+			}
+			catch (int)
+			{
+				thrown = true;
+			}
+			Assert::IsTrue(thrown);
+			Assert::AreEqual(1, out[0].val);
+			Assert::IsTrue(q.try_push_range(in + 2, in + 4) == in + 4);
+			Assert::IsTrue(q.try_pop_n(4, out).first == 2);
+			Assert::IsTrue(out[0].val == 3 && out[1].val == 4);
+
+			TinySTL::concurrent_queue<fragile> u;
+			u.push(fragile(-1));
+			u.push(fragile(5));
+			thrown = false;
+			try
+			{
+				u.try_pop(val);
+			}
+			catch (int)
+			{
+				thrown = true;
+			}
+			Assert::IsTrue(thrown);
+			Assert::IsTrue(u.try_pop(val));
+			Assert::AreEqual(5, val.val);
+		}
+
+		/* concurrent_queue : smallest blocks (32 cells), consumers racing the producers over the block ends */
+		TEST_METHOD(TestMethod11)
+		{
+			struct wide
+			{
+				long long val;
+				long long check;
+				char      pad[48];
+			};
+			const int producers = 3, consumers = 3, n = 60000;
+			TinySTL::concurrent_queue<wide> q;
+			std::atomic<long long> sum(0);
+			std::atomic<int> popped(0);
+			std::vector<std::thread> threads;
+			for (int p = 0; p < producers; ++p)
+				threads.emplace_back([&]
+				{
+					for (long long i = 1; i <= n; ++i)
+						q.push(wide{ i, ~i, {} });
+				});
+			for (int c = 0; c < consumers; ++c)
+				threads.emplace_back([&]
+				{
+					long long s = 0;
+					wide w;
+					while (popped.load() < producers * n)
+					{
+						if (!q.try_pop(w))
+							continue;
+						Assert::IsTrue(w.check == ~w.val);
+						s += w.val;
+						++popped;
+					}
+					sum += s;
+				});
+			for (auto& t : threads)
+				t.join();
+			Assert::AreEqual(producers * n, popped.load());
+			Assert::AreEqual(producers * (long long)n * (n + 1) / 2, sum.load());
+			Assert::IsTrue(q.empty_approx());
+		}
+
+		/* nodes left by exiting threads are freed in retire order, the older list coming in last included */
+		TEST_METHOD(TestMethod12)
+		{
+			struct tracked :TinySTL::_epoch_node
+			{
+				bool reclaimed = false;
+			};
+			auto mark = [](TinySTL::_epoch_node* node) { static_cast<tracked*>(node)->reclaimed = true; };
+			tracked older, newer;
+			std::atomic<int> step(0);
+
+			TinySTL::epoch_pin(); // the epoch can move one step past ours, no further
+			std::thread early([&]
+			{
+				TinySTL::epoch_retire(&older, mark); // advances the epoch behind it
+				step = 1;
+				while (step.load() != 2)
+					std::this_thread::yield();
+			});
+			while (step.load() != 1)
+				std::this_thread::yield();
+			std::thread late([&] { TinySTL::epoch_retire(&newer, mark); });
+			late.join();  // newer orphaned first
+			step = 2;
+			early.join(); // then older, one epoch before it
+			TinySTL::epoch_unpin();
+
+			TinySTL::epoch_collect();
+			Assert::IsTrue(older.reclaimed);
+			Assert::IsFalse(newer.reclaimed);
+			TinySTL::epoch_collect();
+			Assert::IsTrue(newer.reclaimed);
+		}
+
+		/* concurrent_queue : blocks aligned on an allocator that doesn't, try_pop_n without default construction */
+		TEST_METHOD(TestMethod13)
+		{
+			skewed_resource res;
+			{
+				TinySTL::concurrent_queue<int> q(&res);
+				for (int i = 0; i < 10000; ++i)
+					q.push(i);
+				int val;
+				for (int i = 0; i < 10000; ++i)
+				{
+					Assert::IsTrue(q.try_pop(val));
+					Assert::AreEqual(i, val);
+				}
+			}
+
+			TinySTL::concurrent_queue<tagged_value> q;
+			for (int i = 0; i < 1000; ++i)
+				q.emplace(i);
+			std::vector<tagged_value> out;
+			auto got = q.try_pop_n(600, std::back_inserter(out));
+			Assert::AreEqual(size_t(600), got.first);
+			got = q.try_pop_n(600, std::back_inserter(out));
+			Assert::AreEqual(size_t(400), got.first);
+			for (int i = 0; i < 1000; ++i)
+				Assert::AreEqual(i, out[i].val);
+		}
+	};
+}
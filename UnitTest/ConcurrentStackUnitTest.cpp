@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/concurrent_stack.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ConcurrentStackUnitTest
+{
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* LIFO on one thread */
+		TEST_METHOD(TestMethod1)
+		{
+			TinySTL::concurrent_stack<int> s;
+			int val;
+			Assert::IsFalse(s.try_pop(val));
+			for (int i = 0; i < 100; ++i)
+				s.push(i);
+			for (int i = 99; i >= 0; --i)
+			{
+				Assert::IsTrue(s.try_pop(val));
+				Assert::AreEqual(i, val);
+			}
+			Assert::IsFalse(s.try_pop(val));
+			Assert::IsTrue(s.empty_approx());
+		}
+
+		/* push_range keeps the order of pushing one by one, leftovers destroyed */
+		TEST_METHOD(TestMethod2)
+		{
+			TinySTL::concurrent_stack<std::string> s;
+			std::string a[3] = { "x", std::string(100, 'y'), "z" };
+			s.push_range(a, a + 3);
+			s.emplace(2, 'w');
+			std::string val;
+			Assert::IsTrue(s.try_pop(val));
+			Assert::IsTrue(val == "ww");
+			Assert::IsTrue(s.try_pop(val));
+			Assert::IsTrue(val == "z");
+		}
+
+		/* every thread pushes and pops, nothing lost nor duplicated */
+		TEST_METHOD(TestMethod3)
+		{
+			const int threads_count = 8, n = 100000;
+			TinySTL::concurrent_stack<long long> s;
+			std::atomic<long long> sum(0);
+			std::vector<std::thread> threads;
+			for (int t = 0; t < threads_count; ++t)
+				threads.emplace_back([&]
+				{
+					long long acc = 0, val;
+					for (int i = 1; i <= n; ++i)
+					{
+						s.push(i);
+						if (i % 2 == 0 && s.try_pop(val))
+							acc += val;
+					}
+					while (s.try_pop(val))
+						acc += val;
+					sum += acc;
+				});
+			for (auto& t : threads)
+				t.join();
+			Assert::AreEqual(threads_count * (long long)n * (n + 1) / 2, sum.load());
+		}
+
+		/* a pop whose move throws leaves the element on the stack ; nodes past a slab */
+		TEST_METHOD(TestMethod4)
+		{
+			struct fragile
+			{
+				int val;
+				fragile(int v = 0) :val(v) {}
+				fragile(const fragile&) = default;
+				fragile& operator=(const fragile& x)
+				{
+					if (x.val < 0)
+						throw x.val;
+					val = x.val;
+					return *this;
+				}
+			};
+			TinySTL::concurrent_stack<fragile> s;
+			for (int i = 0; i < 1000; ++i)
+				s.push(fragile(i));
+			s.push(fragile(-1));
+			fragile val;
+			bool thrown = false;
+			try
+			{
+				s.try_pop(val);
+			}
+			catch (int)
+			{
+				thrown = true;
+			}
+			Assert::IsTrue(thrown);
+			Assert::AreEqual(0, val.val);
+			thrown = false;
+			try
+			{
+				s.try_pop(val);
+			}
+			catch (int)
+			{
+				thrown = true;
+			}
+			Assert::IsTrue(thrown); // still there, on top
+			Assert::IsFalse(s.empty_approx());
+		}
+	};
+}
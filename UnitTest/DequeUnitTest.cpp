@@ -289,5 +289,32 @@ namespace dequeUnitTest
 			Assert::IsTrue(is_equal(v1, v2_copy));
 			Assert::IsTrue(is_equal(v2, v1_copy));
 		}
+
+		/* push/pop across buffer boundaries, reserve */
+		TEST_METHOD(TestMethod17)
+		{
+			std::deque<int>     v1;
+			TinySTL::deque<int> v2;
+			v2.reserve(10000);
+			for (int round = 0; round < 3; ++round)
+			{
+				for (int i = 0; i < 3000; ++i)
+				{
+					v1.push_back(i);
+					v2.push_back(i);
+				}
+				for (int i = 0; i < 2000; ++i)
+				{
+					v1.pop_front();
+					v2.pop_front();
+				}
+				for (int i = 0; i < 500; ++i)
+				{
+					v1.pop_back();
+					v2.pop_back();
+				}
+				Assert::IsTrue(is_equal(v1, v2));
+			}
+		}
 	};
 }
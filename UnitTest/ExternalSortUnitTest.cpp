@@ -0,0 +1,131 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/external_sort.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <system_error>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ExternalSortUnitTest
+{
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* iterators, budgets from everything in memory to a few records : runs, cascades, several passes */
+		TEST_METHOD(TestMethod1)
+		{
+			std::mt19937 gen(1);
+			std::vector<int> v(100000);
+			for (auto& x : v)
+				x = int(gen() % 50000) - 25000;
+			std::vector<int> expected(v);
+			std::sort(expected.begin(), expected.end());
+			for (size_t memory : { size_t(1) << 22, size_t(1) << 18, size_t(4096), size_t(100), size_t(0) })
+			{
+				std::vector<int> out(v.size() + 1, 7);
+				int* end = TinySTL::external_sort(v.data(), v.data() + v.size(), out.data(), memory);
+				Assert::IsTrue(end == out.data() + v.size());
+				Assert::IsTrue(std::equal(expected.begin(), expected.end(), out.begin()));
+				Assert::AreEqual(7, out.back());
+			}
+
+			std::vector<int> empty, out;
+			Assert::IsTrue(TinySTL::external_sort(empty.data(), empty.data(), out.data(), 4096) == out.data());
+			auto greater = [](int x, int y) { return x > y; };
+			out.assign(v.size(), 0);
+			TinySTL::external_sort(v.data(), v.data() + v.size(), out.data(), 1 << 16, greater);
+			Assert::IsTrue(std::equal(expected.rbegin(), expected.rend(), out.begin()));
+		}
+
+		/* external_radix_sort is stable : short inputs and short last runs too ; no default constructor needed */
+		TEST_METHOD(TestMethod2)
+		{
+			struct record
+			{
+				uint32_t key, pos;
+				record(uint32_t k, uint32_t p) :key(k), pos(p) {}
+			};
+			std::mt19937 gen(2);
+			for (uint32_t n : { 30u, 200u, 51300u }) // 8192 bytes : runs of 512, the last of 100
+			{
+				std::vector<record> v;
+				for (uint32_t i = 0; i != n; ++i)
+					v.push_back(record(gen() % (n < 1000 ? 8 : 1000), i));
+				std::vector<record> expected(v);
+				std::stable_sort(expected.begin(), expected.end(),
+					[](const record& x, const record& y) { return x.key < y.key; });
+				for (size_t memory : { size_t(1) << 20, size_t(8192), size_t(256) })
+				{
+					std::vector<record> out(v.size(), record(0, 0));
+					TinySTL::external_radix_sort(v.data(), v.data() + v.size(), out.data(), memory,
+						[](const record& r) { return r.key; });
+					for (size_t i = 0; i != v.size(); ++i)
+					{
+						Assert::AreEqual(expected[i].key, out[i].key);
+						Assert::AreEqual(expected[i].pos, out[i].pos);
+					}
+				}
+			}
+		}
+
+		/* files of raw records, a truncated one */
+		TEST_METHOD(TestMethod3)
+		{
+			const char* input = "external_sort_input.bin";
+			const char* output = "external_sort_output.bin";
+			std::mt19937_64 gen(3);
+			std::vector<uint64_t> v(300000);
+			for (auto& x : v)
+				x = gen();
+			FILE* f = std::fopen(input, "wb");
+			std::fwrite(v.data(), sizeof(uint64_t), v.size(), f);
+			std::fclose(f);
+
+			TinySTL::external_sort<uint64_t>(input, output, 1 << 18);
+			std::sort(v.begin(), v.end());
+			std::vector<uint64_t> out(v.size() + 1);
+			f = std::fopen(output, "rb");
+			Assert::AreEqual(v.size(), std::fread(out.data(), sizeof(uint64_t), out.size(), f));
+			std::fclose(f);
+			Assert::IsTrue(std::equal(v.begin(), v.end(), out.begin()));
+
+			TinySTL::external_radix_sort<uint64_t>(input, output, 1 << 18, [](uint64_t x) { return x; });
+			f = std::fopen(output, "rb");
+			Assert::AreEqual(v.size(), std::fread(out.data(), sizeof(uint64_t), out.size(), f));
+			std::fclose(f);
+			Assert::IsTrue(std::equal(v.begin(), v.end(), out.begin()));
+
+			f = std::fopen(input, "ab");
+			std::fputc(1, f);
+			std::fclose(f);
+			bool thrown = false;
+			try
+			{
+				TinySTL::external_sort<uint64_t>(input, output, 1 << 18);
+			}
+			catch (const std::system_error&)
+			{
+				thrown = true;
+			}
+			Assert::IsTrue(thrown);
+			std::remove(input);
+			std::remove(output);
+
+			thrown = false;
+			try
+			{
+				TinySTL::external_sort<uint64_t>(input, output, 1 << 18);
+			}
+			catch (const std::system_error&)
+			{
+				thrown = true;
+			}
+			Assert::IsTrue(thrown);
+		}
+	};
+}
@@ -0,0 +1,71 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/eytzinger.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace EytzingerUnitTest
+{
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* ranks against std::lower_bound/upper_bound, every size up to a few levels, duplicates */
+		TEST_METHOD(TestMethod1)
+		{
+			std::mt19937 gen(1);
+			for (int len = 0; len < 130; ++len)
+			{
+				std::vector<int> v(len);
+				for (auto& x : v)
+					x = int(gen() % 40);
+				std::sort(v.begin(), v.end());
+				TinySTL::eytzinger_index<int> index(v.data(), v.data() + len);
+				Assert::AreEqual(size_t(len), index.size());
+				Assert::AreEqual(len == 0, index.empty());
+				for (int key = -1; key <= 41; ++key)
+				{
+					Assert::AreEqual(size_t(std::lower_bound(v.begin(), v.end(), key) - v.begin()),
+									 index.lower_bound(key));
+					Assert::AreEqual(size_t(std::upper_bound(v.begin(), v.end(), key) - v.begin()),
+									 index.upper_bound(key));
+					Assert::AreEqual(std::binary_search(v.begin(), v.end(), key), index.contains(key));
+				}
+			}
+		}
+
+		/* BFS layout of 1..7, custom order, a large table */
+		TEST_METHOD(TestMethod2)
+		{
+			int a[] = { 1, 2, 3, 4, 5, 6, 7 };
+			TinySTL::eytzinger_index<int> index(a, a + 7);
+			const int bfs[] = { 4, 2, 6, 1, 3, 5, 7 };
+			Assert::IsTrue(std::equal(index.begin(), index.end(), bfs));
+
+			int b[] = { 9, 7, 7, 3, 1 };
+			auto greater = [](int x, int y) { return x > y; };
+			TinySTL::eytzinger_index<int, decltype(greater)> desc(b, b + 5, greater);
+			Assert::AreEqual(size_t(1), desc.lower_bound(7));
+			Assert::AreEqual(size_t(3), desc.upper_bound(7));
+			Assert::AreEqual(size_t(5), desc.lower_bound(0));
+			Assert::IsFalse(desc.contains(8));
+
+			std::mt19937_64 gen(2);
+			std::vector<uint64_t> keys(1 << 20);
+			for (auto& k : keys)
+				k = gen();
+			std::sort(keys.begin(), keys.end());
+			TinySTL::eytzinger_index<uint64_t> big(keys.data(), keys.data() + keys.size());
+			for (int i = 0; i < 10000; ++i)
+			{
+				uint64_t k = i % 2 ? keys[gen() % keys.size()] : gen();
+				Assert::AreEqual(size_t(std::lower_bound(keys.begin(), keys.end(), k) - keys.begin()),
+								 big.lower_bound(k));
+			}
+		}
+	};
+}
@@ -0,0 +1,93 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/indirect_sort.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace IndirectSortUnitTest
+{
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* sort_by_key against std::stable_sort : arithmetic keys (radix and not, signed zeros), string keys, one call per element */
+		TEST_METHOD(TestMethod1)
+		{
+			struct record
+			{
+				int         id;
+				double      score;
+				std::string name;
+			};
+			std::mt19937 gen(1);
+			for (int n : { 0, 1, 2, 50, 255, 256, 3000 })
+			{
+				std::vector<record> v(n);
+				for (int i = 0; i < n; ++i)
+				{
+					const double sign = gen() % 2 ? -1.0 : 1.0; // -0.0 and +0.0 among the keys, equal under <
+					v[i] = record{ i, sign * double(int(gen() % 100) - 50), "r" + std::to_string(gen() % 30) };
+				}
+
+				std::vector<record> expected(v), got(v);
+				std::stable_sort(expected.begin(), expected.end(),
+					[](const record& x, const record& y) { return x.score < y.score; });
+				int calls = 0;
+				TinySTL::sort_by_key(got.data(), got.data() + n, [&calls](const record& r) { ++calls; return r.score; });
+				Assert::AreEqual(n < 2 ? 0 : n, calls);
+				for (int i = 0; i < n; ++i)
+					Assert::AreEqual(expected[i].id, got[i].id);
+
+				expected = v;
+				got = v;
+				auto by_name = [](const record& x, const record& y) { return x.name > y.name; };
+				std::stable_sort(expected.begin(), expected.end(), by_name);
+				TinySTL::sort_by_key(got.data(), got.data() + n, [](const record& r) { return r.name; },
+					[](const std::string& x, const std::string& y) { return x > y; });
+				for (int i = 0; i < n; ++i)
+					Assert::AreEqual(expected[i].id, got[i].id);
+			}
+		}
+
+		/* argsort, then parallel arrays reordered together */
+		TEST_METHOD(TestMethod2)
+		{
+			std::mt19937 gen(2);
+			std::vector<int> keys(1000);
+			std::vector<std::string> names(1000);
+			std::vector<double> values(1000);
+			for (int i = 0; i < 1000; ++i)
+			{
+				keys[i] = int(gen() % 100);
+				names[i] = std::to_string(i);
+				values[i] = i * 0.5;
+			}
+			const std::vector<int> original(keys);
+			auto perm = TinySTL::argsort(keys.data(), keys.data() + keys.size());
+			Assert::IsTrue(keys == original);
+			Assert::AreEqual(size_t(1000), perm.size());
+			for (size_t i = 1; i < perm.size(); ++i)
+			{
+				Assert::IsTrue(keys[perm[i - 1]] <= keys[perm[i]]);
+				if (keys[perm[i - 1]] == keys[perm[i]])
+					Assert::IsTrue(perm[i - 1] < perm[i]);
+			}
+
+			TinySTL::apply_permutation(perm.begin(), perm.end(), keys.begin(), names.begin(), values.data());
+			Assert::IsTrue(std::is_sorted(keys.begin(), keys.end()));
+			for (int i = 0; i < 1000; ++i)
+			{
+				Assert::AreEqual(original[std::stoi(names[i])], keys[i]);
+				Assert::AreEqual(std::stoi(names[i]) * 0.5, values[i]);
+			}
+
+			int a[] = { 30, 10, 20 };
+			auto desc = TinySTL::argsort(a, a + 3, [](int x, int y) { return x > y; });
+			Assert::IsTrue(desc[0] == 0 && desc[1] == 2 && desc[2] == 1);
+		}
+	};
+}
@@ -0,0 +1,85 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/loser_tree.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace LoserTreeUnitTest
+{
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* against a stable sort of all the elements, from 0 to a few hundred sources, empty ones among them */
+		TEST_METHOD(TestMethod1)
+		{
+			struct record { int key, source, pos; };
+			auto by_key = [](const record& x, const record& y) { return x.key < y.key; };
+			std::mt19937 gen(1);
+			for (int k : { 0, 1, 2, 3, 5, 8, 17, 64, 300 })
+			{
+				std::vector<std::vector<record> > shards(k);
+				std::vector<record> all;
+				for (int s = 0; s != k; ++s)
+				{
+					int len = gen() % 4 == 0 ? 0 : int(gen() % 50);
+					for (int i = 0; i != len; ++i)
+						shards[s].push_back(record{ int(gen() % 20), s, 0 });
+					std::stable_sort(shards[s].begin(), shards[s].end(), by_key);
+					for (int i = 0; i != len; ++i)
+						shards[s][i].pos = i;
+					all.insert(all.end(), shards[s].begin(), shards[s].end());
+				}
+				std::stable_sort(all.begin(), all.end(), by_key);
+
+				std::vector<TinySTL::pair<const record*, const record*> > ranges;
+				for (auto& s : shards)
+					ranges.push_back(TinySTL::make_pair(s.data(), s.data() + s.size()));
+				std::vector<record> out(all.size() + 1, record{ -1, -1, -1 });
+				record* end = TinySTL::multiway_merge(ranges.begin(), ranges.end(), out.data(), by_key);
+				Assert::IsTrue(end == out.data() + all.size());
+				for (size_t i = 0; i != all.size(); ++i)
+				{
+					Assert::AreEqual(all[i].key, out[i].key);
+					Assert::AreEqual(all[i].source, out[i].source);
+					Assert::AreEqual(all[i].pos, out[i].pos);
+				}
+				Assert::AreEqual(-1, out[all.size()].key);
+			}
+		}
+
+		/* containers as sources, custom order, the tree driven by hand */
+		TEST_METHOD(TestMethod2)
+		{
+			TinySTL::vector<int> shards[4];
+			for (int i = 0; i != 100; ++i)
+				shards[i % 3].push_back(300 - 2 * i);
+			shards[3].push_back(7);
+			auto greater = [](int x, int y) { return x > y; };
+			int out[101];
+			int* end = TinySTL::multiway_merge(shards, shards + 4, out, greater);
+			Assert::IsTrue(end == out + 101);
+			Assert::IsTrue(std::is_sorted(out, out + 101, greater));
+			Assert::AreEqual(300, out[0]);
+			Assert::AreEqual(102, out[99]);
+			Assert::AreEqual(7, out[100]);
+
+			int a[] = { 1, 4, 9 }, b[] = { 2, 3, 10 }, c[] = { 5 };
+			TinySTL::pair<int*, int*> sources[] = { { a, a + 3 }, { b, b + 3 }, { c, c + 1 } };
+			TinySTL::loser_tree<int*> tree(sources, sources + 3);
+			Assert::AreEqual(size_t(3), tree.size());
+			Assert::AreEqual(size_t(0), tree.top());
+			tree.pop();
+			Assert::AreEqual(size_t(1), tree.top());
+			tree.pop(2);
+			Assert::AreEqual(4, tree.top_value());
+			std::vector<int> rest;
+			for (; !tree.empty(); tree.pop())
+				rest.push_back(tree.top_value());
+			Assert::IsTrue(rest == std::vector<int>({ 4, 5, 9, 10 }));
+		}
+	};
+}
@@ -0,0 +1,137 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/deque.h"
+#include "../TinySTL/numeric.h"
+#include "../TinySTL/vector.h"
+#include "../TinySTL/xsimd.h"
+
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace NumericUnitTest
+{
+	/* inclusive/exclusive scans against partial_sum, around the vector widths, in place too */
+	template <class T>
+	void check_scans()
+	{
+		std::mt19937_64 gen(7);
+		for (int len = 0; len < 300; len += 1 + len / 16)
+		{
+			std::vector<T> v(len), expected(len), r(len);
+			for (auto& x : v)
+				x = std::is_signed_v<T> ? T(int(gen() % 1000) - 500) : T(gen()); // no signed overflow
+			std::partial_sum(v.begin(), v.end(), expected.begin(), [](T x, T y) { return T(x + y); });
+			Assert::IsTrue(TinySTL::inclusive_scan(v.data(), v.data() + len, r.data()) == r.data() + len);
+			Assert::IsTrue(r == expected);
+			r = v;
+			TinySTL::inclusive_scan(r.data(), r.data() + len, r.data(), TinySTL::plus<>(), T(3));
+			for (int i = 0; i < len; ++i)
+				Assert::IsTrue(r[i] == T(expected[i] + 3));
+			r = v;
+			Assert::IsTrue(TinySTL::exclusive_scan(r.data(), r.data() + len, r.data(), T(3)) == r.data() + len);
+			for (int i = 0; i < len; ++i)
+				Assert::IsTrue(r[i] == T((i == 0 ? 0 : expected[i - 1]) + 3));
+		}
+	}
+
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* accumulate / inner_product : in order, custom operations, deque iterators */
+		TEST_METHOD(TestMethod1)
+		{
+			int a[] = { 1, 2, 3, 4, 5 };
+			Assert::AreEqual(15, TinySTL::accumulate(a, a + 5, 0));
+			Assert::AreEqual(120, TinySTL::accumulate(a, a + 5, 1, [](int x, int y) { return x * y; }));
+			Assert::AreEqual(7, TinySTL::accumulate(a, a, 7));
+			/* left fold : ((((100 - 1) - 2) - 3) - 4) - 5 */
+			Assert::AreEqual(85, TinySTL::accumulate(a, a + 5, 100, [](int x, int y) { return x - y; }));
+			Assert::AreEqual(55, TinySTL::inner_product(a, a + 5, a, 0));
+			Assert::AreEqual(10, TinySTL::inner_product(a, a + 5, a, 0,
+				[](int x, int y) { return x < y ? y : x; }, [](int x, int y) { return x + y; }));
+
+			TinySTL::deque<int> d;
+			for (int i = 1; i <= 1000; ++i)
+				d.push_back(i);
+			Assert::AreEqual(500500LL, TinySTL::accumulate(d.begin(), d.end(), 0LL));
+			Assert::AreEqual(500500LL, TinySTL::reduce(d.begin(), d.end(), 0LL));
+			Assert::AreEqual(500500, TinySTL::reduce(d.begin(), d.end()));
+		}
+
+		/* reduce / transform_reduce : every length around the lane count, against std */
+		TEST_METHOD(TestMethod2)
+		{
+			std::mt19937 gen(3);
+			for (int len = 0; len < 100; ++len)
+			{
+				TinySTL::vector<int64_t> v;
+				std::vector<int32_t> w;
+				for (int i = 0; i < len; ++i)
+				{
+					v.push_back(int64_t(gen()));
+					w.push_back(int32_t(gen() % 1000) - 500);
+				}
+				const int64_t* first = v.begin();
+				const int64_t* last  = v.end();
+				Assert::AreEqual(std::accumulate(first, last, int64_t(3)), TinySTL::reduce(first, last, int64_t(3)));
+				Assert::AreEqual(std::accumulate(first, last, int64_t(0)), TinySTL::reduce(first, last));
+				Assert::AreEqual(std::inner_product(w.data(), w.data() + len, w.data(), int64_t(1)),
+								 TinySTL::transform_reduce(w.data(), w.data() + len, w.data(), int64_t(1)));
+				int64_t squares = 0;
+				for (int32_t x : w)
+					squares += int64_t(x) * x;
+				Assert::AreEqual(squares, TinySTL::transform_reduce(w.data(), w.data() + len, int64_t(0),
+					TinySTL::plus<>(), [](int32_t x) { return int64_t(x) * x; }));
+			}
+
+			/* floating point : grouped differently, still exact on small integers */
+			std::vector<double> f(1001);
+			for (int i = 0; i <= 1000; ++i)
+				f[i] = double(i);
+			Assert::AreEqual(500500.0, TinySTL::reduce(f.data(), f.data() + 1001, 0.0));
+			Assert::AreEqual(500500.0f, TinySTL::reduce(f.data(), f.data() + 1001, 0.0f));
+
+			int a[] = { 3, 9, 4 };
+			Assert::AreEqual(9, TinySTL::reduce(a, a + 3, 0, [](int x, int y) { return x < y ? y : x; }));
+		}
+
+		/* scans : SIMD levels and integer sizes, generic ops, transforms, input iterators */
+		TEST_METHOD(TestMethod3)
+		{
+			const TinySTL::simd_level saved = TinySTL::simd_active_level();
+			for (int level = TinySTL::SIMD_NONE; level <= TinySTL::simd_supported_level(); ++level)
+			{
+				TinySTL::simd_set_level(TinySTL::simd_level(level));
+				check_scans<uint8_t>();
+				check_scans<int16_t>();
+				check_scans<uint32_t>();
+				check_scans<int64_t>();
+			}
+			TinySTL::simd_set_level(saved);
+
+			double d[5] = { 1, 2, 3, 4, 5 }, r[5];
+			TinySTL::inclusive_scan(d, d + 5, r, [](double x, double y) { return x * y; });
+			Assert::AreEqual(120.0, r[4]);
+			TinySTL::exclusive_scan(d, d + 5, r, 1.0, [](double x, double y) { return x * y; });
+			Assert::AreEqual(1.0, r[0]);
+			Assert::AreEqual(24.0, r[4]);
+			TinySTL::transform_inclusive_scan(d, d + 5, r, TinySTL::plus<>(), [](double x) { return x * x; });
+			Assert::AreEqual(55.0, r[4]);
+			TinySTL::transform_exclusive_scan(d, d + 5, r, 0.0, TinySTL::plus<>(), [](double x) { return x * x; });
+			Assert::AreEqual(30.0, r[4]);
+			Assert::IsTrue(TinySTL::inclusive_scan(d, d, r) == r);
+
+			TinySTL::deque<int> q;
+			for (int i = 0; i < 10; ++i)
+				q.push_back(i);
+			TinySTL::vector<int> out(10, 0);
+			TinySTL::inclusive_scan(q.begin(), q.end(), out.begin());
+			Assert::AreEqual(45, out[9]);
+		}
+	};
+}
@@ -0,0 +1,431 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/deque.h"
+#include "../TinySTL/parallel_algorithm.h"
+#include "../TinySTL/vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace ParallelAlgorithmUnitTest
+{
+	struct record
+	{
+		int key;
+		int payload;
+	};
+
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* parallel_sort : random ints in a vector ; samplesort on a pool of its own, few and many splitters */
+		TEST_METHOD(TestMethod1)
+		{
+			std::mt19937 gen(1);
+			const int n = 1 << 20;
+			TinySTL::vector<int> v1;
+			std::vector<int>     v2;
+			for (int i = 0; i < n; ++i)
+			{
+				int x = int(gen());
+				v1.push_back(x);
+				v2.push_back(x);
+			}
+			const TinySTL::vector<int> original(v1);
+			TinySTL::parallel_sort(v1.begin(), v1.end());
+			std::sort(v2.begin(), v2.end());
+			for (int i = 0; i < n; ++i)
+				Assert::AreEqual(v2[i], v1[i]);
+
+			TinySTL::thread_pool pool(4);
+			for (size_t splitters : { size_t(2), size_t(TinySTL::SAMPLESORT_MAX_SPLITTERS) })
+			{
+				TinySTL::vector<int> v3(original);
+				TinySTL::_samplesort(v3.begin(), v3.end(), TinySTL::less<>(), splitters, pool);
+				for (int i = 0; i < n; ++i)
+					Assert::AreEqual(v2[i], v3[i]);
+			}
+		}
+
+		/* parallel_sort : deque, few distinct keys, custom comparison */
+		TEST_METHOD(TestMethod2)
+		{
+			std::mt19937 gen(2);
+			const int n = 1 << 19;
+			TinySTL::deque<int> v1;
+			std::vector<int>    v2;
+			for (int i = 0; i < n; ++i)
+			{
+				int x = int(gen() % 5);
+				v1.push_back(x);
+				v2.push_back(x);
+			}
+			TinySTL::deque<int> d(v1);
+			TinySTL::parallel_sort(v1.begin(), v1.end(), [](int x, int y) { return x > y; });
+			std::sort(v2.begin(), v2.end(), std::greater<>());
+			for (int i = 0; i < n; ++i)
+				Assert::AreEqual(v2[i], v1[i]);
+
+			/* 5 keys : most splitters are duplicates, the buckets of equal keys take the rest */
+			TinySTL::thread_pool pool(4);
+			TinySTL::_samplesort(d.begin(), d.end(), [](int x, int y) { return x > y; }, 32, pool);
+			for (int i = 0; i < n; ++i)
+				Assert::AreEqual(v2[i], d[i]);
+		}
+
+		/* parallel_sort : records, all the payloads kept, small range */
+		TEST_METHOD(TestMethod3)
+		{
+			std::mt19937 gen(3);
+			const int n = 1 << 18;
+			std::vector<record> v(n);
+			long long sum = 0;
+			for (int i = 0; i < n; ++i)
+			{
+				v[i].key     = int(gen() % 1000);
+				v[i].payload = i;
+				sum += i;
+			}
+			auto by_key = [](const record& x, const record& y) { return x.key < y.key; };
+			std::vector<record> w(v);
+			TinySTL::parallel_sort(v.data(), v.data() + n, by_key);
+			TinySTL::thread_pool pool(4);
+			TinySTL::_samplesort(w.data(), w.data() + n, by_key, 31, pool);
+			for (int i = 0; i < n; ++i)
+			{
+				if (i != 0)
+				{
+					Assert::IsTrue(v[i - 1].key <= v[i].key);
+					Assert::IsTrue(w[i - 1].key <= w[i].key);
+				}
+				sum -= v[i].payload;
+			}
+			Assert::AreEqual(0LL, sum);
+			std::vector<bool> seen(n);
+			for (int i = 0; i < n; ++i)
+				seen[w[i].payload] = true;
+			Assert::IsTrue(std::count(seen.begin(), seen.end(), true) == n);
+
+			int small[5] = { 3, 1, 4, 1, 5 };
+			TinySTL::parallel_sort(small, small + 5);
+			Assert::IsTrue(std::is_sorted(small, small + 5));
+			int tiny[5] = { 3, 1, 4, 1, 5 };
+			TinySTL::_samplesort(tiny, tiny + 5, TinySTL::less<>(), 2, pool);
+			Assert::IsTrue(std::is_sorted(tiny, tiny + 5));
+		}
+
+		/* parallel_stable_sort : stability, vector and deque, 3 to 8 chunks */
+		TEST_METHOD(TestMethod4)
+		{
+			std::mt19937 gen(4);
+			const int n = 1 << 18;
+			auto by_key = [](const record& x, const record& y) { return x.key < y.key; };
+			std::vector<record> v1(n);
+			for (int i = 0; i < n; ++i)
+			{
+				v1[i].key     = int(gen() % 1000);
+				v1[i].payload = i;
+			}
+			std::vector<record> v2 = v1;
+			std::stable_sort(v2.begin(), v2.end(), by_key);
+
+			TinySTL::thread_pool pool(4);
+			for (size_t chunks : { size_t(3), size_t(8) })
+			{
+				TinySTL::deque<record> d(v1.data(), v1.data() + n);
+				TinySTL::_parallel_stable_sort(d.begin(), d.end(), by_key, chunks, pool);
+				for (int i = 0; i < n; ++i)
+					Assert::AreEqual(v2[i].payload, d[i].payload);
+			}
+			std::vector<record> v3 = v1;
+			TinySTL::parallel_stable_sort(v3.data(), v3.data() + n, by_key);
+			for (int i = 0; i < n; ++i)
+				Assert::AreEqual(v2[i].payload, v3[i].payload);
+		}
+
+		/* parallel_merge : ties taken from the first range first */
+		TEST_METHOD(TestMethod5)
+		{
+			std::mt19937 gen(5);
+			const int n1 = 100000, n2 = 70000;
+			auto by_key = [](const record& x, const record& y) { return x.key < y.key; };
+			std::vector<record> a(n1), b(n2);
+			for (int i = 0; i < n1; ++i)
+				a[i] = record{ int(gen() % 500), i };
+			for (int i = 0; i < n2; ++i)
+				b[i] = record{ int(gen() % 500), n1 + i };
+			std::sort(a.begin(), a.end(), by_key);
+			std::sort(b.begin(), b.end(), by_key);
+			std::vector<record> expected(n1 + n2);
+			std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin(), by_key);
+
+			TinySTL::thread_pool pool(4);
+			for (size_t pieces : { size_t(1), size_t(7), size_t(16) })
+			{
+				std::vector<record> result(n1 + n2);
+				record* end = TinySTL::_parallel_merge(a.data(), a.data() + n1,
+													   b.data(), b.data() + n2,
+													   result.data(), by_key, pieces, pool);
+				Assert::IsTrue(end == result.data() + n1 + n2);
+				for (int i = 0; i < n1 + n2; ++i)
+					Assert::AreEqual(expected[i].payload, result[i].payload);
+			}
+			std::vector<record> result(n1 + n2);
+			TinySTL::parallel_merge(a.data(), a.data() + n1, b.data(), b.data() + n2,
+									result.data(), by_key);
+			for (int i = 0; i < n1 + n2; ++i)
+				Assert::AreEqual(expected[i].payload, result[i].payload);
+		}
+
+		/* parallel scans : 2 to 9 chunks, in place, non commutative op, deque */
+		TEST_METHOD(TestMethod6)
+		{
+			std::mt19937 gen(6);
+			const int n = 300001;
+			std::vector<uint32_t> v(n);
+			for (auto& x : v)
+				x = gen();
+			std::vector<uint32_t> inclusive(n), exclusive(n);
+			std::partial_sum(v.begin(), v.end(), inclusive.begin());
+			exclusive[0] = 5;
+			for (int i = 1; i < n; ++i)
+				exclusive[i] = exclusive[i - 1] + v[i - 1];
+
+			TinySTL::thread_pool pool(4);
+			auto twice = [](uint32_t x) { return 2 * x; };
+			for (size_t chunks : { size_t(2), size_t(3), size_t(9) })
+			{
+				std::vector<uint32_t> r(n);
+				Assert::IsTrue(TinySTL::_parallel_scan(v.data(), v.data() + n, r.data(), uint32_t(0),
+					TinySTL::plus<>(), TinySTL::_identity(), false, chunks, pool) == r.data() + n);
+				Assert::IsTrue(r == inclusive);
+				r = v;
+				TinySTL::_parallel_scan(r.data(), r.data() + n, r.data(), uint32_t(5),
+					TinySTL::plus<>(), TinySTL::_identity(), true, chunks, pool);
+				Assert::IsTrue(r == exclusive);
+				TinySTL::_parallel_scan(v.data(), v.data() + n, r.data(), uint32_t(0),
+					TinySTL::plus<>(), twice, false, chunks, pool);
+				for (int i = 0; i < n; i += 997)
+					Assert::AreEqual(2 * inclusive[i], r[i]);
+
+				/* 2x2 matrix products : associative, not commutative */
+				struct mat { uint32_t a, b, c, d; };
+				auto mul = [](const mat& x, const mat& y)
+				{
+					return mat{ x.a * y.a + x.b * y.c, x.a * y.b + x.b * y.d,
+								x.c * y.a + x.d * y.c, x.c * y.b + x.d * y.d };
+				};
+				std::vector<mat> m(20000), seq(20000), par(20000);
+				for (auto& x : m)
+					x = mat{ gen() % 3, gen() % 3, gen() % 3, gen() % 3 };
+				TinySTL::inclusive_scan(m.data(), m.data() + 20000, seq.data(), mul);
+				TinySTL::_parallel_scan(m.data() + 1, m.data() + 20000, par.data() + 1, m[0],
+					mul, TinySTL::_identity(), false, chunks, pool);
+				for (int i = 1; i < 20000; ++i)
+					Assert::IsTrue(seq[i].a == par[i].a && seq[i].b == par[i].b &&
+								   seq[i].c == par[i].c && seq[i].d == par[i].d);
+			}
+
+			TinySTL::deque<int> d;
+			for (int i = 0; i < 1000; ++i)
+				d.push_back(i);
+			std::vector<long long> out(1000);
+			TinySTL::parallel_exclusive_scan(d.begin(), d.end(), out.begin(), 0LL);
+			Assert::AreEqual(499500LL - 999, out[999]);
+			TinySTL::parallel_inclusive_scan(d.begin(), d.end(), out.begin());
+			Assert::AreEqual(499500LL, out[999]);
+			TinySTL::parallel_transform_inclusive_scan(d.begin(), d.end(), out.begin(),
+				TinySTL::plus<>(), [](int x) { return x % 2; });
+			Assert::AreEqual(500LL, out[999]);
+
+			/* an op throwing in some chunks : the carries built meanwhile are destroyed */
+			struct counted
+			{
+				std::shared_ptr<long long> sum; // leaks show up if a carry isn't destroyed
+				counted(long long x = 0) :sum(std::make_shared<long long>(x)) {}
+			};
+			auto add = [](const counted& x, const counted& y)
+			{
+				if (*y.sum == 123456)
+					throw 1;
+				return counted(*x.sum + *y.sum);
+			};
+			auto wrap = [](uint32_t x) { return counted(x % 1000000); };
+			std::vector<uint32_t> keys(200000);
+			for (uint32_t i = 0; i != keys.size(); ++i)
+				keys[i] = i;
+			std::vector<counted> res(keys.size());
+			for (size_t chunks : { size_t(2), size_t(9) })
+			{
+				bool thrown = false;
+				try
+				{
+					TinySTL::_parallel_scan(keys.data(), keys.data() + keys.size(), res.data(), counted(),
+						add, wrap, false, chunks, pool);
+				}
+				catch (int)
+				{
+					thrown = true;
+				}
+				Assert::IsTrue(thrown);
+			}
+		}
+
+		/* parallel shuffle : a permutation, deterministic for a seed, every position as likely */
+		TEST_METHOD(TestMethod7)
+		{
+			TinySTL::thread_pool pool(4);
+			const int n = 200003;
+			std::vector<int> v(n);
+			std::iota(v.begin(), v.end(), 0);
+			for (size_t chunks : { size_t(2), size_t(7), size_t(256) })
+			{
+				std::vector<int> a(v), b(v);
+				TinySTL::_parallel_shuffle(a.data(), a.data() + n, 7, chunks, pool);
+				TinySTL::_parallel_shuffle(b.data(), b.data() + n, 7, chunks, pool);
+				Assert::IsTrue(a == b);
+				Assert::IsTrue(a != v);
+				std::sort(a.begin(), a.end());
+				Assert::IsTrue(a == v);
+			}
+
+			int where[6][6] = {};
+			for (uint64_t seed = 0; seed < 36000; ++seed)
+			{
+				int a[6] = { 0, 1, 2, 3, 4, 5 };
+				TinySTL::_parallel_shuffle(a, a + 6, seed, 3, pool);
+				for (int i = 0; i < 6; ++i)
+					++where[a[i]][i];
+			}
+			for (auto& row : where)
+				for (int c : row)
+					Assert::IsTrue(c > 5600 && c < 6400);
+
+			TinySTL::deque<int> d;
+			for (int i = 0; i < 1000; ++i)
+				d.push_back(i);
+			TinySTL::parallel_shuffle(d.begin(), d.end(), TinySTL::xoshiro256ss(1));
+			std::vector<int> sorted;
+			for (int x : d)
+				sorted.push_back(x);
+			std::sort(sorted.begin(), sorted.end());
+			Assert::IsTrue(std::equal(sorted.begin(), sorted.end(), v.begin()));
+		}
+
+		/* chunked loops and the parallel search : every chunk count, the first match wins, early stops */
+		TEST_METHOD(TestMethod8)
+		{
+			TinySTL::thread_pool pool(4);
+			const int n = 100000;
+			std::vector<int> v(n);
+			std::iota(v.begin(), v.end(), 0);
+			for (size_t chunks : { size_t(1), size_t(2), size_t(7), size_t(64) })
+			{
+				std::vector<int> seen(n, 0);
+				std::vector<size_t> chunk_of(n);
+				TinySTL::_parallel_loop(v.data(), v.data() + n, chunks, pool, [&](int* b, int* e, size_t c)
+				{
+					for (; b != e; ++b)
+					{
+						++seen[*b];
+						chunk_of[*b] = c;
+					}
+				});
+				Assert::IsTrue(std::all_of(seen.begin(), seen.end(), [](int x) { return x == 1; }));
+				Assert::IsTrue(std::is_sorted(chunk_of.begin(), chunk_of.end()));
+				Assert::IsTrue(chunk_of[n - 1] == chunks - 1);
+
+				for (int target : { 0, 1, 4095, 50000, 99999, n })
+				{
+					int* it = TinySTL::_parallel_find_if(v.data(), v.data() + n,
+						[target](int x) { return x >= target && x % 3 == target % 3; }, chunks, pool);
+					Assert::IsTrue(it == v.data() + target);
+				}
+
+				/* the first match stops the search of the chunks after it */
+				std::atomic<int> calls(0);
+				int* it = TinySTL::_parallel_find_if(v.data(), v.data() + n,
+					[&calls](int x) { ++calls; return x >= 10; }, chunks, pool);
+				Assert::IsTrue(it == v.data() + 10);
+				if (chunks > 1)
+					Assert::IsTrue(calls.load() < n);
+			}
+
+			bool thrown = false;
+			try
+			{
+				TinySTL::_parallel_loop(v.data(), v.data() + n, 8, pool, [](int*, int*, size_t c)
+				{
+					if (c == 5)
+						throw 5;
+				});
+			}
+			catch (int x)
+			{
+				thrown = x == 5;
+			}
+			Assert::IsTrue(thrown);
+		}
+
+		/* the execution policy overloads against the sequential algorithms */
+		TEST_METHOD(TestMethod9)
+		{
+			const int n = 1 << 18;
+			std::vector<int> v(n);
+			std::mt19937 gen(9);
+			for (auto& x : v)
+				x = int(gen() % 1000);
+			auto run = [&](auto policy)
+			{
+				std::vector<int> w(v), out(n);
+				std::atomic<long long> sum(0);
+				TinySTL::for_each(policy, w.data(), w.data() + n, [&sum](int x) { sum += x; });
+				Assert::IsTrue(sum.load() == std::accumulate(v.begin(), v.end(), 0LL));
+
+				auto twice = [](int x) { return 2 * x; };
+				Assert::IsTrue(TinySTL::transform(policy, w.data(), w.data() + n, out.data(), twice) == out.data() + n);
+				for (int i = 0; i < n; ++i)
+					Assert::AreEqual(2 * v[i], out[i]);
+				TinySTL::transform(policy, w.data(), w.data() + n, out.data(), out.data(), TinySTL::plus<>());
+				for (int i = 0; i < n; ++i)
+					Assert::AreEqual(3 * v[i], out[i]);
+
+				auto small = [](int x) { return x < 10; };
+				Assert::IsTrue(TinySTL::count_if(policy, w.data(), w.data() + n, small) ==
+							   std::count_if(v.begin(), v.end(), small));
+				Assert::IsTrue(TinySTL::find_if(policy, w.data(), w.data() + n, small) ==
+							   w.data() + (std::find_if(v.begin(), v.end(), small) - v.begin()));
+				Assert::IsTrue(TinySTL::find_if(policy, w.data(), w.data() + n, [](int x) { return x > 1000; }) ==
+							   w.data() + n);
+				Assert::IsTrue(TinySTL::any_of(policy, w.data(), w.data() + n, small));
+				Assert::IsFalse(TinySTL::none_of(policy, w.data(), w.data() + n, small));
+				Assert::IsTrue(TinySTL::all_of(policy, w.data(), w.data() + n, [](int x) { return x < 1000; }));
+				Assert::IsFalse(TinySTL::all_of(policy, w.data(), w.data() + n, small));
+
+				TinySTL::replace_if(policy, w.data(), w.data() + n, small, -1);
+				for (int i = 0; i < n; ++i)
+					Assert::AreEqual(small(v[i]) ? -1 : v[i], w[i]);
+				TinySTL::fill(policy, w.data(), w.data() + n, 7);
+				Assert::IsTrue(std::count(w.begin(), w.end(), 7) == n);
+
+				TinySTL::deque<int> d;
+				for (int i = 0; i < 10000; ++i)
+					d.push_back(i);
+				TinySTL::fill(policy, d.begin(), d.end(), 3);
+				Assert::IsTrue(TinySTL::count_if(policy, d.begin(), d.end(), [](int x) { return x == 3; }) == 10000);
+			};
+			run(TinySTL::execution::seq);
+			run(TinySTL::execution::par);
+			run(TinySTL::execution::par_unseq);
+			Assert::IsTrue(TinySTL::is_execution_policy_v<TinySTL::execution::parallel_policy>);
+			Assert::IsFalse(TinySTL::is_execution_policy_v<int*>);
+		}
+	};
+}
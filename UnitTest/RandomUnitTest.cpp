@@ -0,0 +1,97 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/random.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace RandomUnitTest
+{
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* the engines against the reference sequences, streams and jumps */
+		TEST_METHOD(TestMethod1)
+		{
+			TinySTL::splitmix64 sm(0);
+			Assert::IsTrue(sm() == 0xe220a8397b1dcdafull);
+			Assert::IsTrue(sm() == 0x6e789e6aa1b965f4ull);
+
+			TinySTL::pcg32 pcg(42, 54);
+			const uint32_t expected[] = { 0xa15c02b7, 0x7b47f409, 0xba1d3330, 0x83d2f293, 0xbfa4784b, 0xcbed606e };
+			for (uint32_t x : expected)
+				Assert::IsTrue(pcg() == x);
+			TinySTL::pcg32 a(42, 54), b(42, 55);
+			Assert::IsTrue(a != b);
+			a.discard(6);
+			Assert::IsTrue(a == pcg);
+
+			TinySTL::xoshiro256ss x(7), y(7), z(8);
+			Assert::IsTrue(x == y);
+			Assert::IsTrue(x() == y() && x() != z());
+			y.jump();
+			Assert::IsTrue(x != y);
+			TinySTL::xoshiro256ss w(7);
+			w();
+			w.jump();
+			Assert::IsTrue(w == y);
+			/* jumped streams don't start where the others stand */
+			std::vector<uint64_t> s0, s1;
+			for (int i = 0; i < 1000; ++i)
+			{
+				s0.push_back(x());
+				s1.push_back(y());
+			}
+			for (int i = 0; i < 1000; ++i)
+				Assert::IsTrue(s0[i] != s1[i]);
+		}
+
+		/* random_below : bounds of every width, 32 and 64 bits engines and others, uniformity */
+		TEST_METHOD(TestMethod2)
+		{
+			TinySTL::xoshiro256ss x(1);
+			TinySTL::pcg32 p(1);
+			std::mt19937_64 m64(1);
+			std::minstd_rand minstd(1);
+			for (uint64_t bound : { uint64_t(1), uint64_t(2), uint64_t(3), uint64_t(1000000007),
+									uint64_t(UINT32_MAX), uint64_t(UINT32_MAX) + 1, uint64_t(1) << 63,
+									(uint64_t(1) << 63) + 12345, UINT64_MAX })
+				for (int i = 0; i < 1000; ++i)
+				{
+					Assert::IsTrue(TinySTL::random_below(x, bound) < bound);
+					Assert::IsTrue(TinySTL::random_below(p, bound) < bound);
+					Assert::IsTrue(TinySTL::random_below(m64, bound) < bound);
+					Assert::IsTrue(TinySTL::random_below(minstd, bound) < bound);
+				}
+
+			/* a bound just above 2^63 rejects half of the draws : biased code would favor the low half */
+			const uint64_t bound = (uint64_t(1) << 63) + (uint64_t(1) << 62);
+			int low = 0;
+			for (int i = 0; i < 30000; ++i)
+				low += TinySTL::random_below(x, bound) < bound / 2;
+			Assert::IsTrue(low > 14400 && low < 15600);
+
+			const int buckets = 7, n = 70000;
+			int count32[buckets] = {}, count64[buckets] = {};
+			for (int i = 0; i < n; ++i)
+			{
+				++count32[TinySTL::random_below(p, buckets)];
+				++count64[TinySTL::random_below(x, buckets)];
+			}
+			for (int b = 0; b < buckets; ++b)
+			{
+				Assert::IsTrue(count32[b] > 9500 && count32[b] < 10500);
+				Assert::IsTrue(count64[b] > 9500 && count64[b] < 10500);
+			}
+
+			for (int i = 0; i < 10000; ++i)
+			{
+				double u = TinySTL::_random_open_unit(x);
+				Assert::IsTrue(u > 0.0 && u < 1.0);
+			}
+		}
+	};
+}
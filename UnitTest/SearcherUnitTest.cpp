@@ -0,0 +1,92 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/searcher.h"
+#include "../TinySTL/xsimd.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace SearcherUnitTest
+{
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* every searcher against std::search : small alphabets (periodic patterns), every SIMD level */
+		TEST_METHOD(TestMethod1)
+		{
+			std::mt19937 gen(1);
+			const TinySTL::simd_level saved = TinySTL::simd_active_level();
+			for (int level = TinySTL::SIMD_SSE2; level <= TinySTL::simd_supported_level(); ++level)
+			{
+				TinySTL::simd_set_level(TinySTL::simd_level(level));
+				for (int round = 0; round < 300; ++round)
+				{
+					const int alphabet = round % 3 == 0 ? 2 : round % 3 == 1 ? 4 : 256;
+					std::string text(gen() % 400, ' '), pattern(gen() % 12, ' ');
+					for (auto& c : text)
+						c = char(gen() % alphabet);
+					for (auto& c : pattern)
+						c = char(gen() % alphabet);
+					if (round % 2 && pattern.size() <= text.size())
+						std::copy(pattern.begin(), pattern.end(), text.end() - gen() % 20 % (text.size() - pattern.size() + 1) - pattern.size());
+
+					const char* t = text.data();
+					const char* t_end = t + text.size();
+					const char* p = pattern.data();
+					const char* p_end = p + pattern.size();
+					const char* expected = std::search(t, t_end, p, p_end);
+					Assert::IsTrue(expected == TinySTL::search(t, t_end, p, p_end));
+					Assert::IsTrue(expected == TinySTL::search(t, t_end, TinySTL::default_searcher<const char*>(p, p_end)));
+					Assert::IsTrue(expected == TinySTL::search(t, t_end, TinySTL::boyer_moore_horspool_searcher<const char*>(p, p_end)));
+					Assert::IsTrue(expected == TinySTL::search(t, t_end, TinySTL::boyer_moore_searcher<const char*>(p, p_end)));
+					auto match = TinySTL::boyer_moore_searcher<const char*>(p, p_end)(t, t_end);
+					Assert::IsTrue(match.second == (expected == t_end ? t_end : expected + pattern.size()));
+				}
+			}
+			TinySTL::simd_set_level(saved);
+		}
+
+		/* wide elements hashed into shared slots, custom hash and predicate, forward iterators */
+		TEST_METHOD(TestMethod2)
+		{
+			std::mt19937 gen(2);
+			std::vector<uint32_t> text(5000);
+			for (auto& x : text)
+				x = gen() % 1000;
+			std::vector<uint32_t> pattern(text.begin() + 3000, text.begin() + 3017);
+			auto expected = std::search(text.begin(), text.end(), pattern.begin(), pattern.end());
+			const uint32_t* t = text.data();
+			TinySTL::boyer_moore_searcher<const uint32_t*> bm(pattern.data(), pattern.data() + pattern.size());
+			TinySTL::boyer_moore_horspool_searcher<const uint32_t*> bmh(pattern.data(), pattern.data() + pattern.size());
+			Assert::AreEqual(ptrdiff_t(expected - text.begin()), TinySTL::search(t, t + text.size(), bm) - t);
+			Assert::AreEqual(ptrdiff_t(expected - text.begin()), TinySTL::search(t, t + text.size(), bmh) - t);
+
+			struct nocase_hash
+			{
+				size_t operator()(char c) const { return size_t(std::tolower((unsigned char)c)); }
+			};
+			auto nocase = [](char x, char y) { return std::tolower((unsigned char)x) == std::tolower((unsigned char)y); };
+			const char text2[] = "Scanning for a DELIMITER: --Boundary--, then --boundary--";
+			const char pat[] = "--BOUNDARY--";
+			TinySTL::boyer_moore_searcher<const char*, nocase_hash, decltype(nocase)>
+				ci(pat, pat + strlen(pat), nocase_hash(), nocase);
+			Assert::AreEqual(ptrdiff_t(26), TinySTL::search(text2, text2 + strlen(text2), ci) - text2);
+			TinySTL::boyer_moore_horspool_searcher<const char*, nocase_hash, decltype(nocase)>
+				ci2(pat, pat + strlen(pat), nocase_hash(), nocase);
+			Assert::AreEqual(ptrdiff_t(26), TinySTL::search(text2, text2 + strlen(text2), ci2) - text2);
+
+			std::string s = "abcabd";
+			auto empty = TinySTL::boyer_moore_searcher<const char*>(pat, pat)(s.data(), s.data() + s.size());
+			Assert::IsTrue(empty.first == s.data() && empty.second == s.data());
+			int list[] = { 1, 2, 1, 2, 3 }, sub[] = { 1, 2, 3 };
+			Assert::IsTrue(TinySTL::search(list, list + 5, TinySTL::default_searcher<int*>(sub, sub + 3)) == list + 2);
+		}
+	};
+}
@@ -0,0 +1,78 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/top_k.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace TopKUnitTest
+{
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* against a sort of the whole stream, k from 0 to more than the stream */
+		TEST_METHOD(TestMethod1)
+		{
+			std::mt19937 gen(1);
+			std::vector<int> stream(5000);
+			for (auto& x : stream)
+				x = int(gen() % 3000);
+			std::vector<int> sorted(stream);
+			std::sort(sorted.begin(), sorted.end());
+			for (size_t k : { 0, 1, 2, 10, 100, 4999, 5000, 6000 })
+			{
+				TinySTL::top_k<int> best(k);
+				for (int x : stream)
+					best.push(x);
+				const size_t kept = std::min(k, stream.size());
+				Assert::AreEqual(kept, best.size());
+				Assert::AreEqual(k, best.k());
+				if (kept != 0)
+					Assert::AreEqual(sorted[kept - 1], best.threshold());
+				auto result = best.take_sorted();
+				Assert::IsTrue(best.empty());
+				Assert::AreEqual(kept, result.size());
+				Assert::IsTrue(std::equal(result.begin(), result.end(), sorted.begin()));
+			}
+		}
+
+		/* largest scores, pruning before building the record, move-only path */
+		TEST_METHOD(TestMethod2)
+		{
+			struct entry
+			{
+				int         score;
+				std::string name;
+			};
+			auto higher = [](const entry& x, const entry& y) { return x.score > y.score; };
+			TinySTL::top_k<entry, decltype(higher)> board(3, higher);
+			int built = 0;
+			for (int score : { 5, 9, 1, 7, 3, 9, 2, 8, 0, 4 })
+			{
+				entry probe{ score, std::string() };
+				if (!board.admits(probe))
+					continue;
+				++built;
+				Assert::IsTrue(board.push(entry{ score, "player" + std::to_string(score) }));
+			}
+			Assert::IsTrue(board.full());
+			Assert::AreEqual(6, built);
+			Assert::AreEqual(8, board.threshold().score);
+			Assert::IsFalse(board.push(entry{ 8, "late" }));
+			auto result = board.take_sorted();
+			Assert::AreEqual(size_t(3), result.size());
+			Assert::AreEqual(9, result[0].score);
+			Assert::AreEqual(9, result[1].score);
+			Assert::AreEqual(std::string("player8"), result[2].name);
+
+			int a[] = { 4, 1, 3 };
+			TinySTL::top_k<int> none(0, a, a + 3);
+			Assert::IsTrue(none.empty());
+			Assert::IsFalse(none.admits(0));
+		}
+	};
+}
@@ -266,5 +266,22 @@ namespace VectorUnitTest
 			Assert::IsTrue(is_equal(v1, v2_copy));
 			Assert::IsTrue(is_equal(v2, v1_copy));
 		}
+
+		/* emplace in the middle, with spare capacity left by the geometric growth */
+		TEST_METHOD(TestMethod17)
+		{
+			TinySTL::vector<int> v1;
+			std::vector<int> v2;
+			for (int i = 0; i < 100; ++i)
+			{
+				v1.emplace(v1.begin() + v1.size() / 2, i);
+				v2.emplace(v2.begin() + v2.size() / 2, i);
+			}
+			Assert::IsTrue(is_equal(v2, v1));
+			Assert::IsTrue(v1.capacity() > v1.size());
+			v1.emplace(v1.begin(), -1);
+			v2.emplace(v2.begin(), -1);
+			Assert::IsTrue(is_equal(v2, v1));
+		}
 	};
 }
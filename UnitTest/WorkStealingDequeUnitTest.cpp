@@ -0,0 +1,118 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "../TinySTL/work_stealing_deque.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace WorkStealingDequeUnitTest
+{
+	TEST_CLASS(MultiplicationTests)
+	{
+	public:
+		/* the owner pops LIFO, a thief steals FIFO */
+		TEST_METHOD(TestMethod1)
+		{
+			TinySTL::work_stealing_deque<int> d;
+			int val;
+			Assert::IsFalse(d.pop(val));
+			Assert::IsFalse(d.steal(val));
+			for (int i = 0; i < 10; ++i)
+				d.push(i);
+			Assert::IsTrue(d.size_approx() == 10);
+			for (int i = 9; i >= 5; --i)
+			{
+				Assert::IsTrue(d.pop(val));
+				Assert::AreEqual(i, val);
+			}
+			for (int i = 0; i < 5; ++i)
+			{
+				Assert::IsTrue(d.steal(val));
+				Assert::AreEqual(i, val);
+			}
+			Assert::IsFalse(d.pop(val));
+			Assert::IsFalse(d.steal(val));
+			Assert::IsTrue(d.empty_approx());
+		}
+
+		/* pushing past the capacity grows the ring, wrapped elements included */
+		TEST_METHOD(TestMethod2)
+		{
+			TinySTL::work_stealing_deque<int> d(4);
+			int val;
+			/* top and bottom past the end of the first ring before it grows */
+			for (int i = 0; i < 3; ++i)
+				d.push(-1);
+			for (int i = 0; i < 3; ++i)
+				Assert::IsTrue(d.steal(val));
+			const int n = 1000;
+			for (int i = 0; i < n; ++i)
+				d.push(i);
+			Assert::IsTrue(d.size_approx() == size_t(n));
+			for (int i = 0; i < n / 2; ++i)
+			{
+				Assert::IsTrue(d.steal(val));
+				Assert::AreEqual(i, val);
+			}
+			for (int i = n - 1; i >= n / 2; --i)
+			{
+				Assert::IsTrue(d.pop(val));
+				Assert::AreEqual(i, val);
+			}
+			Assert::IsFalse(d.pop(val));
+		}
+
+		/* an owner pushing and popping against several thieves : every item taken exactly once */
+		TEST_METHOD(TestMethod3)
+		{
+			const int n = 200000, thieves = 3;
+			TinySTL::work_stealing_deque<int> d(2); // grows while the thieves read
+			std::unique_ptr<std::atomic<int>[]> taken(new std::atomic<int>[n]);
+			for (int i = 0; i < n; ++i)
+				taken[i].store(0);
+			std::atomic<bool> done(false);
+			std::atomic<int> count(0);
+
+			std::vector<std::thread> threads;
+			for (int t = 0; t < thieves; ++t)
+				threads.emplace_back([&]
+				{
+					int val;
+					while (!done.load())
+					{
+						if (d.steal(val))
+						{
+							++taken[val];
+							++count;
+						}
+					}
+				});
+			int val;
+			for (int i = 0; i < n; ++i)
+			{
+				d.push(i);
+				if (i % 3 == 0 && d.pop(val))
+				{
+					++taken[val];
+					++count;
+				}
+			}
+			while (d.pop(val))
+			{
+				++taken[val];
+				++count;
+			}
+			while (count.load() != n)
+				std::this_thread::yield();
+			done.store(true);
+			for (auto& t : threads)
+				t.join();
+			for (int i = 0; i < n; ++i)
+				Assert::AreEqual(1, taken[i].load());
+		}
+	};
+}